@@ -20,13 +20,6 @@
 /* check the defaultTask and Task2 stack owerflow (only freertos) */
 #define  STACKOWERFLOW_CHECK  1
 
-#if LCD_REVERSE16 == 0
-#define  RC(a)   a
-#endif
-#if LCD_REVERSE16 == 1
-#define  RC(a)   ((((a) & 0xFF) << 8) | (((a) & 0xFF00) >> 8))
-#endif
-
 //=============================================================================
 #ifndef osCMSIS
 #define Delay(t)              HAL_Delay(t)
@@ -79,6 +72,15 @@ int  clickCnt = 1;
 #define Pin_(a)            a ## _Pin
 #define Pin(a)             Pin_(a)
 
+#if TESYNC == 1
+/* TE pin interrupt */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if(GPIO_Pin == Pin(TE_NAME))
+    BSP_LCD_TeIrq();
+}
+#endif
+
 // 0=idle, 1,2,3=click, -1,-2=longclick
 int checkButton()
 {
@@ -178,6 +180,9 @@ void setup()
   BSP_LCD_Clear(LCD_COLOR_BLACK);
   BSP_LCD_SetFont(&FONTNAME);
   initStars();
+  #if TESYNC == 1
+  BSP_LCD_TeOn(0);
+  #endif
 }
 
 unsigned int ms, msMin = 1000, msMax = 0, stats = 1, optim = 0; // optim=1 for ST7735, 0 for ST7789
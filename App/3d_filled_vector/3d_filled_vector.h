@@ -24,6 +24,14 @@
    - 1 Double buffer enabled */
 #define DOUBLEBUF    1
 
+/* Tearing effect synchronized drawing (BSP_LCD_PresentFrame, LCD_TE = 1 in the stm32_adafruit_lcd.h)
+   - 0 disabled
+   - 1 enabled (the display TE pin must be an EXTI input in Cube with rising edge interrupt) */
+#define TESYNC       0
+
+/* TE pin assign: TE pin user label in Cube (only TESYNC = 1) */
+#define TE_NAME      TFT_TE
+
 /* Font size (Font8 or Font12 or Font16 or Font20 or Font24) */
 #define FONTNAME     Font12
 
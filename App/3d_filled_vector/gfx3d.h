@@ -458,6 +458,31 @@ void backgroundStars(int f)
 // ------------------------------------------------
 
 int t = 0;
+int renderMode = 0;
+
+// render and draw one band (lines from yFrame, called from render3D or BSP_LCD_PresentFrame)
+void renderBand(uint16_t yFrame, uint16_t lines)
+{
+  yFr = yFrame;
+  if(bgMode == 0)
+    backgroundPattern(t, pat2);
+  else if(bgMode == 1)
+    backgroundPattern(t, pat8);
+  else if(bgMode == 2)
+    backgroundPattern(t, pat7);
+  else if(bgMode == 3)
+    backgroundStars(t);
+  else if(bgMode == 4)
+    backgroundChecker(t);
+  renderMode ? drawTris(projVerts) : drawQuads(projVerts);
+  BSP_LCD_DrawRGB16Image(0, yFr, SCR_WD, lines, frBuf);
+  #if DOUBLEBUF == 1
+  if(frBuf == frBuf1)
+    frBuf = frBuf2;
+  else
+    frBuf = frBuf1;
+  #endif
+}
 
 // mode=0 for quads, mode=1 for tris
 void render3D(int mode)
@@ -495,28 +520,13 @@ void render3D(int mode)
     updateStars();
   mode ? cullTris(transVerts) : cullQuads(transVerts);
 
+  renderMode = mode;
+  #if TESYNC == 1
+  BSP_LCD_PresentFrame(0, HT_3D, NLINES, renderBand);
+  #else
   for(i = 0; i < HT_3D; i += NLINES)
-  {
-    yFr = i;
-    if(bgMode == 0)
-      backgroundPattern(t, pat2);
-    else if(bgMode == 1)
-      backgroundPattern(t, pat8);
-    else if(bgMode == 2)
-      backgroundPattern(t, pat7);
-    else if(bgMode == 3)
-      backgroundStars(t);
-    else if(bgMode == 4)
-      backgroundChecker(t);
-    mode ? drawTris(projVerts) : drawQuads(projVerts);
-    BSP_LCD_DrawRGB16Image(0, yFr, SCR_WD, NLINES, frBuf);
-    #if DOUBLEBUF == 1
-    if(frBuf == frBuf1)
-      frBuf = frBuf2;
-    else
-      frBuf = frBuf1;
-    #endif
-  }
+    renderBand(i, NLINES);
+  #endif
 
   rot0 += 2;
   rot1 += 4;
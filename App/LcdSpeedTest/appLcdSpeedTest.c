@@ -19,6 +19,11 @@
 /* BSP_LCD_... */
 #include "stm32_adafruit_lcd.h"
 
+/* Host build (Drivers/io_host): bus byte and bus time counters */
+#ifdef  LCD_IO_HOST
+#include "lcd_io_host.h"
+#endif
+
 /* Test photo */
 #if BITMAP_TEST == 1
 #define rombitmap             beer_60x100_16
@@ -118,6 +123,9 @@ uint16_t bitmap[ROMBITMAP_WIDTH * ROMBITMAP_HEIGHT];
 #endif
 #endif
 
+/* Active pixel write bitdepth (see WRITE_BITDEPTH) */
+uint8_t  writebitdepth = 16;
+
 //-----------------------------------------------------------------------------
 uint32_t ClearTest(uint32_t n)
 {
@@ -399,6 +407,17 @@ uint32_t ScrollTest(uint32_t n)
 
 //-----------------------------------------------------------------------------
 #if READ_TEST == 1
+/* The expected read color (12 bit write mode: RGB565 -> RGB444 -> RGB565 as the display expands it) */
+uint16_t ReadColor(uint16_t c)
+{
+  uint16_t r, g, b;
+  if(writebitdepth != 12)
+    return c;
+  r = c >> 12; g = (c >> 7) & 0xF; b = (c >> 1) & 0xF;
+  return (((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3));
+}
+
+//-----------------------------------------------------------------------------
 uint32_t ReadPixelTest(uint32_t n)
 {
   uint16_t x, y, x0, y0, xsize, ysize;
@@ -424,7 +443,7 @@ uint32_t ReadPixelTest(uint32_t n)
   for(y = 0; y < ysize; y++)
     for(x = 0; x < xsize; x++)
     {
-      if(bitmap[y * xsize + x] != rombitmap.data[(ysize - 1 - y) * xsize + x])
+      if(bitmap[y * xsize + x] != ReadColor(rombitmap.data[(ysize - 1 - y) * xsize + x]))
         error++;
     }
 
@@ -459,7 +478,7 @@ uint32_t ReadImageTest(uint32_t n)
   for(y = 0; y < ysize; y++)
     for(x = 0; x < xsize; x++)
     {
-      if(bitmap[y * xsize + x] != rombitmap.data[(ysize - 1 - y) * xsize + x])
+      if(bitmap[y * xsize + x] != ReadColor(rombitmap.data[(ysize - 1 - y) * xsize + x]))
         error++;
     }
 
@@ -472,6 +491,318 @@ uint32_t ReadImageTest(uint32_t n)
 #endif /* #if READ_TEST == 1 */
 #endif /* #if BITMAP_TEST == 1 */
 
+//=============================================================================
+#if BENCH_SWEEP == 1
+/* Benchmark harness
+   - every primitive is called with the same size until the BENCH_MINTIME elapsed
+   - target: the time is measured with GetTime, the bytes are estimated from the pixels (BENCH_PIXELBITS)
+   - host io driver: the estimated bus time and the real bus bytes of the emulator are used
+     (so every driver / interface combination gives comparable numbers) */
+
+#ifdef  LCD_IO_HOST
+#define BenchTime()           BenchHostStat(0)
+#define BenchBytes(pixels)    BenchHostStat(1)
+#define BENCH_TIMESOURCE      "bus"
+#else
+#define BenchTime()           (GetTime() * 1000)
+#define BenchBytes(pixels)    ((uint32_t)((uint64_t)(pixels) * BENCH_PIXELBITS / 8))
+#define BENCH_TIMESOURCE      "tick"
+#endif
+
+#if defined(osCMSIS) && POWERMETER == 1
+#define BenchCpu(t)           (int)cpuusage_calc(t)
+#else
+#define BenchCpu(t)           -1
+#endif
+
+typedef struct
+{
+  const char *name;
+  uint32_t (*draw)(uint16_t size);      /* return: drawn pixels (0: the size is not applicable) */
+  const uint16_t *sizes;                /* 0 terminated size list */
+}bench_item_t;
+
+typedef struct
+{
+  const char *name;
+  uint16_t size;
+  uint32_t pixelrate;                   /* minimum pixels/s */
+}bench_limit_t;
+
+const uint16_t benchsizes[] = {BENCH_SIZES, 0};
+const uint16_t benchfixed[] = {1, 0};   /* fixed size primitives */
+const uint16_t benchfonts[] = {8, 12, 16, 20, 24, 0};
+const bench_limit_t benchlimits[] = {BENCH_LIMITS {NULL, 0, 0}};
+
+uint16_t bench_x, bench_y;
+
+//-----------------------------------------------------------------------------
+#ifdef  LCD_IO_HOST
+uint32_t BenchHostStat(uint32_t bytes)
+{
+  LCD_IO_HostStatTypeDef st;
+  LCD_IO_HostStatGet(&st);
+  if(bytes)
+    return (uint32_t)st.bytes;
+  else
+    return (uint32_t)(st.bustime / 1000);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+/* Random position and color of a w * h object (0: it does not fit on the display) */
+uint32_t BenchPos(uint16_t w, uint16_t h)
+{
+  if(w > BSP_LCD_GetXSize() || h > BSP_LCD_GetYSize())
+    return 0;
+  bench_x = random() % (BSP_LCD_GetXSize() - w + 1);
+  bench_y = random() % (BSP_LCD_GetYSize() - h + 1);
+  BSP_LCD_SetTextColor(LCD_COLOR16(random() & 0xFFFF));
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t BenchPixel(uint16_t s)
+{
+  BenchPos(1, 1);
+  BSP_LCD_DrawPixel(bench_x, bench_y, BSP_LCD_GetTextColor());
+  return 1;
+}
+
+uint32_t BenchHLine(uint16_t s)
+{
+  if(!BenchPos(s, 1))
+    return 0;
+  BSP_LCD_DrawHLine(bench_x, bench_y, s);
+  return s;
+}
+
+uint32_t BenchVLine(uint16_t s)
+{
+  if(!BenchPos(1, s))
+    return 0;
+  BSP_LCD_DrawVLine(bench_x, bench_y, s);
+  return s;
+}
+
+uint32_t BenchLine(uint16_t s)
+{
+  if(!BenchPos(s, s))
+    return 0;
+  BSP_LCD_DrawLine(bench_x, bench_y, bench_x + s - 1, bench_y + s - 1);
+  return s;
+}
+
+uint32_t BenchFillRect(uint16_t s)
+{
+  if(!BenchPos(s, s))
+    return 0;
+  BSP_LCD_FillRect(bench_x, bench_y, s, s);
+  return (uint32_t)s * s;
+}
+
+uint32_t BenchCircle(uint16_t s)
+{
+  uint16_t r = s >> 1;
+  if(!r || !BenchPos((r << 1) + 1, (r << 1) + 1))
+    return 0;
+  BSP_LCD_DrawCircle(bench_x + r, bench_y + r, r);
+  return (uint32_t)r * 710 / 113;       /* 2 * pi * r */
+}
+
+uint32_t BenchFillCircle(uint16_t s)
+{
+  uint16_t r = s >> 1;
+  if(!r || !BenchPos((r << 1) + 1, (r << 1) + 1))
+    return 0;
+  BSP_LCD_FillCircle(bench_x + r, bench_y + r, r);
+  return (uint32_t)r * r * 355 / 113;   /* pi * r^2 */
+}
+
+uint32_t BenchClear(uint16_t s)
+{
+  BSP_LCD_Clear(LCD_COLOR16(random() & 0xFFFF));
+  return (uint32_t)BSP_LCD_GetXSize() * BSP_LCD_GetYSize();
+}
+
+#if BITMAP_TEST == 1
+uint32_t BenchChar(uint16_t s)
+{
+  sFONT * fp;
+  if(s == 8)
+    fp = &Font8;
+  else if(s == 12)
+    fp = &Font12;
+  else if(s == 16)
+    fp = &Font16;
+  else if(s == 20)
+    fp = &Font20;
+  else if(s == 24)
+    fp = &Font24;
+  else
+    return 0;
+  BSP_LCD_SetFont(fp);
+  if(!BenchPos(fp->Width, fp->Height))
+    return 0;
+  BSP_LCD_SetBackColor(LCD_COLOR16(random() & 0xFFFF));
+  BSP_LCD_DisplayChar(bench_x, bench_y, random() % 96 + ' ');
+  return (uint32_t)fp->Width * fp->Height;
+}
+
+uint32_t BenchBitmap(uint16_t s)
+{
+  if(!BenchPos(ROMBITMAP_WIDTH, ROMBITMAP_HEIGHT))
+    return 0;
+  BSP_LCD_DrawBitmap(bench_x, bench_y, (uint8_t *)&rombitmap);
+  return ROMBITMAP_WIDTH * ROMBITMAP_HEIGHT;
+}
+
+/* s * s size image from the bitmap pixels (the data is 2 byte aligned) */
+uint32_t BenchImage(uint16_t s)
+{
+  if((uint32_t)s * s > ROMBITMAP_WIDTH * ROMBITMAP_HEIGHT || !BenchPos(s, s))
+    return 0;
+  BSP_LCD_DrawRGB16Image(bench_x, bench_y, s, s, (uint16_t *)((uint8_t *)&rombitmap + sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER)));
+  return (uint32_t)s * s;
+}
+
+#if READ_TEST == 1
+uint32_t BenchReadPixel(uint16_t s)
+{
+  BenchPos(1, 1);
+  bitmap[0] = BSP_LCD_ReadPixel(bench_x, bench_y);
+  return 1;
+}
+
+uint32_t BenchReadImage(uint16_t s)
+{
+  if((uint32_t)s * s > ROMBITMAP_WIDTH * ROMBITMAP_HEIGHT || !BenchPos(s, s))
+    return 0;
+  BSP_LCD_ReadRGB16Image(bench_x, bench_y, s, s, &bitmap[0]);
+  return (uint32_t)s * s;
+}
+#endif /* #if READ_TEST == 1 */
+#endif /* #if BITMAP_TEST == 1 */
+
+const bench_item_t benchitems[] =
+{
+  {"Pixel",      BenchPixel,      benchfixed},
+  {"HLine",      BenchHLine,      benchsizes},
+  {"VLine",      BenchVLine,      benchsizes},
+  {"Line",       BenchLine,       benchsizes},
+  {"FillRect",   BenchFillRect,   benchsizes},
+  {"Circle",     BenchCircle,     benchsizes},
+  {"FillCircle", BenchFillCircle, benchsizes},
+  {"Clear",      BenchClear,      benchfixed},
+  #if BITMAP_TEST == 1
+  {"Char",       BenchChar,       benchfonts},
+  {"Bitmap",     BenchBitmap,     benchfixed},
+  {"Image",      BenchImage,      benchsizes},
+  #if READ_TEST == 1
+  {"ReadPixel",  BenchReadPixel,  benchfixed},
+  {"ReadImage",  BenchReadImage,  benchsizes},
+  #endif
+  #endif
+  {NULL, NULL, NULL}
+};
+
+//-----------------------------------------------------------------------------
+/* Regression threshold check (return: "", "ok", "slow") */
+const char * BenchStatus(const char *name, uint16_t size, uint32_t pixelrate)
+{
+  const bench_limit_t *l;
+  for(l = &benchlimits[0]; l->name; l++)
+    if(l->size == size && !strcmp(l->name, name))
+      return (pixelrate >= l->pixelrate) ? "ok" : "slow";
+  return "";
+}
+
+//-----------------------------------------------------------------------------
+void BenchPrintHeader(void)
+{
+  #if BENCH_OUTPUT == 0
+  printf("Benchmark (time: %s)\r\n", BENCH_TIMESOURCE);
+  printf("%-10s %5s %8s %10s %10s %10s %9s %10s %10s %4s %s\r\n",
+         "test", "size", "calls", "pixels", "bytes", "time[us]", "calls/s", "pixels/s", "bytes/s", "cpu", "status");
+  #elif BENCH_OUTPUT == 1
+  printf("# display=0x%X, time=%s\r\n", (unsigned int)BSP_LCD_ReadID(), BENCH_TIMESOURCE);
+  printf("test,size,calls,pixels,bytes,time_us,calls_s,pixels_s,bytes_s,cpu,status\r\n");
+  #elif BENCH_OUTPUT == 2
+  printf("{\"display\":\"0x%X\",\"time\":\"%s\"}\r\n", (unsigned int)BSP_LCD_ReadID(), BENCH_TIMESOURCE);
+  #endif
+}
+
+//-----------------------------------------------------------------------------
+void BenchPrint(const char *name, uint16_t size, uint32_t calls, uint32_t pixels, uint32_t bytes, uint32_t t, int cpu)
+{
+  uint32_t callrate, pixelrate, byterate;
+  if(!t)
+    t = 1;
+  callrate  = (uint64_t)calls  * 1000000 / t;
+  pixelrate = (uint64_t)pixels * 1000000 / t;
+  byterate  = (uint64_t)bytes  * 1000000 / t;
+
+  #if BENCH_OUTPUT == 0
+  printf("%-10s %5u %8u %10u %10u %10u %9u %10u %10u %4d %s\r\n", name, (unsigned int)size,
+         (unsigned int)calls, (unsigned int)pixels, (unsigned int)bytes, (unsigned int)t,
+         (unsigned int)callrate, (unsigned int)pixelrate, (unsigned int)byterate, cpu, BenchStatus(name, size, pixelrate));
+  #elif BENCH_OUTPUT == 1
+  printf("%s,%u,%u,%u,%u,%u,%u,%u,%u,%d,%s\r\n", name, (unsigned int)size,
+         (unsigned int)calls, (unsigned int)pixels, (unsigned int)bytes, (unsigned int)t,
+         (unsigned int)callrate, (unsigned int)pixelrate, (unsigned int)byterate, cpu, BenchStatus(name, size, pixelrate));
+  #elif BENCH_OUTPUT == 2
+  printf("{\"test\":\"%s\",\"size\":%u,\"calls\":%u,\"pixels\":%u,\"bytes\":%u,\"time_us\":%u,"
+         "\"calls_s\":%u,\"pixels_s\":%u,\"bytes_s\":%u,\"cpu\":%d,\"status\":\"%s\"}\r\n", name, (unsigned int)size,
+         (unsigned int)calls, (unsigned int)pixels, (unsigned int)bytes, (unsigned int)t,
+         (unsigned int)callrate, (unsigned int)pixelrate, (unsigned int)byterate, cpu, BenchStatus(name, size, pixelrate));
+  #endif
+}
+
+//-----------------------------------------------------------------------------
+/* One benchmark row: the primitive with one size */
+void BenchRun(const bench_item_t *b, uint16_t size)
+{
+  uint32_t i, n, t, bytes, calls = 0, pixels = 0;
+
+  if(!b->draw(size))                    /* first call: check the size and warm up */
+    return;
+
+  n = 1;
+  POWERMETER_START;
+  t = BenchTime();
+  bytes = BenchBytes(0);
+  do
+  {
+    for(i = 0; i < n; i++)
+      pixels += b->draw(size);
+    calls += n;
+    if(n < 256)
+      n <<= 1;
+  } while(BenchTime() - t < BENCH_MINTIME * 1000);
+  t = BenchTime() - t;
+  bytes = BenchBytes(pixels) - bytes;
+  POWERMETER_STOP;
+  Delay(10);
+
+  BenchPrint(b->name, size, calls, pixels, bytes, t, BenchCpu(t / 1000));
+}
+
+//-----------------------------------------------------------------------------
+void BenchSweep(void)
+{
+  const bench_item_t *b;
+  const uint16_t *s;
+
+  BenchPrintHeader();
+  for(b = &benchitems[0]; b->name; b++)
+  {
+    BSP_LCD_Clear(LCD_COLOR_BLACK);
+    for(s = b->sizes; *s; s++)
+      BenchRun(b, *s);
+  }
+}
+#endif /* #if BENCH_SWEEP == 1 */
+
 //-----------------------------------------------------------------------------
 void mainApp(void)
 {
@@ -491,15 +822,28 @@ void mainApp(void)
 
   BSP_LCD_Init();
 
+  t = BSP_LCD_SetWriteBitDepth(WRITE_BITDEPTH);
+  if(t)
+  {
+    writebitdepth = t;
+    printf("\r\nWrite bitdepth = %d\r\n", (int)writebitdepth);
+  }
+
   t = random();
 
   Delay(100);
   printf("\r\nDisplay ID = %X\r\n", (unsigned int)BSP_LCD_ReadID());
   Delay(100);
 
+  #if TEST_CYCLES > 0
+  for(uint32_t cycle = 0; cycle < TEST_CYCLES; cycle++)
+  #else
   while(1)
+  #endif
   {
-    #ifndef  __CC_ARM
+    #if defined(LCD_IO_HOST)
+    srandom(0);
+    #elif !defined(__CC_ARM)
     _impure_ptr->_r48->_rand_next = 0;
     #endif
 
@@ -509,6 +853,10 @@ void mainApp(void)
     Delay(t);
     POWERMETER_STOP;
     POWERMETER_REF;
+
+    #if BENCH_SWEEP == 1
+    BenchSweep();
+    #else
     printf("Delay 300\r\n");
     Delay(DELAY_CHAPTER);
 
@@ -615,6 +963,7 @@ void mainApp(void)
     Delay(DELAY_CHAPTER);
     BSP_LCD_DisplayOn();
     Delay(DELAY_CHAPTER);
+    #endif /* #else BENCH_SWEEP == 1 */
 
     printf("\r\n");
   }
@@ -11,6 +11,13 @@
    - 1: test on */
 #define READ_TEST             1
 
+/* Pixel write bitdepth (BSP_LCD_SetWriteBitDepth after the BSP_LCD_Init)
+   - 0: the lcd driver default (the read test also follows it)
+   - 12: RGB444 (only the lcd drivers with 12 bit write mode, e.g. ST7789_WRITEBITDEPTH 12)
+   - 16: RGB565
+   note: in 12 bit mode the read test compares the truncated (RGB444) colors */
+#define WRITE_BITDEPTH        0
+
 /* Freertos also measures cpu usage
    - 0: measure off
    - 1: measure on */
@@ -24,6 +31,37 @@
 /* Chapter delays */
 #define DELAY_CHAPTER         1000
 
+/* Test cycles
+   - 0: endless
+   - n: the mainApp returns after n cycles (e.g. host build with the Drivers/io_host driver) */
+#define TEST_CYCLES           0
+
+/* Benchmark harness
+   - 0: the fixed tests (original speed test)
+   - 1: every primitive is measured over the BENCH_SIZES size sweep (pixels/s, bytes/s, calls/s, cpu usage) */
+#define BENCH_SWEEP           0
+
+/* Benchmark result format
+   - 0: text table
+   - 1: CSV
+   - 2: JSON (one object per line) */
+#define BENCH_OUTPUT          1
+
+/* Benchmark sizes (line length, rectangle side, circle diameter, image side) */
+#define BENCH_SIZES           1, 4, 16, 64, 128
+
+/* Minimum measure time of one benchmark row [ms] */
+#define BENCH_MINTIME         250
+
+/* Pixel data bits for the bytes/s estimation (16bit color mode: 16, 24bit color mode: 24, 12bit color mode: 12)
+   note: with the host io driver (Drivers/io_host) the real bus bytes are counted */
+#define BENCH_PIXELBITS       16
+
+/* Regression thresholds: {"test name", size, minimum pixels/s},
+   the rows below the threshold are marked with "slow" status
+   e.g. #define BENCH_LIMITS  {"FillRect", 64, 4000000}, {"HLine", 16, 1000000}, */
+#define BENCH_LIMITS
+
 /* Leds pin assign: leds pin user label in Cube
    note: If no have a led -> delete or commented this defines */
 #define LED1_NAME             LED0
@@ -5,12 +5,8 @@
 #define   WIDTH    60
 #define   HEIGHT  100
 
-#if LCD_REVERSE16 == 0
-#define  RC(a)   a
-#endif
-#if LCD_REVERSE16 == 1
-#define  RC(a)   ((((a) & 0xFF) << 8) | (((a) & 0xFF00) >> 8))
-#endif
+/* RGB565 -> LCD_PIXFMT (lcd.h) */
+#define  RC(a)   LCD_PIXFMT16(a)
 
 // struct packing
 #ifdef  __GNUC__
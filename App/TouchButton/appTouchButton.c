@@ -3,6 +3,9 @@
  * author: Roberto Benjami
  * version:  2023.03
  *
+ * - the buttons are widgets (lcd_widget.c must be in the project), the default settings build it in band mode,
+ *   with LCD_WIDGET_BANDSIZE = 0 (direct mode) it needs LCD_CLIP = 1 in the stm32_adafruit_lcd.h
+ * - the DemoProjects / TouchButton_f103c8_ili9341spi.zip is the earlier (2023.03) version without widgets
  * */
 
 #include <stdlib.h>
@@ -13,6 +16,9 @@
 /* BSP LCD driver */
 #include "stm32_adafruit_lcd.h"
 
+/* Widget tree (band mode: default settings, direct mode: LCD_CLIP = 1 in the stm32_adafruit_lcd.h) */
+#include "lcd_widget.h"
+
 /* BSP TS driver */
 #include "stm32_adafruit_ts.h"
 
@@ -144,158 +150,220 @@ extern sFONT led_48x48;                 /* screen led pictures */
 void offButtonTouchDown(void);
 void onButtonTouchDown(void);
 
-//-----------------------------------------------------------------------------
-/* event type codes */
-enum EVENTCODE{EVENT_NONE, EVENT_PAINT, EVENT_TOUCH_DOWN, EVENT_TOUCH_UP, EVENT_TOUCH_MOVE, EVENT_TOUCH_ENTER, EVENT_TOUCH_LEAVE};
-
-/* event type definition */
-typedef struct
-{
-  uint32_t          event_type;         /* event type (see the EVENTCODE) */
-  union
-  {
-    struct
-    { /* 2 * 32 bit parameters */
-      uint32_t      param32_1;
-      uint32_t      param32_2;
-    };
-    struct
-    { /* 4 * 16 bit parameters */
-      uint16_t      param16_1;
-      uint16_t      param16_2;
-      uint16_t      param16_3;
-      uint16_t      param16_4;
-    };
-  };
-}tEvent;
-
-//-----------------------------------------------------------------------------
-/* common visual object type definition */
-typedef struct tObject tObject;
-struct tObject
-{
-  uint16_t          x;                  /* x position */
-  uint16_t          y;                  /* y position */
-  uint16_t          width;              /* width */
-  uint16_t          height;             /* height */
-  void              (*eventProc)(tObject * self, tEvent * event); /* event function */
-};
-
-void tButton_event(tObject * self, tEvent * event);
+void tButton_paint(LCD_WidgetTypeDef * self, const LCD_RectTypeDef * clip);
+void tButton_render(LCD_WidgetTypeDef * self, LCD_BandTypeDef * band);
+void tButton_event(LCD_WidgetTypeDef * self, LCD_WidgetEventTypeDef * event);
+void tLed_paint(LCD_WidgetTypeDef * self, const LCD_RectTypeDef * clip);
+void tLed_render(LCD_WidgetTypeDef * self, LCD_BandTypeDef * band);
 
-/* button object type definition */
+/* button widget type definition */
 typedef struct
 {
-  tObject           obj;
+  LCD_WidgetTypeDef w;
   void              (*onTouch)(void);   /* touch function */
   sFONT *           font;               /* font address */
   uint8_t           chr_u[9];           /* button in passive state */
   uint8_t           chr_d[9];           /* button in active state */
   uint16_t          color_u[9];         /* colors in passive state */
   uint16_t          color_d[9];         /* colors in active state */
+  uint8_t           active;             /* 0: passive state, 1: active state */
 }tButton;
 
+/* led widget type definition */
+typedef struct
+{
+  LCD_WidgetTypeDef w;
+  uint8_t           on;                 /* 0: off, 1: on */
+}tLed;
+
 //-----------------------------------------------------------------------------
 /* off button properties */
-const tButton btn_off =
+tButton btn_off =
 {
+  .w =
   {
-    56,                                 /* x */
-    32,                                 /* y */
-    128,                                /* width */
-    64,                                 /* height */
-    &tButton_event                      /* event function */
+    .Rect = {56, 32, 128, 64},          /* x, y, width, height */
+    .Paint = &tButton_paint,            /* paint function (direct mode) */
+    .Render = &tButton_render,          /* render function (band mode) */
+    .Event = &tButton_event             /* event function */
   },
-  &offButtonTouchDown,                  /* touch function */
-  &font_128x64_8_ledonoff,              /* font address */
-  "\x21\x20\x22\x24\x25",               /* background, border, text, led pin, led */
-  "\x21\x20\x22\x24\x25",               /* background, border, text, led pin, led */
-  {LCD_COLOR(10, 10, 100), LCD_COLOR(255, 255, 0),   LCD_COLOR(123, 123, 10), LCD_COLOR(180, 180, 180), LCD_COLOR(180, 0, 0)},
-  {LCD_COLOR(85, 85, 200), LCD_COLOR(255, 255, 255), LCD_COLOR(200, 200, 30), LCD_COLOR(180, 180, 180), LCD_COLOR(180, 0, 0)},
+  .onTouch = &offButtonTouchDown,       /* touch function */
+  .font = &font_128x64_8_ledonoff,      /* font address */
+  .chr_u = "\x21\x20\x22\x24\x25",      /* background, border, text, led pin, led */
+  .chr_d = "\x21\x20\x22\x24\x25",      /* background, border, text, led pin, led */
+  .color_u = {LCD_COLOR(10, 10, 100), LCD_COLOR(255, 255, 0),   LCD_COLOR(123, 123, 10), LCD_COLOR(180, 180, 180), LCD_COLOR(180, 0, 0)},
+  .color_d = {LCD_COLOR(85, 85, 200), LCD_COLOR(255, 255, 255), LCD_COLOR(200, 200, 30), LCD_COLOR(180, 180, 180), LCD_COLOR(180, 0, 0)},
 };
 
 /* on button properties */
-const tButton btn_on =
+tButton btn_on =
 {
+  .w =
   {
-    56,
-    144,
-    128,
-    64,
-    &tButton_event
+    .Rect = {56, 144, 128, 64},
+    .Paint = &tButton_paint,
+    .Render = &tButton_render,
+    .Event = &tButton_event
   },
-  &onButtonTouchDown,
-  &font_128x64_8_ledonoff,
-  "\x21\x20\x23\x24\x25\x26",           /* background, border, text, led pin, led, led light */
-  "\x21\x20\x23\x24\x25\x26",           /* background, border, text, led pin, led, led light */
-  {LCD_COLOR(10, 10, 100), LCD_COLOR(255, 255, 0),   LCD_COLOR(123, 123, 10), LCD_COLOR(180, 180, 180), LCD_COLOR(255, 0, 0), LCD_COLOR(255, 0, 0)},
-  {LCD_COLOR(85, 85, 200), LCD_COLOR(255, 255, 255), LCD_COLOR(200, 200, 30), LCD_COLOR(180, 180, 180), LCD_COLOR(255, 0, 0), LCD_COLOR(255, 0, 0)},
+  .onTouch = &onButtonTouchDown,
+  .font = &font_128x64_8_ledonoff,
+  .chr_u = "\x21\x20\x23\x24\x25\x26",  /* background, border, text, led pin, led, led light */
+  .chr_d = "\x21\x20\x23\x24\x25\x26",  /* background, border, text, led pin, led, led light */
+  .color_u = {LCD_COLOR(10, 10, 100), LCD_COLOR(255, 255, 0),   LCD_COLOR(123, 123, 10), LCD_COLOR(180, 180, 180), LCD_COLOR(255, 0, 0), LCD_COLOR(255, 0, 0)},
+  .color_d = {LCD_COLOR(85, 85, 200), LCD_COLOR(255, 255, 255), LCD_COLOR(200, 200, 30), LCD_COLOR(180, 180, 180), LCD_COLOR(255, 0, 0), LCD_COLOR(255, 0, 0)},
 };
 
-/* 2 button array */
-const tObject * objects[] = {(tObject *)&btn_off, (tObject *)&btn_on, NULL};
+/* screen led (the size is from the led_48x48 font) */
+tLed led =
+{
+  .w =
+  {
+    .Rect = {230, 100, 48, 48},
+    .Paint = &tLed_paint,
+    .Render = &tLed_render,
+    .Event = NULL                       /* not touchable */
+  },
+  .on = 0
+};
 
 //-----------------------------------------------------------------------------
-/* paint button on screen */
-void tButton_paint(tButton * self, uint8_t off_on)
+/* paint button on screen (from its state) */
+void tButton_paint(LCD_WidgetTypeDef * self, const LCD_RectTypeDef * clip)
 {
-  uint8_t * pchr;
-  uint16_t * pcolors;
-  if(!off_on)
-  { /* passive state */
-    pchr = self->chr_u;
-    pcolors = self->color_u;
-  }
-  else
-  { /* active state */
-    pchr = self->chr_d;
-    pcolors = self->color_d;
-  }
-  BSP_LCD_DisplayStringOnMultilayerChar(self->obj.x, self->obj.y, pchr, pcolors, self->font, 0, 0, NULL);
+  tButton * s = (tButton *)self;
+  (void)clip;                           /* the whole widget is drawn (the BSP_LCD clips it) */
+  if(!s->active)                        /* passive state */
+    BSP_LCD_DisplayStringOnMultilayerChar(s->w.Rect.Xpos, s->w.Rect.Ypos, s->chr_u, s->color_u, s->font, 0, 0, NULL);
+  else                                  /* active state */
+    BSP_LCD_DisplayStringOnMultilayerChar(s->w.Rect.Xpos, s->w.Rect.Ypos, s->chr_d, s->color_d, s->font, 0, 0, NULL);
 }
 
 //-----------------------------------------------------------------------------
-/* tbutton event processor */
-void tButton_event(tObject * self, tEvent * event)
+/* render button into the band (band mode) */
+void tButton_render(LCD_WidgetTypeDef * self, LCD_BandTypeDef * band)
 {
+  #if LCD_WIDGET_BANDSIZE > 0
   tButton * s = (tButton *)self;
-  if(event->event_type == EVENT_PAINT || event->event_type == EVENT_TOUCH_UP || event->event_type == EVENT_TOUCH_LEAVE)
-    tButton_paint(s, 0);                /* paint the button passive state */
-  else if(event->event_type == EVENT_TOUCH_ENTER || event->event_type == EVENT_TOUCH_DOWN)
+  if(!s->active)                        /* passive state */
+    LCD_BandDrawMultilayerChar(band, s->w.Rect.Xpos, s->w.Rect.Ypos, s->chr_u, s->color_u, s->font);
+  else                                  /* active state */
+    LCD_BandDrawMultilayerChar(band, s->w.Rect.Xpos, s->w.Rect.Ypos, s->chr_d, s->color_d, s->font);
+  #endif
+}
+
+//-----------------------------------------------------------------------------
+/* tbutton event processor (it changes only the state, the paint pass draws it) */
+void tButton_event(LCD_WidgetTypeDef * self, LCD_WidgetEventTypeDef * event)
+{
+  tButton * s = (tButton *)self;
+  if(event->Type == LCD_WIDGET_TOUCH_UP || event->Type == LCD_WIDGET_TOUCH_LEAVE)
+    s->active = 0;                      /* passive state */
+  else if(event->Type == LCD_WIDGET_TOUCH_ENTER || event->Type == LCD_WIDGET_TOUCH_DOWN)
   {
     if(s->onTouch)
       s->onTouch();                     /* this function should work when the touchscreen button is pressed */
-    tButton_paint(s, 1);                /* paint the button active state */
+    s->active = 1;                      /* active state */
+  }
+  else
+    return;
+  LCD_WidgetInvalidate(&self->Rect);
+}
+
+//-----------------------------------------------------------------------------
+/* screen led colors */
+static const uint16_t ledoffcolor[] = {LCD_COLOR(100, 10, 10), LCD_COLOR(110, 15, 15)};
+static const uint16_t ledoncolor[]  = {LCD_COLOR(240, 15, 15), LCD_COLOR(255, 120, 30)};
+
+/* paint the screen led */
+void tLed_paint(LCD_WidgetTypeDef * self, const LCD_RectTypeDef * clip)
+{
+  tLed * s = (tLed *)self;
+  (void)clip;                           /* the whole widget is drawn (the BSP_LCD clips it) */
+  BSP_LCD_SetFont(&Font12);
+  if(!s->on)
+  {
+    BSP_LCD_SetTextColor(LCD_COLOR_BLACK);
+    BSP_LCD_DisplayStringOnMultilayerChar(s->w.Rect.Xpos, s->w.Rect.Ypos, (uint8_t *)"\x20\x21", (uint16_t *)&ledoffcolor, &led_48x48,
+                                          (led_48x48.Width - Font12.Width * 3)/2, (led_48x48.Height - Font12.Height) / 2, (uint8_t *)"off");
+  }
+  else
+  {
+    BSP_LCD_SetTextColor(LCD_COLOR_YELLOW);
+    BSP_LCD_DisplayStringOnMultilayerChar(s->w.Rect.Xpos, s->w.Rect.Ypos, (uint8_t *)"\x20\x21", (uint16_t *)&ledoncolor, &led_48x48,
+                                          (led_48x48.Width - Font12.Width * 2) / 2, (led_48x48.Height - Font12.Height) / 2, (uint8_t *)"on");
+  }
+}
+
+/* render the screen led into the band (band mode, the corners are transparent) */
+void tLed_render(LCD_WidgetTypeDef * self, LCD_BandTypeDef * band)
+{
+  #if LCD_WIDGET_BANDSIZE > 0
+  tLed * s = (tLed *)self;
+  if(!s->on)
+  {
+    LCD_BandDrawMultilayerChar(band, s->w.Rect.Xpos, s->w.Rect.Ypos, (uint8_t *)"\x20\x21", ledoffcolor, &led_48x48);
+    LCD_BandDrawString(band, s->w.Rect.Xpos + (led_48x48.Width - Font12.Width * 3) / 2, s->w.Rect.Ypos + (led_48x48.Height - Font12.Height) / 2,
+                       (uint8_t *)"off", &Font12, LCD_COLOR_BLACK);
+  }
+  else
+  {
+    LCD_BandDrawMultilayerChar(band, s->w.Rect.Xpos, s->w.Rect.Ypos, (uint8_t *)"\x20\x21", ledoncolor, &led_48x48);
+    LCD_BandDrawString(band, s->w.Rect.Xpos + (led_48x48.Width - Font12.Width * 2) / 2, s->w.Rect.Ypos + (led_48x48.Height - Font12.Height) / 2,
+                       (uint8_t *)"on", &Font12, LCD_COLOR_YELLOW);
   }
+  #endif
 }
 
 //-----------------------------------------------------------------------------
 /* this function should work when the touchscreen off button is pressed */
 void offButtonTouchDown(void)
 {
-  static const uint16_t ledoffcolor[] = {LCD_COLOR(100, 10, 10), LCD_COLOR(110, 15, 15)};
   HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_SET); /* led off */
-  BSP_LCD_SetFont(&Font12);
-  BSP_LCD_SetTextColor(LCD_COLOR_BLACK);
-  BSP_LCD_DisplayStringOnMultilayerChar(230, 100, (uint8_t *)"\x20\x21", (uint16_t *)&ledoffcolor, &led_48x48,
-                                        (led_48x48.Width - Font12.Width * 3)/2, (led_48x48.Height - Font12.Height) / 2, (uint8_t *)"off");
+  led.on = 0;
+  LCD_WidgetInvalidate(&led.w.Rect);
 }
 
 //-----------------------------------------------------------------------------
 /* this function should work when the touchscreen on button is pressed */
 void onButtonTouchDown(void)
 {
-  static const uint16_t ledoncolor[]  = {LCD_COLOR(240, 15, 15), LCD_COLOR(255, 120, 30)};
   HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_RESET); /* led on */
-  BSP_LCD_SetFont(&Font12);
-  BSP_LCD_SetTextColor(LCD_COLOR_YELLOW);
-  BSP_LCD_DisplayStringOnMultilayerChar(230, 100, (uint8_t *)"\x20\x21", (uint16_t *)&ledoncolor, &led_48x48,
-                                        (led_48x48.Width - Font12.Width * 2) / 2, (led_48x48.Height - Font12.Height) / 2, (uint8_t *)"on");
+  led.on = 1;
+  LCD_WidgetInvalidate(&led.w.Rect);
 }
 
 //-----------------------------------------------------------------------------
 /* read touchscreen and create event */
-void GetTouch(tEvent * event)
+#if TS_EVENT_QUEUE > 0
+/* the touch events from the event queue (the BSP_TS_Sample makes them) */
+void GetTouch(LCD_WidgetEventTypeDef * event)
+{
+  static uint16_t pre_x, pre_y;
+  TS_EventTypeDef ev;
+
+  while(BSP_TS_GetEvent(&ev))
+  {
+    if(ev.Type == TS_EVENT_PRESS)
+      event->Type = LCD_WIDGET_TOUCH_DOWN;
+    else if(ev.Type == TS_EVENT_RELEASE)
+      event->Type = LCD_WIDGET_TOUCH_UP;
+    else if(ev.Type == TS_EVENT_MOVE)
+    {
+      event->Type = LCD_WIDGET_TOUCH_MOVE;
+      event->PrevX = pre_x;             /* previous position */
+      event->PrevY = pre_y;
+    }
+    else
+      continue;                         /* the other gestures are not used in this application */
+    event->X = ev.X;
+    event->Y = ev.Y;
+    pre_x = ev.X;
+    pre_y = ev.Y;
+    return;
+  }
+}
+#else
+void GetTouch(LCD_WidgetEventTypeDef * event)
 {
   static TS_StateTypeDef pre_ts;
   TS_StateTypeDef ts;
@@ -304,74 +372,74 @@ void GetTouch(tEvent * event)
 
   if(ts.TouchDetected && !pre_ts.TouchDetected)
   { /* touch pressure */
-    event->event_type = EVENT_TOUCH_DOWN;
-    event->param16_1 = ts.X;
-    event->param16_2 = ts.Y;
+    event->Type = LCD_WIDGET_TOUCH_DOWN;
+    event->X = ts.X;
+    event->Y = ts.Y;
   }
   else if(!ts.TouchDetected && pre_ts.TouchDetected)
   { /* touch release  */
-    event->event_type = EVENT_TOUCH_UP;
-    event->param16_1 = pre_ts.X;        /* previous position so that we know where we released it*/
-    event->param16_2 = pre_ts.Y;
+    event->Type = LCD_WIDGET_TOUCH_UP;
+    event->X = pre_ts.X;                /* previous position so that we know where we released it*/
+    event->Y = pre_ts.Y;
   }
   else if(ts.TouchDetected && pre_ts.TouchDetected)
   { /* touch position is move */
     if(ts.X != pre_ts.X || ts.Y != pre_ts.Y)
     {
-      event->event_type = EVENT_TOUCH_MOVE;
-      event->param16_1 = ts.X;          /* actual position */
-      event->param16_2 = ts.Y;
-      event->param16_3 = pre_ts.X;      /* previous position */
-      event->param16_4 = pre_ts.Y;
+      event->Type = LCD_WIDGET_TOUCH_MOVE;
+      event->X = ts.X;                  /* actual position */
+      event->Y = ts.Y;
+      event->PrevX = pre_ts.X;          /* previous position */
+      event->PrevY = pre_ts.Y;
     }
   }
 
   memcpy(&pre_ts, &ts, sizeof(TS_StateTypeDef));
 }
+#endif
 
 //-----------------------------------------------------------------------------
-/* event processor */
-void eventProcess(tObject ** os, tEvent * event)
+#define  BACKCOLOR   LCD_COLOR(16, 32, 32)
+
+/* paint the screen background (only the invalidated part) */
+void screen_paint(LCD_WidgetTypeDef * self, const LCD_RectTypeDef * clip)
+{
+  (void)self;
+  BSP_LCD_SetTextColor(BACKCOLOR);
+  BSP_LCD_FillRect(clip->Xpos, clip->Ypos, clip->Width, clip->Height);
+}
+
+/* render the screen background into the band (band mode) */
+void screen_render(LCD_WidgetTypeDef * self, LCD_BandTypeDef * band)
+{
+  (void)self;
+  (void)band;
+  #if LCD_WIDGET_BANDSIZE > 0
+  LCD_BandFillRect(band, band->Clip.Xpos, band->Clip.Ypos, band->Clip.Width, band->Clip.Height, BACKCOLOR);
+  #endif
+}
+
+/* root widget (the size is from the display) */
+LCD_WidgetTypeDef screen = {.Rect = {0, 0, 0, 0}, .Paint = &screen_paint, .Render = &screen_render, .Event = NULL};
+
+/* touch position readout (text slot widget: only the changed digits are redrawn) */
+LCD_TextWidgetTypeDef tpos;
+
+void tpos_show(LCD_WidgetEventTypeDef * event)
 {
-  uint32_t i = 0, i1, i2;
-  tObject * o = os[0];
-  while(o)
+  char s[16];
+  if(event->Type == LCD_WIDGET_TOUCH_DOWN || event->Type == LCD_WIDGET_TOUCH_MOVE)
   {
-    if(o->eventProc != NULL)
-    {
-      if(event->event_type == EVENT_PAINT && o->eventProc != NULL)
-        o->eventProc((void *)o, event);
-      else if(event->event_type == EVENT_TOUCH_DOWN || event->event_type == EVENT_TOUCH_UP)
-      {
-        if((event->param16_1 >= o->x) && (event->param16_1 < o->x + o->width) &&
-           (event->param16_2 >= o->y) && (event->param16_2 < o->y + o->height)) /* in object ? */
-          o->eventProc((void *)o, event);
-      }
-      else if(event->event_type == EVENT_TOUCH_MOVE)
-      {                                           /* move */
-        i1 =(event->param16_1 >= o->x) && (event->param16_1 < o->x + o->width) &&
-            (event->param16_2 >= o->y) && (event->param16_2 < o->y + o->height); /* in object ? */
-        i2 =(event->param16_3 >= o->x) && (event->param16_3 < o->x + o->width) &&
-            (event->param16_4 >= o->y) && (event->param16_4 < o->y + o->height); /* prev in object ? */
-        if(i1 && !i2)
-          event->event_type = EVENT_TOUCH_ENTER;  /* now entered */
-        else if(!i1 && i2)
-          event->event_type = EVENT_TOUCH_LEAVE;  /* now leaved */
-        o->eventProc((void *)o, event);
-      }
-    }
-    i++;
-    o = os[i];
+    sprintf(s, "x:%3u y:%3u", event->X, event->Y);
+    LCD_TextSet(&tpos, s);
   }
 }
 
 //-----------------------------------------------------------------------------
-#define  BACKCOLOR   LCD_COLOR(16, 32, 32)
-
 void mainApp(void)
 {
   uint32_t t_touch;
-  tEvent event;
+  LCD_WidgetEventTypeDef event;
 
   BSP_LCD_Init();
   BSP_TS_Init(BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
@@ -379,22 +447,51 @@ void mainApp(void)
   BSP_LCD_Clear(BACKCOLOR);
   ts_calib();
 
-  offButtonTouchDown();                           /* set the default led state */
+  screen.Rect.Width = BSP_LCD_GetXSize();
+  screen.Rect.Height = BSP_LCD_GetYSize();
+  LCD_WidgetInit(&screen);                        /* the whole screen is invalid */
+  LCD_WidgetAdd(&screen, &btn_off.w);             /* the later widget is on top */
+  LCD_WidgetAdd(&screen, &btn_on.w);
+  LCD_WidgetAdd(&screen, &led.w);
+  LCD_TextInit(&tpos, 4, BSP_LCD_GetYSize() - Font12.Height - 4, 11, &Font12, LCD_COLOR_WHITE, BACKCOLOR);
+  LCD_WidgetAdd(&screen, &tpos.w);
 
-  event.event_type = EVENT_PAINT;
-  eventProcess((tObject **)objects, &event);      /* paint event */
+  offButtonTouchDown();                           /* set the default led state */
 
   t_touch = GetTime();
   while(1)
   {
+    #if TS_EVENT_QUEUE > 0
+    if(GetTime() - t_touch >= 10)
+    { /* 10msec frequently sampling (from a timer interrupt the touches are not lost during the long drawings) */
+      t_touch = GetTime();
+      BSP_TS_Sample();
+    }
+    do
+    { /* process all events */
+      event.Type = LCD_WIDGET_EVENT_NONE;
+      GetTouch(&event);                           /* get touch creen */
+      if(event.Type != LCD_WIDGET_EVENT_NONE)
+      {
+        LCD_WidgetEvent(&event);                  /* to the touched widget (if there was an event) */
+        tpos_show(&event);
+      }
+    }while(event.Type != LCD_WIDGET_EVENT_NONE);
+    #else
     if(GetTime() - t_touch > 50)
     { /* 50msec frequently */
       t_touch = GetTime();
 
-      event.event_type = EVENT_NONE;
+      event.Type = LCD_WIDGET_EVENT_NONE;
       GetTouch(&event);                           /* get touch creen */
-      if(event.event_type != EVENT_NONE)
-        eventProcess((tObject **)objects, &event);/* event processor (if there was an event) */
+      if(event.Type != LCD_WIDGET_EVENT_NONE)
+      {
+        LCD_WidgetEvent(&event);                  /* to the touched widget (if there was an event) */
+        tpos_show(&event);
+      }
     }
+    #endif
+
+    LCD_WidgetPaint();                            /* redraw the invalidated rectangles (if there are) */
   }
 }
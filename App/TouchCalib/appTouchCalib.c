@@ -7,6 +7,13 @@
  *     output: printf...
  */
 
+/* Calibration points
+   - 3: three point calibration (BSP_TS_CalibCalc)
+   - 5: four corners and the center, least squares fit (BSP_TS_CalibCalcN)
+   - 9: 3 x 3 grid, least squares fit (BSP_TS_CalibCalcN)
+   note: the least squares result is in Q16 form (first value: 65536), it is pasted the same way */
+#define CALIBPOINTS           3
+
 #define CALIBBOXSIZE          6
 #define CALIBBOXPOS           15
 
@@ -40,11 +47,32 @@ void touchcalib_drawBox(int32_t x, int32_t y, uint16_t cl)
   BSP_LCD_DrawRect(x - CALIBBOXSIZE / 2, y - CALIBBOXSIZE / 2, CALIBBOXSIZE, CALIBBOXSIZE);
 }
 
+//-----------------------------------------------------------------------------
+/* Box at the display coordinate, waits for the touch and the release */
+void touchcalib_getPoint(int32_t x, int32_t y, int32_t * ptx, int32_t * pty)
+{
+  uint16_t tx, ty;
+  touchcalib_drawBox(x, y, LCD_COLOR_YELLOW);
+  Delay(CALIBDELAY);
+  while(!ts_drv->DetectTouch(0))
+    Delay(TOUCHDELAY);
+  ts_drv->GetXY(0, &tx, &ty);
+  *ptx = tx; *pty = ty;
+  while(ts_drv->DetectTouch(0))
+    Delay(TOUCHDELAY);
+  touchcalib_drawBox(x, y, LCD_COLOR_GRAY);
+}
+
 //-----------------------------------------------------------------------------
 void mainApp(void)
 {
+  #if CALIBPOINTS == 3
   uint16_t tx, ty;
   ts_three_points tc, dc; /* touchscreen and display corrdinates */
+  #else
+  ts_point tc[CALIBPOINTS], dc[CALIBPOINTS];
+  uint32_t i;
+  #endif
   ts_cindex ci;
 
   printf("\r\nPlease: set the LCD ORIENTATION to the value on which the program will run.\r\n");
@@ -57,6 +85,7 @@ void mainApp(void)
   BSP_TS_Init(BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
   BSP_LCD_Clear(LCD_COLOR_BLACK);
 
+  #if CALIBPOINTS == 3
   dc.x0 = 20;
   dc.y0 = 20;
   dc.x1 = BSP_LCD_GetXSize() >> 1;
@@ -94,6 +123,26 @@ void mainApp(void)
 
   BSP_TS_CalibCalc(&tc, &dc, &ci);
 
+  #elif CALIBPOINTS == 5 || CALIBPOINTS == 9
+  for(i = 0; i < CALIBPOINTS; i++)
+  { /* 5: corners and center, 9: 3 x 3 grid (position 0, 1, 2 = CALIBBOXPOS, center, size - CALIBBOXPOS) */
+    #if CALIBPOINTS == 5
+    static const uint8_t gx[5] = {0, 2, 2, 0, 1}, gy[5] = {0, 0, 2, 2, 1};
+    dc[i].x = gx[i]; dc[i].y = gy[i];
+    #else
+    dc[i].x = i % 3; dc[i].y = i / 3;
+    #endif
+    dc[i].x = dc[i].x == 0 ? CALIBBOXPOS : dc[i].x == 1 ? BSP_LCD_GetXSize() >> 1 : BSP_LCD_GetXSize() - 1 - CALIBBOXPOS;
+    dc[i].y = dc[i].y == 0 ? CALIBBOXPOS : dc[i].y == 1 ? BSP_LCD_GetYSize() >> 1 : BSP_LCD_GetYSize() - 1 - CALIBBOXPOS;
+    touchcalib_getPoint(dc[i].x, dc[i].y, &tc[i].x, &tc[i].y);
+  }
+
+  BSP_TS_CalibCalcN(tc, dc, CALIBPOINTS, &ci);
+
+  #else
+  #error "CALIBPOINTS must be 3, 5 or 9"
+  #endif
+
   printf("#define  TS_CINDEX            {%d, %d, %d, %d, %d, %d, %d}\r\n", (int)ci[0], (int)ci[1], (int)ci[2], (int)ci[3], (int)ci[4], (int)ci[5], (int)ci[6]);
 
   while(1);
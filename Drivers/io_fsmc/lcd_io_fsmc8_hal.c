@@ -246,6 +246,7 @@ void HAL_DMA_TxCpltCallback(DMA_HandleTypeDef *hdma)
     else
     { /* dma operations have ended */
       LcdDmaTransEnd();
+      LCD_IO_DMATXEND();
       LCD_IO_DmaTxCpltCallback(hdma);
     }
   }
@@ -753,6 +754,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   #endif
 
   LcdTransStart();
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
 
   /* Command write */
   if(Mode & LCD_IO_CMD8)
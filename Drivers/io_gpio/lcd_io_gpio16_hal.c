@@ -563,6 +563,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
     return;
   #endif
 
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
   HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_RESET);
 
   /* Command write */
@@ -6,6 +6,9 @@
 /*
  * Author: Roberto Benjami
  * version:  2023.04
+ *
+ * - background touch mode: timer stepped measurement between the LCD transactions, ADC DMA (TS_BACKGROUND)
+ * - background touch mode: one measurement cycle in every TS_INTERVAL ms, no ADC start with disabled interrupts
  */
 
 #include "main.h"
@@ -347,6 +350,16 @@ void LCD_IO_Init(void)
   LCD_Delay(10);
 }
 
+//-----------------------------------------------------------------------------
+#if TS_BACKGROUND == 1
+/* The LCD transaction waits while a touch phase holds the pins */
+static void LcdBusAcquire(void);
+static void LcdBusRelease(void);
+#else
+#define LcdBusAcquire()
+#define LcdBusRelease()
+#endif
+
 //-----------------------------------------------------------------------------
 /* Lcd IO transaction
    - Cmd: 8 or 16 bits command
@@ -361,6 +374,8 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
     return;
   #endif
 
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
+  LcdBusAcquire();
   HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_RESET);
 
   /* Command write */
@@ -377,6 +392,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   if(Size == 0)
   { /* only command byte or word */
     HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
+    LcdBusRelease();
     return;
   }
 
@@ -403,6 +419,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   }
   #endif /* #if LCD_DATADIR == 1 */
   HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
+  LcdBusRelease();
 }
 
 //=============================================================================
@@ -537,15 +554,245 @@ TS_DrvTypeDef   gpio_ts_drv =
 
 TS_DrvTypeDef  *ts_drv = &gpio_ts_drv;
 
+#if TS_BACKGROUND == 1
+//=============================================================================
+/* Background mode: the TS_IO_TimerIrq steps the measurement, one timer period is the settle time
+   - TS_STEP_DETECT_SET -> TS_STEP_DETECT_READ: touch detect (YP pullup)
+   - TS_STEP_X_SET -> TS_STEP_X_CONV: X (YP analog, regular scan with DMA)
+   - TS_STEP_Y_SET -> TS_STEP_Y_CONV: Y (XM analog, injected channels)
+   a cycle starts only in every TS_INTERVAL ms (the other timer interrupts do nothing),
+   the pins are held from the ..._SET to the end of the reading (they are released right after the reading),
+   meanwhile the LCD transaction waits, the timer interrupt during an LCD transaction is executed at the end
+   of the transaction (with enabled interrupts) */
+
+#if TS_AD_SAMPLES < 1 || TS_AD_SAMPLES > 4
+#error "TS_AD_SAMPLES must be 1..4 (number of the injected channels)"
+#endif
+
+#define TS_STEP_DETECT_SET    0
+#define TS_STEP_DETECT_READ   1
+#define TS_STEP_X_SET         2
+#define TS_STEP_X_CONV        3
+#define TS_STEP_Y_SET         4
+#define TS_STEP_Y_CONV        5
+#define TS_STEP_ADC           6     /* AD conversion in progress */
+
+/* Last result: the interrupt writes it in one word, so the reader does not need a lock
+   (bit 31: touch, bit 16..27: Y, bit 0..11: X) */
+#define TS_SAMPLE_TOUCH       (1UL << 31)
+
+static volatile uint8_t  ts_step = TS_STEP_DETECT_SET;
+static volatile uint8_t  ts_bus = 0;    /* 1: a touch phase holds the LCD_RS, LCD_WR, LCD_D6, LCD_D7 pins */
+static volatile uint8_t  lcd_bus = 0;   /* 1: LCD transaction in progress */
+static volatile uint8_t  ts_pending = 0;/* timer interrupt during the LCD transaction */
+static volatile uint32_t ts_sample = 0;
+static uint32_t ts_time = 0;            /* start time of the last cycle (HAL_GetTick) */
+static uint16_t ts_adbuf[TS_AD_SAMPLES];
+static int32_t  ts_x, ts_prex = -TOUCH_FILTER, ts_prey = -TOUCH_FILTER; /* -TOUCH_FILTER: no previous value */
+
+static const uint32_t ts_injrank[4] = {ADC_INJECTED_RANK_1, ADC_INJECTED_RANK_2, ADC_INJECTED_RANK_3, ADC_INJECTED_RANK_4};
+
+//-----------------------------------------------------------------------------
+/* Touch pins back to LCD pins */
+static void TsPinsRestore(void)
+{
+  LL_GPIO_SetPinPull(LCD_WR_GPIO_Port, LCD_WR_Pin, LL_GPIO_PULL_NO);    /* YP pullup resistor off */
+  HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_SET);        /* XM = 1 */
+  HAL_GPIO_WritePin(LCD_WR_GPIO_Port, LCD_WR_Pin, GPIO_PIN_SET);        /* YP = 1 */
+  HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, GPIO_PIN_SET);        /* XP = 1 */
+  HAL_GPIO_WritePin(LCD_D7_GPIO_Port, LCD_D7_Pin, GPIO_PIN_SET);        /* YM = 1 */
+  LL_GPIO_SetPinMode(LCD_RS_GPIO_Port, LCD_RS_Pin, LL_GPIO_MODE_OUTPUT);/* XM = OUT */
+  LL_GPIO_SetPinMode(LCD_WR_GPIO_Port, LCD_WR_Pin, LL_GPIO_MODE_OUTPUT);/* YP = OUT */
+  LL_GPIO_SetPinMode(LCD_D6_GPIO_Port, LCD_D6_Pin, LL_GPIO_MODE_OUTPUT);/* XP = OUT */
+  LL_GPIO_SetPinMode(LCD_D7_GPIO_Port, LCD_D7_Pin, LL_GPIO_MODE_OUTPUT);/* YM = OUT */
+  ts_bus = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Next measurement step (from the timer interrupt or from the end of the LCD transaction) */
+static void TsStep(void)
+{
+  switch(ts_step)
+  {
+    case TS_STEP_DETECT_SET:
+      if((HAL_GetTick() - ts_time) < TS_INTERVAL)
+        break;                          /* the pins are free between the cycles */
+      ts_time = HAL_GetTick();
+      ts_bus = 1;
+      LL_GPIO_SetPinMode(LCD_D7_GPIO_Port, LCD_D7_Pin, LL_GPIO_MODE_INPUT); /* YM = D_INPUT */
+      LL_GPIO_SetPinMode(LCD_WR_GPIO_Port, LCD_WR_Pin, LL_GPIO_MODE_INPUT); /* YP = D_INPUT */
+      HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_RESET);      /* XM = 0 */
+      HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, GPIO_PIN_RESET);      /* XP = 0 */
+      LL_GPIO_SetPinPull(LCD_WR_GPIO_Port, LCD_WR_Pin, LL_GPIO_PULL_UP);    /* YP pullup resistor on */
+      ts_step = TS_STEP_DETECT_READ;
+      break;
+
+    case TS_STEP_DETECT_READ:
+      if(HAL_GPIO_ReadPin(LCD_WR_GPIO_Port, LCD_WR_Pin))                    /* YP ? */
+      { /* not pressed */
+        ts_sample &= ~TS_SAMPLE_TOUCH;
+        ts_prex = -TOUCH_FILTER;
+        ts_prey = -TOUCH_FILTER;
+        ts_step = TS_STEP_DETECT_SET;
+      }
+      else
+        ts_step = TS_STEP_X_SET;
+      TsPinsRestore();
+      break;
+
+    case TS_STEP_X_SET:
+      ts_bus = 1;
+      LL_GPIO_SetPinMode(LCD_D7_GPIO_Port, LCD_D7_Pin, LL_GPIO_MODE_INPUT); /* YM = D_INPUT */
+      LL_GPIO_SetPinMode(LCD_WR_GPIO_Port, LCD_WR_Pin, LL_GPIO_MODE_ANALOG);/* YP = AN_INPUT */
+      HAL_GPIO_WritePin(LCD_RS_GPIO_Port, LCD_RS_Pin, GPIO_PIN_SET);        /* XM = 1 */
+      HAL_GPIO_WritePin(LCD_D6_GPIO_Port, LCD_D6_Pin, GPIO_PIN_RESET);      /* XP = 0 */
+      ts_step = TS_STEP_X_CONV;
+      break;
+
+    case TS_STEP_X_CONV:
+      ts_step = TS_STEP_ADC;
+      if(HAL_ADC_Start_DMA(&TS_AD_HANDLE, (uint32_t *)ts_adbuf, TS_AD_SAMPLES) != HAL_OK)
+      {
+        ts_step = TS_STEP_DETECT_SET;
+        TsPinsRestore();
+      }
+      break;
+
+    case TS_STEP_Y_SET:
+      ts_bus = 1;
+      LL_GPIO_SetPinMode(LCD_RS_GPIO_Port, LCD_RS_Pin, LL_GPIO_MODE_ANALOG);/* XM = AN_INPUT */
+      LL_GPIO_SetPinMode(LCD_D6_GPIO_Port, LCD_D6_Pin, LL_GPIO_MODE_INPUT); /* XP = D_INPUT */
+      HAL_GPIO_WritePin(LCD_D7_GPIO_Port, LCD_D7_Pin, GPIO_PIN_RESET);      /* YM = 0 */
+      HAL_GPIO_WritePin(LCD_WR_GPIO_Port, LCD_WR_Pin, GPIO_PIN_SET);        /* YP = 1 */
+      ts_step = TS_STEP_Y_CONV;
+      break;
+
+    case TS_STEP_Y_CONV:
+      ts_step = TS_STEP_ADC;
+      if(HAL_ADCEx_InjectedStart_IT(&TS_AD_HANDLE) != HAL_OK)
+      {
+        ts_step = TS_STEP_DETECT_SET;
+        TsPinsRestore();
+      }
+      break;
+
+    default:                            /* TS_STEP_ADC: wait for the end of conversion */
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* X conversions end (regular scan, DMA) */
+#if USE_HAL_ADC_REGISTER_CALLBACKS == 0
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+#elif USE_HAL_ADC_REGISTER_CALLBACKS == 1
+static void HAL_ADC_ConvCpltCallback_Ts(ADC_HandleTypeDef *hadc)
+#endif
+{
+  uint32_t i;
+  if(hadc != &TS_AD_HANDLE)
+    return;
+  HAL_ADC_Stop_DMA(&TS_AD_HANDLE);
+  TsPinsRestore();
+  ts_x = 0;
+  for(i = 0; i < TS_AD_SAMPLES; i++)
+    ts_x += ts_adbuf[i];
+  ts_x /= TS_AD_SAMPLES;
+  ts_step = TS_STEP_Y_SET;
+}
+
+//-----------------------------------------------------------------------------
+/* Y conversions end (injected channels): two same values after each other -> result */
+#if USE_HAL_ADC_REGISTER_CALLBACKS == 0
+void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc)
+#elif USE_HAL_ADC_REGISTER_CALLBACKS == 1
+static void HAL_ADCEx_InjectedConvCpltCallback_Ts(ADC_HandleTypeDef *hadc)
+#endif
+{
+  uint32_t i;
+  int32_t  y = 0;
+  if(hadc != &TS_AD_HANDLE)
+    return;
+  for(i = 0; i < TS_AD_SAMPLES; i++)
+    y += HAL_ADCEx_InjectedGetValue(&TS_AD_HANDLE, ts_injrank[i]);
+  HAL_ADCEx_InjectedStop_IT(&TS_AD_HANDLE);
+  TsPinsRestore();
+  y /= TS_AD_SAMPLES;
+  if((ABS(ts_x - ts_prex) < TOUCH_FILTER) && (ABS(y - ts_prey) < TOUCH_FILTER))
+    ts_sample = TS_SAMPLE_TOUCH | (((y + ts_prey) >> 1) << 16) | ((ts_x + ts_prex) >> 1);
+  ts_prex = ts_x;
+  ts_prey = y;
+  ts_step = TS_STEP_DETECT_SET;         /* the next detect clears the touch when released */
+}
+
+//-----------------------------------------------------------------------------
+/* Measurement step (call it from a timer interrupt, period = settle time) */
+void TS_IO_TimerIrq(void)
+{
+  if(lcd_bus)
+    ts_pending = 1;                     /* LCD transaction in progress: it will be executed at the end */
+  else
+  {
+    ts_pending = 0;
+    TsStep();
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void LcdBusAcquire(void)
+{
+  while(1)
+  {
+    __disable_irq();
+    if(!ts_bus)
+    {
+      lcd_bus = 1;
+      __enable_irq();
+      return;
+    }
+    __enable_irq();
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void LcdBusRelease(void)
+{
+  uint8_t pending;
+  __disable_irq();
+  pending = ts_pending;
+  ts_pending = 0;
+  lcd_bus = pending;                    /* the timer interrupt must not step while the delayed step is running */
+  __enable_irq();
+  if(pending)
+  { /* delayed step with enabled interrupts (the ADC start must not run with disabled interrupts) */
+    TsStep();
+    lcd_bus = 0;
+  }
+}
+#endif /* #if TS_BACKGROUND == 1 */
 
 //-----------------------------------------------------------------------------
 void ts_Init(uint16_t DeviceAddr)
 {
+  #if TS_BACKGROUND == 1 && USE_HAL_ADC_REGISTER_CALLBACKS == 1
+  HAL_ADC_RegisterCallback(&TS_AD_HANDLE, HAL_ADC_CONVERSION_COMPLETE_CB_ID, HAL_ADC_ConvCpltCallback_Ts);
+  HAL_ADC_RegisterCallback(&TS_AD_HANDLE, HAL_ADC_INJ_CONVERSION_COMPLETE_CB_ID, HAL_ADCEx_InjectedConvCpltCallback_Ts);
+  #endif
 }
 
 //-----------------------------------------------------------------------------
 uint8_t ts_DetectTouch(uint16_t DeviceAddr)
 {
+  #if TS_BACKGROUND == 1
+  uint32_t s = ts_sample;               /* one read: the touch and the position are from the same measurement */
+  if(s & TS_SAMPLE_TOUCH)
+  {
+    tx = s & 0xFFF;
+    ty = (s >> 16) & 0xFFF;
+    return 1;
+  }
+  return 0;
+  #else
   static uint8_t ret = 0;
   int32_t x1, x2, y1, y2, i;
 
@@ -579,6 +826,7 @@ uint8_t ts_DetectTouch(uint16_t DeviceAddr)
     }
   }
   return ret;
+  #endif
 }
 
 //-----------------------------------------------------------------------------
@@ -58,6 +58,14 @@
      - Pull-up/Pull-down: No pull-up and no pull-down
      - Max output speed: Low
      - User Label: LCD_BL
+   Background touch mode (TS_BACKGROUND = 1)
+   - ADC regular group: scan mode enabled, number of conversion: TS_AD_SAMPLES, every rank: TS_WR_ADCCH,
+     continuous conversion: disabled, external trigger: software, DMA continuous requests: disabled
+   - ADC injected group: number of conversions: TS_AD_SAMPLES, every rank: TS_RS_ADCCH, external trigger: software
+   - ADC DMA Settings: normal mode, data width: Half Word
+   - NVIC: ADC global interrupt and the DMA stream interrupt enabled
+   - a timer interrupt (period = touch settle time, e.g. 100..200us) that calls the TS_IO_TimerIrq
+     (HAL_TIM_PeriodElapsedCallback), the LCD transaction waits at most one period during a measurement cycle
 */
 
 #ifndef __LCD_IO_GPIO8_H
@@ -93,6 +101,20 @@
 /* This is how many times it tries to read the same value */
 #define TOUCH_MAXREPEAT       8
 
+/* Background touch acquisition
+   - 0: the BSP_TS_GetState reads the touchscreen (blocking, the LCD bus is reclaimed for milliseconds, default)
+   - 1: the TS_IO_TimerIrq steps the measurement (pin setting, one timer period settle time, conversion), the
+        touch phases are scheduled between the LCD transactions, the BSP_TS_GetState returns the last result
+        immediately, the X is read with the regular ADC scan and DMA, the Y with the injected channels */
+#define TS_BACKGROUND         0
+
+/* Sampling interval in background mode (ms, one measurement cycle is started in this time,
+   one cycle holds the LCD bus for about 5 timer periods) */
+#define TS_INTERVAL           20
+
+/* Number of the AD conversions per axis in background mode (1..4, these are averaged) */
+#define TS_AD_SAMPLES         4
+
 /*=============================================================================
 I/O group optimization so that GPIO operations are not performed bit by bit:
 Note: If the pins are in order, they will automatically optimize.
@@ -139,4 +161,8 @@ dt = ((GPIOD->IDR & 0b1100000000000000) >> 14) | ((GPIOD->IDR & 0b00000000000000
 /* Note: the keil compiler cannot use binary numbers, convert it to hexadecimal */
 #endif
 
+//=============================================================================
+/* Interface section (background mode) */
+void    TS_IO_TimerIrq(void);
+
 #endif // __LCD_IO_GPIO8_H
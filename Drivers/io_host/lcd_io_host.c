@@ -0,0 +1,770 @@
+/*
+ * Host (Linux, Windows) LCD io driver with display controller emulation
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+//-----------------------------------------------------------------------------
+/* Public function name prefix in multi display mode (LCD_MULTI = 1, see lcd.h and lcd_io.h) */
+#define  LCD_IO_NAME          lcd_io_host
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "main.h"
+#include "lcd.h"
+#include "lcd_io.h"
+#include "lcd_io_host.h"
+#include "lcd_io_rgb12.h"
+
+#if LCD_HOST_REALDELAY == 1
+#if defined(_WIN32)
+#include <windows.h>
+#define  HostSleep(ms)        Sleep(ms)
+#else
+#include <unistd.h>
+#define  HostSleep(ms)        usleep((ms) * 1000)
+#endif
+#else
+#define  HostSleep(ms)
+#endif
+
+//-----------------------------------------------------------------------------
+/* MIPI-DCS commands */
+#define  DCS_SWRESET          0x01
+#define  DCS_RDDID            0x04
+#define  DCS_DISPOFF          0x28
+#define  DCS_DISPON           0x29
+#define  DCS_CASET            0x2A
+#define  DCS_PASET            0x2B
+#define  DCS_RAMWR            0x2C
+#define  DCS_RAMRD            0x2E
+#define  DCS_VSCRDEF          0x33
+#define  DCS_TEOFF            0x34
+#define  DCS_TEON             0x35
+#define  DCS_MADCTL           0x36
+#define  DCS_VSCRSADD         0x37
+#define  DCS_COLMOD           0x3A
+#define  DCS_RAMWRC           0x3C
+#define  DCS_RAMRDC           0x3E
+#define  DCS_RDID4            0xD3
+
+#define  MAD_MY               0x80
+#define  MAD_MX               0x40
+#define  MAD_MV               0x20
+
+/* ILI9325 registers */
+#define  REG_ID               0x00
+#define  REG_DRIV_OUT_CTRL    0x01
+#define  REG_ENTRY_MOD        0x03
+#define  REG_DISP_CTRL1       0x07
+#define  REG_GRAM_HOR_AD      0x20
+#define  REG_GRAM_VER_AD      0x21
+#define  REG_RW_GRAM          0x22
+#define  REG_HOR_START_AD     0x50
+#define  REG_HOR_END_AD       0x51
+#define  REG_VER_START_AD     0x52
+#define  REG_VER_END_AD       0x53
+#define  REG_GATE_SCAN_CTRL1  0x60
+#define  REG_GATE_SCAN_CTRL2  0x61
+#define  REG_GATE_SCAN_CTRL3  0x6A
+
+#define  ENTRY_ID1            0x0020    /* vertical increment */
+#define  ENTRY_ID0            0x0010    /* horizontal increment */
+#define  ENTRY_AM             0x0008    /* vertical address update */
+
+#define  HOST_MAXCMD          0x10000
+
+//-----------------------------------------------------------------------------
+static struct
+{
+  uint32_t controller;
+  uint32_t width, height;               /* GRAM size */
+  uint32_t id;
+  uint8_t  mirror;
+  uint16_t *gram;
+  uint8_t  dispon;
+
+  /* MIPI-DCS */
+  uint8_t  madctl;
+  uint8_t  colmod;
+  uint16_t xs, xe, ys, ye;              /* column and page address window */
+  uint16_t xc, yc;                      /* address counter */
+  uint16_t tfa, vsa, bfa, vsp;          /* vertical scroll */
+  uint8_t  teon;                        /* TE output on */
+
+  /* ILI9325 */
+  uint16_t regs[0x100];
+}lcd;
+
+static LCD_IO_HostStatTypeDef stat;
+static uint32_t cmdcount[HOST_MAXCMD];
+static uint64_t cmdbytes[HOST_MAXCMD];
+
+/* TE signal stand-in (see LCD_IO_HostTeConfig) */
+static struct
+{
+  uint32_t period;
+  void     (*callback)(void);
+  uint32_t next;
+  uint8_t  busy;
+}te;
+
+//=============================================================================
+/* HAL time functions on host */
+
+//-----------------------------------------------------------------------------
+uint32_t HAL_GetTick(void)
+{
+  static uint64_t t0 = 0;
+  uint64_t t;
+  uint32_t r;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  t = (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+  if(!t0)
+    t0 = t;
+  r = (uint32_t)(t - t0);
+
+  /* The host has no interrupts: the TE callback is called from here when the TE period has elapsed */
+  if(te.callback && lcd.teon && !te.busy && (int32_t)(r - te.next) >= 0)
+  {
+    while((int32_t)(r - te.next) >= 0)
+      te.next += te.period;
+    te.busy = 1;
+    te.callback();
+    te.busy = 0;
+  }
+  return r;
+}
+
+//-----------------------------------------------------------------------------
+void HAL_Delay(uint32_t Delay)
+{
+  uint32_t t = HAL_GetTick();
+  while(HAL_GetTick() - t < Delay);
+}
+
+//=============================================================================
+/* Transaction data access */
+
+//-----------------------------------------------------------------------------
+/* n-th 16bit word of the data (DATA8: two bytes in high-low order) */
+static uint16_t DataGet16(uint8_t *pData, uint32_t n, uint32_t Mode)
+{
+  uint16_t d;
+  if(Mode & LCD_IO_FILL)
+    n = 0;
+  if(Mode & LCD_IO_DATA8)
+  {
+    if(Mode & LCD_IO_FILL)
+      return pData[0];
+    return (pData[2 * n] << 8) | pData[2 * n + 1];
+  }
+  d = ((uint16_t *)pData)[n];
+  if(Mode & LCD_IO_REVERSE16)
+    d = (d << 8) | (d >> 8);
+  return d;
+}
+
+//-----------------------------------------------------------------------------
+/* n-th byte of the data (DATA16: high byte first) */
+static uint8_t DataGet8(uint8_t *pData, uint32_t n, uint32_t Mode)
+{
+  if(Mode & LCD_IO_DATA8)
+    return (Mode & LCD_IO_FILL) ? pData[0] : pData[n];
+  return (n & 1) ? DataGet16(pData, n >> 1, Mode) & 0xFF : DataGet16(pData, n >> 1, Mode) >> 8;
+}
+
+//-----------------------------------------------------------------------------
+/* Data byte number (parameters) */
+static uint32_t DataBytes(uint32_t Size, uint32_t Mode)
+{
+  return (Mode & LCD_IO_DATA8) ? Size : Size << 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Pixel number (DATA8: 2 bytes / pixel) */
+static uint32_t DataPixels(uint32_t Size, uint32_t Mode)
+{
+  return (Mode & LCD_IO_DATA8) ? Size >> 1 : Size;
+}
+
+//-----------------------------------------------------------------------------
+/* n-th pixel of the 12bit (RGB444, 3 bytes / 2 pixels) data, expanded to RGB565 */
+static uint16_t DataGet12(uint8_t *pData, uint32_t n)
+{
+  uint8_t  *p = &pData[(n >> 1) * 3];
+  uint16_t c, r, g, b;
+  if(n & 1)
+    c = ((p[1] & 0x0F) << 8) | p[2];
+  else
+    c = (p[0] << 4) | (p[1] >> 4);
+  r = c >> 8; g = (c >> 4) & 0xF; b = c & 0xF;
+  return (((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3));
+}
+
+//-----------------------------------------------------------------------------
+/* Store one read pixel into the destination */
+static void DataPut(uint8_t *pData, uint32_t n, uint16_t c, uint32_t Mode)
+{
+  if(Mode & LCD_IO_DATA8)
+  { /* 8bit read: RGB888 (as the 18bit RAMRD of the MIPI-DCS controllers) */
+    pData[3 * n]     = (c >> 8) & 0xF8;
+    pData[3 * n + 1] = (c >> 3) & 0xFC;
+    pData[3 * n + 2] = (c << 3) & 0xF8;
+  }
+  else
+  {
+    if(Mode & LCD_IO_REVERSE16)
+      c = (c << 8) | (c >> 8);
+    ((uint16_t *)pData)[n] = c;
+  }
+}
+
+//=============================================================================
+/* MIPI-DCS controller */
+
+//-----------------------------------------------------------------------------
+static void DcsReset(void)
+{
+  lcd.madctl = 0;
+  lcd.colmod = 0x66;
+  lcd.xs = 0; lcd.xe = lcd.width - 1;
+  lcd.ys = 0; lcd.ye = lcd.height - 1;
+  lcd.xc = 0; lcd.yc = 0;
+  lcd.tfa = 0; lcd.vsa = lcd.height; lcd.bfa = 0; lcd.vsp = 0;
+  lcd.dispon = 0;
+  lcd.teon = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* GRAM index of the address counter, and step the counter (-1: outside the GRAM)
+   (the controller exchanges the column and page first (MV), then mirrors the physical axes (MX, MY)) */
+static int32_t DcsAddrStep(void)
+{
+  uint32_t x = lcd.xc, y = lcd.yc, t;
+  int32_t  ret = -1;
+
+  if(lcd.madctl & MAD_MV)
+  {
+    t = x;
+    x = y;
+    y = t;
+  }
+  if(x < lcd.width && y < lcd.height)
+  {
+    if(lcd.madctl & MAD_MX)
+      x = lcd.width - 1 - x;
+    if(lcd.madctl & MAD_MY)
+      y = lcd.height - 1 - y;
+    ret = y * lcd.width + x;
+  }
+
+  if(lcd.xc >= lcd.xe)
+  {
+    lcd.xc = lcd.xs;
+    lcd.yc = (lcd.yc >= lcd.ye) ? lcd.ys : lcd.yc + 1;
+  }
+  else
+    lcd.xc++;
+  return ret;
+}
+
+//-----------------------------------------------------------------------------
+static void DcsWrite(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Mode)
+{
+  uint32_t i, n;
+  int32_t  a;
+
+  n = DataBytes(Size, Mode);
+  switch(Cmd)
+  {
+    case DCS_SWRESET:
+      DcsReset();
+      break;
+    case DCS_DISPOFF:
+      lcd.dispon = 0;
+      break;
+    case DCS_DISPON:
+      lcd.dispon = 1;
+      break;
+    case DCS_TEOFF:
+      lcd.teon = 0;
+      break;
+    case DCS_TEON:
+      lcd.teon = 1;
+      break;
+    case DCS_CASET:
+      if(n >= 4)
+      {
+        lcd.xs = DataGet16(pData, 0, Mode);
+        lcd.xe = DataGet16(pData, 1, Mode);
+      }
+      break;
+    case DCS_PASET:
+      if(n >= 4)
+      {
+        lcd.ys = DataGet16(pData, 0, Mode);
+        lcd.ye = DataGet16(pData, 1, Mode);
+      }
+      break;
+    case DCS_VSCRDEF:
+      if(n >= 6)
+      {
+        lcd.tfa = DataGet16(pData, 0, Mode);
+        lcd.vsa = DataGet16(pData, 1, Mode);
+        lcd.bfa = DataGet16(pData, 2, Mode);
+      }
+      break;
+    case DCS_VSCRSADD:
+      if(n >= 2)
+        lcd.vsp = DataGet16(pData, 0, Mode);
+      break;
+    case DCS_MADCTL:
+      if(n >= 1)
+        lcd.madctl = DataGet8(pData, 0, Mode);
+      break;
+    case DCS_COLMOD:
+      if(n >= 1)
+        lcd.colmod = DataGet8(pData, 0, Mode);
+      break;
+    case DCS_RAMWR:
+    case DCS_RAMWRC:
+      if(Cmd == DCS_RAMWR)
+      {
+        lcd.xc = lcd.xs;
+        lcd.yc = lcd.ys;
+      }
+      if((Mode & LCD_IO_DATA8) && (lcd.colmod & 7) == 3)
+      { /* 12bit pixel format */
+        n = Size * 2 / 3;
+        for(i = 0; i < n; i++)
+        {
+          a = DcsAddrStep();
+          if(a >= 0)
+            lcd.gram[a] = DataGet12(pData, i);
+        }
+      }
+      else
+      {
+        n = DataPixels(Size, Mode);
+        for(i = 0; i < n; i++)
+        {
+          a = DcsAddrStep();
+          if(a >= 0)
+            lcd.gram[a] = DataGet16(pData, i, Mode);
+        }
+      }
+      stat.wrpixels += n;
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* RGB565 -> RGB444 packing (as the SPI io driver sends it on the bus: 3 bytes / 2 pixels)
+   - the same conversion functions (lcd_io_rgb12.h) and chunks (LCD_HOST_RGB12_BUFFSIZE as the LCD_RGB12_BUFFSIZE
+     of the SPI io driver: the fill pattern buffer is converted once, the bitmap is converted chunk by chunk)
+   - pSize: pixel number in, packed byte number out
+   - return: packed data pointer */
+#if LCD_HOST_RGB12_BUFFSIZE & 1
+#error "LCD_HOST_RGB12_BUFFSIZE must be even (as the LCD_RGB12_BUFFSIZE of the SPI io driver)"
+#endif
+#define  RGB12CHUNK           (LCD_HOST_RGB12_BUFFSIZE ? LCD_HOST_RGB12_BUFFSIZE : 2)
+static uint8_t * Pack16to12(uint8_t *pData, uint32_t *pSize, uint32_t Mode)
+{
+  static uint8_t  *buf = NULL;
+  static uint32_t bufsize = 0;
+  static uint8_t  pattern[RGB12CHUNK * 3 / 2];
+  uint32_t Size = *pSize, b = (Size * 3 + 1) >> 1, trsize, trbytes;
+  uint8_t  *tg;
+  if(b > bufsize)
+  {
+    bufsize = b;
+    buf = realloc(buf, bufsize);
+  }
+  if(Mode & LCD_IO_FILL)
+    FillConvert16to12(*(uint16_t *)pData, pattern, RGB12CHUNK);
+  tg = buf;
+  while(Size)
+  {
+    trsize = Size > RGB12CHUNK ? RGB12CHUNK : Size;
+    trbytes = (trsize * 3 + 1) >> 1;
+    if(Mode & LCD_IO_FILL)
+      memcpy(tg, pattern, trbytes);
+    else
+    {
+      BitmapConvert16to12((uint16_t *)pData, tg, trsize);
+      pData += trsize << 1;
+    }
+    tg += trbytes;
+    Size -= trsize;
+  }
+  *pSize = b;
+  return buf;
+}
+
+//-----------------------------------------------------------------------------
+static void DcsRead(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Mode)
+{
+  uint32_t i, n;
+  int32_t  a;
+  uint16_t c;
+
+  switch(Cmd)
+  {
+    case DCS_RDDID:
+    case DCS_RDID4:
+      n = DataBytes(Size, Mode);
+      for(i = 0; i < n; i++)
+      {
+        c = (n - 1 - i < 4) ? (lcd.id >> (8 * (n - 1 - i))) & 0xFF : 0;
+        if(Mode & LCD_IO_DATA8)
+          pData[i] = c;
+        else
+          pData[i ^ 1] = c;             /* 16bit data: high byte first */
+      }
+      break;
+    case DCS_RAMRD:
+    case DCS_RAMRDC:
+      if(Cmd == DCS_RAMRD)
+      {
+        lcd.xc = lcd.xs;
+        lcd.yc = lcd.ys;
+      }
+      n = (Mode & LCD_IO_DATA8) ? Size / 3 : Size;
+      for(i = 0; i < n; i++)
+      {
+        a = DcsAddrStep();
+        c = (a >= 0) ? lcd.gram[a] : 0;
+        DataPut(pData, i, c, Mode);
+      }
+      stat.rdpixels += n;
+      break;
+    default:
+      memset(pData, 0, DataBytes(Size, Mode));
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* GRAM line of the display line (vertical scroll) */
+static uint32_t DcsLine(uint32_t y)
+{
+  if(lcd.vsa && y >= lcd.tfa && y < lcd.tfa + lcd.vsa && lcd.vsp >= lcd.tfa && lcd.vsp < lcd.tfa + lcd.vsa)
+    y = lcd.tfa + (y - lcd.tfa + lcd.vsp - lcd.tfa) % lcd.vsa;
+  return y;
+}
+
+//=============================================================================
+/* ILI9325 style indexed register controller */
+
+//-----------------------------------------------------------------------------
+static void IdxReset(void)
+{
+  memset(lcd.regs, 0, sizeof(lcd.regs));
+  lcd.regs[REG_ENTRY_MOD] = ENTRY_ID1 | ENTRY_ID0;
+  lcd.regs[REG_HOR_END_AD] = lcd.width - 1;
+  lcd.regs[REG_VER_END_AD] = lcd.height - 1;
+  lcd.dispon = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Step one address inside the window (return 1 if wrapped) */
+static uint32_t IdxStep1(uint16_t *a, uint16_t lo, uint16_t hi, uint32_t inc)
+{
+  if(inc)
+  {
+    if(*a >= hi) { *a = lo; return 1; }
+    (*a)++;
+  }
+  else
+  {
+    if(*a <= lo) { *a = hi; return 1; }
+    (*a)--;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+/* GRAM index of the address counter, and step the counter (-1: outside the GRAM) */
+static int32_t IdxAddrStep(void)
+{
+  uint16_t *r = lcd.regs;
+  uint16_t em = r[REG_ENTRY_MOD];
+  int32_t  ret = -1;
+
+  if(r[REG_GRAM_HOR_AD] < lcd.width && r[REG_GRAM_VER_AD] < lcd.height)
+    ret = r[REG_GRAM_VER_AD] * lcd.width + r[REG_GRAM_HOR_AD];
+
+  if(em & ENTRY_AM)
+  {
+    if(IdxStep1(&r[REG_GRAM_VER_AD], r[REG_VER_START_AD], r[REG_VER_END_AD], em & ENTRY_ID1))
+      IdxStep1(&r[REG_GRAM_HOR_AD], r[REG_HOR_START_AD], r[REG_HOR_END_AD], em & ENTRY_ID0);
+  }
+  else
+  {
+    if(IdxStep1(&r[REG_GRAM_HOR_AD], r[REG_HOR_START_AD], r[REG_HOR_END_AD], em & ENTRY_ID0))
+      IdxStep1(&r[REG_GRAM_VER_AD], r[REG_VER_START_AD], r[REG_VER_END_AD], em & ENTRY_ID1);
+  }
+  return ret;
+}
+
+//-----------------------------------------------------------------------------
+static void IdxWrite(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Mode)
+{
+  uint32_t i, n;
+  int32_t  a;
+
+  Cmd &= 0xFF;
+  if(Cmd == REG_RW_GRAM)
+  {
+    n = DataPixels(Size, Mode);
+    for(i = 0; i < n; i++)
+    {
+      a = IdxAddrStep();
+      if(a >= 0)
+        lcd.gram[a] = DataGet16(pData, i, Mode);
+    }
+    stat.wrpixels += n;
+  }
+  else if(DataBytes(Size, Mode) >= 2)
+  {
+    lcd.regs[Cmd] = DataGet16(pData, 0, Mode);
+    if(Cmd == REG_DISP_CTRL1)
+      lcd.dispon = (lcd.regs[Cmd] & 0x0003) == 0x0003;
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void IdxRead(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Mode)
+{
+  uint32_t i, n;
+  int32_t  a;
+  uint16_t c;
+
+  Cmd &= 0xFF;
+  if(Cmd == REG_RW_GRAM)
+  {
+    n = (Mode & LCD_IO_DATA8) ? Size / 3 : Size;
+    for(i = 0; i < n; i++)
+    {
+      a = IdxAddrStep();
+      c = (a >= 0) ? lcd.gram[a] : 0;
+      DataPut(pData, i, c, Mode);
+    }
+    stat.rdpixels += n;
+  }
+  else
+  {
+    c = (Cmd == REG_ID) ? lcd.id : lcd.regs[Cmd];
+    if(Mode & LCD_IO_DATA8)
+    {
+      for(i = 0; i < Size; i++)
+        pData[i] = (i & 1) ? c & 0xFF : c >> 8;
+    }
+    else
+    {
+      for(i = 0; i < Size; i++)
+        ((uint16_t *)pData)[i] = c;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* GRAM line of the display line (vertical scroll) */
+static uint32_t IdxLine(uint32_t y)
+{
+  if(lcd.regs[REG_GATE_SCAN_CTRL2] & 0x0002)
+    y = (y + (lcd.regs[REG_GATE_SCAN_CTRL3] & 0x1FF)) % lcd.height;
+  return y;
+}
+
+//=============================================================================
+/* Emulator interface */
+
+//-----------------------------------------------------------------------------
+void LCD_IO_HostConfig(uint32_t Controller, uint16_t Width, uint16_t Height, uint32_t Id, uint8_t Mirror)
+{
+  free(lcd.gram);
+  lcd.controller = Controller;
+  lcd.width = Width;
+  lcd.height = Height;
+  lcd.id = Id;
+  lcd.mirror = Mirror;
+  lcd.gram = calloc(Width * Height, sizeof(uint16_t));
+  if(Controller == 0)
+    DcsReset();
+  else
+    IdxReset();
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_HostTeConfig(uint32_t Period, void (*Callback)(void))
+{
+  te.period = Period ? Period : 1;
+  te.callback = Callback;
+  te.next = HAL_GetTick() + te.period;
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_HostStatReset(void)
+{
+  memset(&stat, 0, sizeof(stat));
+  memset(cmdcount, 0, sizeof(cmdcount));
+  memset(cmdbytes, 0, sizeof(cmdbytes));
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_HostStatGet(LCD_IO_HostStatTypeDef *pStat)
+{
+  *pStat = stat;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t LCD_IO_HostCmdCount(uint16_t Cmd)
+{
+  return cmdcount[Cmd];
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LCD_IO_HostCmdBytes(uint16_t Cmd)
+{
+  return cmdbytes[Cmd];
+}
+
+//-----------------------------------------------------------------------------
+uint16_t LCD_IO_HostGetPixel(uint16_t X, uint16_t Y)
+{
+  uint32_t mx = lcd.mirror & 0x40, my = lcd.mirror & 0x80;
+  if(!lcd.gram || X >= lcd.width || Y >= lcd.height)
+    return 0;
+  if(lcd.controller)
+  { /* SS and GS bits */
+    mx ^= (lcd.regs[REG_DRIV_OUT_CTRL] & 0x0100) ? 0x40 : 0;
+    my ^= (lcd.regs[REG_GATE_SCAN_CTRL1] & 0x8000) ? 0x80 : 0;
+  }
+  if(mx)
+    X = lcd.width - 1 - X;
+  if(my)
+    Y = lcd.height - 1 - Y;
+  Y = lcd.controller ? IdxLine(Y) : DcsLine(Y);
+  return lcd.gram[Y * lcd.width + X];
+}
+
+//-----------------------------------------------------------------------------
+int LCD_IO_HostDumpPpm(const char *FileName)
+{
+  FILE *f;
+  uint32_t x, y;
+  uint16_t c;
+
+  f = fopen(FileName, "wb");
+  if(!f)
+    return -1;
+  fprintf(f, "P6\n%u %u\n255\n", lcd.width, lcd.height);
+  for(y = 0; y < lcd.height; y++)
+    for(x = 0; x < lcd.width; x++)
+    {
+      c = LCD_IO_HostGetPixel(x, y);
+      fputc(((c >> 11) & 0x1F) << 3, f);
+      fputc(((c >> 5) & 0x3F) << 2, f);
+      fputc((c & 0x1F) << 3, f);
+    }
+  fclose(f);
+  return 0;
+}
+
+//=============================================================================
+/* LCD_IO interface */
+
+//-----------------------------------------------------------------------------
+void LCD_Delay(uint32_t delay)
+{
+  stat.delay += delay;
+  HostSleep(delay);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_Bl_OnOff(uint8_t Bl)
+{
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_Init(void)
+{
+  if(!lcd.gram)
+    LCD_IO_HostConfig(LCD_HOST_CONTROLLER, LCD_HOST_WIDTH, LCD_HOST_HEIGHT, LCD_HOST_ID, LCD_HOST_MIRROR);
+}
+
+//-----------------------------------------------------------------------------
+/* Lcd IO transaction
+   - Cmd: 8 or 16 bits command
+   - pData: 8 or 16 bits data pointer
+   - Size: data number
+   - DummySize: dummy byte number at read
+   - Mode: 8 or 16 or 24 bit mode, write or read, fill or multidata (see the LCD_IO_... defines in lcd_io.h file) */
+void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t DummySize, uint32_t Mode)
+{
+  uint32_t b = 0;
+
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
+  if(!lcd.gram)
+    LCD_IO_Init();
+
+  /* bus bytes */
+  if(Mode & LCD_IO_CMD8)
+    b = 1;
+  else if(Mode & LCD_IO_CMD16)
+    b = 2;
+  if(Mode & LCD_IO_DATA8)
+    b += Size;
+  else if(Mode & LCD_IO_DATA16)
+    b += Size << 1;
+  else if(Mode & LCD_IO_DATA16TO24)
+    b += Size * 3;
+  else if(Mode & LCD_IO_DATA16TO12)
+  { /* the bus data is the packed 12bit pixels (byte stream) */
+    pData = Pack16to12(pData, &Size, Mode);
+    Mode = (Mode & ~(LCD_IO_DATA16TO12 | LCD_IO_FILL)) | LCD_IO_DATA8 | LCD_IO_MULTIDATA;
+    b += Size;
+  }
+  if(Mode & LCD_IO_READ)
+    b += DummySize;
+
+  stat.transactions++;
+  stat.bytes += b;
+  stat.bustime += (uint64_t)b * LCD_HOST_BYTETIME;
+  cmdcount[Cmd]++;
+  cmdbytes[Cmd] += b;
+
+  if(Mode & LCD_IO_WRITE)
+  {
+    if(lcd.controller == 0)
+      DcsWrite(Cmd, pData, Size, Mode);
+    else
+      IdxWrite(Cmd, pData, Size, Mode);
+  }
+  else if(Mode & LCD_IO_READ)
+  {
+    if(lcd.controller == 0)
+      DcsRead(Cmd, pData, Size, Mode);
+    else
+      IdxRead(Cmd, pData, Size, Mode);
+  }
+}
+
+//-----------------------------------------------------------------------------
+#if LCD_MULTI == 1
+/* Io driver function table (the emulator has no DMA) */
+LCD_IO_DrvTypeDef LCD_IO_DRV =
+{
+  LCD_Delay,
+  LCD_IO_Init,
+  LCD_IO_Bl_OnOff,
+  LCD_IO_Transaction,
+  NULL
+};
+#endif
@@ -0,0 +1,101 @@
+//=============================================================================
+/* Information section */
+
+/*
+ * Host (Linux, Windows) LCD io driver with display controller emulation
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+/* Features:
+   - the upper layer (stm32_adafruit_lcd.c) and the lcd drivers can be compiled and run on the PC
+   - MIPI-DCS controller emulation (ILI9341, ST7789, ST7735, ILI9488, ILI9486):
+     SWRESET, CASET, PASET, RAMWR, RAMWRC, RAMRD, RAMRDC, MADCTL, VSCRDEF, VSCRSADD, COLMOD, DISPON, DISPOFF, RDDID, RDID4,
+     TEON, TEOFF (periodic TE signal callback, see LCD_IO_HostTeConfig)
+   - 12bit pixel format (COLMOD 0x53 / 0x03): the LCD_IO_DATA16TO12 transactions are packed into RGB444 bytes
+     with the conversion functions of the SPI io driver (lcd_io_rgb12.h, in LCD_HOST_RGB12_BUFFSIZE chunks)
+     and the RAMWR decodes them back (RGB444 -> RGB565 expanded), so the packing can be checked without hardware
+   - ILI9325 style indexed register controller emulation (ILI9325, ILI9328, ST7781):
+     R00 (ID), R03 (entry mode), R20/R21 (GRAM address), R22 (GRAM), R50..R53 (window), R6A (scroll)
+   - in-memory 16bit GRAM, the visible picture can be saved to ppm file
+     (the color order bits are not emulated: MADCTL BGR, ILI9325 entry mode BGR, the picture shows the written RGB565 values)
+   - command, transaction and byte counters, estimated bus time
+     (so the algorithm changes in the upper layers can be benchmarked by bus cost without hardware)
+
+   How to use:
+   - add the Drivers/io_host folder to the include path (this folder main.h replaces the cubemx main.h)
+   - compile the lcd_io_host.c instead of the stm32 io driver, e.g.:
+     gcc -O2 -IDrivers -IDrivers/io_host -IDrivers/lcd Drivers/stm32_adafruit_lcd.c Drivers/lcd/ili9341.c
+         Drivers/io_host/lcd_io_host.c Drivers/Fonts/font*.c myapp.c
+   - the trace replayer (Tools/LcdTraceReplay) also uses this emulator */
+
+//=============================================================================
+/* Setting section (please set the necessary things in this section) */
+
+#ifndef __LCD_IO_HOST_H__
+#define __LCD_IO_HOST_H__
+
+/* Emulated controller type (can be changed in runtime: LCD_IO_HostConfig)
+   - 0: MIPI-DCS (ILI9341, ST7789, ST7735, ILI9488, ILI9486)
+   - 1: ILI9325 style indexed registers (ILI9325, ILI9328, ST7781) */
+#define LCD_HOST_CONTROLLER   0
+
+/* GRAM size (ILI9341, ST7789, ILI9325: 240 x 320, ST7735: 132 x 162, ILI9488, ILI9486: 320 x 480) */
+#define LCD_HOST_WIDTH        240
+#define LCD_HOST_HEIGHT       320
+
+/* The ID returned by the controller ID read commands (RDDID, RDID4, R00) */
+#define LCD_HOST_ID           0x9341
+
+/* Panel mirror (how the panel is mounted to the GRAM, this is applied at the ppm output)
+   - bit 6 (0x40): X mirror
+   - bit 7 (0x80): Y mirror
+   e.g. ILI9341: 0x40, ST7789: 0xC0, ST7735: 0x00, ILI9325: 0xC0 */
+#define LCD_HOST_MIRROR       0x40
+
+/* Bus time of one byte for the estimated bus time [ns]
+   e.g. SPI 40MHz: 200, SPI 10MHz: 800, FSMC 8bit: 50, FSMC 16bit (16bit = 2 byte): 25 */
+#define LCD_HOST_BYTETIME     200
+
+/* LCD_Delay operation
+   - 0: only counted (the program runs at full speed)
+   - 1: real delay */
+#define LCD_HOST_REALDELAY    0
+
+/* 12bit pixel packing chunk size (set it as the LCD_RGB12_BUFFSIZE of the SPI io driver, even number)
+   - 0: two pixels at a time (as the SPI io driver without buffer)
+   - other: the transaction is packed in chunks of this pixel number (fill: the pattern buffer is repeated,
+     bitmap: chunk by chunk, only the last chunk can have an odd pixel) */
+#define LCD_HOST_RGB12_BUFFSIZE 0
+
+//=============================================================================
+/* Interface section */
+
+typedef struct
+{
+  uint32_t transactions;                /* LCD_IO_Transaction call number */
+  uint64_t bytes;                       /* command + data bytes on the bus (read dummy bytes also) */
+  uint64_t wrpixels;                    /* written pixels */
+  uint64_t rdpixels;                    /* read pixels */
+  uint64_t bustime;                     /* estimated bus time [ns] (bytes * LCD_HOST_BYTETIME) */
+  uint32_t delay;                       /* LCD_Delay sum [ms] */
+}LCD_IO_HostStatTypeDef;
+
+/* Emulator setting (Controller: see LCD_HOST_CONTROLLER, Mirror: see LCD_HOST_MIRROR)
+   note: if not called, the LCD_IO_Init sets the default values from the setting section */
+void     LCD_IO_HostConfig(uint32_t Controller, uint16_t Width, uint16_t Height, uint32_t Id, uint8_t Mirror);
+
+/* TE signal stand-in: after the TEON command the Callback is called in every Period [ms]
+   (from the HAL_GetTick, because the host has no interrupts, e.g. LCD_IO_HostTeConfig(16, BSP_LCD_TeIrq)) */
+void     LCD_IO_HostTeConfig(uint32_t Period, void (*Callback)(void));
+
+void     LCD_IO_HostStatReset(void);
+void     LCD_IO_HostStatGet(LCD_IO_HostStatTypeDef *pStat);
+uint32_t LCD_IO_HostCmdCount(uint16_t Cmd);
+uint64_t LCD_IO_HostCmdBytes(uint16_t Cmd);
+
+/* Visible picture (with panel mirror and scroll) */
+uint16_t LCD_IO_HostGetPixel(uint16_t X, uint16_t Y);
+int      LCD_IO_HostDumpPpm(const char *FileName);
+
+#endif
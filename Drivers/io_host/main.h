@@ -0,0 +1,40 @@
+/*
+ * Host replacement of the cubemx generated main.h (only for Drivers/io_host/lcd_io_host.c)
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* The application can check that it is running on the host (e.g. LCD_IO_HostStatGet) */
+#define LCD_IO_HOST
+
+/* Cortex-M intrinsic used by the lcd drivers */
+static inline int16_t __REVSH(int16_t value)
+{
+  return (int16_t)(((uint16_t)value << 8) | ((uint16_t)value >> 8));
+}
+
+/* Cortex-M interrupt mask and HAL weak functions (the host has no interrupts) */
+#define __weak                __attribute__((weak))
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+static inline void __disable_irq(void) { }
+
+/* HAL time functions (implemented in the lcd_io_host.c) */
+uint32_t HAL_GetTick(void);
+void     HAL_Delay(uint32_t Delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
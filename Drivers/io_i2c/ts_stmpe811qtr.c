@@ -3,6 +3,8 @@
  * author: Roberto Benjami
  * v.2023.01
  *
+ * - interrupt mode with FIFO threshold and I2C DMA (STMPE811_INTMODE)
+ * - interrupt mode: the INT_STA clear is retried after an I2C error, the INT pin level is checked after the clear
  */
 #include <stdlib.h>
 #include <stdio.h>
@@ -171,6 +173,42 @@ TS_DrvTypeDef   stmpe811_ts_drv =
 TS_DrvTypeDef  *ts_drv = &stmpe811_ts_drv;
 uint8_t stmpe811_inited = 0;
 
+#if STMPE811_INTMODE == 1
+/* FIFO size (samples) and one sample size (bytes, TSC_FRACT_XYZ = 1: X 12bit, Y 12bit, Z 8bit) */
+#define STMPE811_FIFO_SIZE              128
+#define STMPE811_SAMPLE_SIZE            4
+
+/* Reading state (the steps are started from the I2C DMA completion interrupts) */
+#define TS_STATE_IDLE                   0
+#define TS_STATE_STATUS                 1   /* TSC_CTRL .. FIFO_SIZE registers read */
+#define TS_STATE_DATA                   2   /* FIFO content read */
+#define TS_STATE_CLEAR                  3   /* INT_STA clear */
+
+/* Last result: the DMA interrupt writes it in one word, so the reader does not need a lock
+   (bit 31: touch, bit 16..27: Y, bit 0..11: X) */
+#define TS_SAMPLE_TOUCH                 (1UL << 31)
+
+static uint8_t  ts_status[STMPE811_REG_FIFO_SIZE - STMPE811_REG_TSC_CTRL + 1];
+static uint8_t  ts_fifo[STMPE811_FIFO_SIZE * STMPE811_SAMPLE_SIZE];
+static volatile uint8_t  ts_state = TS_STATE_IDLE, ts_pending = 0, ts_retry = 0;
+static volatile uint32_t ts_sample = 0;
+static uint16_t tx, ty;
+
+#if USE_HAL_I2C_REGISTER_CALLBACKS == 1
+static void HAL_I2C_MemRxCpltCallback_Ts(I2C_HandleTypeDef *hi2c);
+static void HAL_I2C_MemTxCpltCallback_Ts(I2C_HandleTypeDef *hi2c);
+static void HAL_I2C_ErrorCallback_Ts(I2C_HandleTypeDef *hi2c);
+#endif
+
+/* The INT pin is level triggered (active low), but the EXTI starts the reading only on the falling edge:
+   while the INT pin is low, a new reading must be started without the EXTI */
+#ifdef TS_INT_Pin
+#define TsIntActive()         (HAL_GPIO_ReadPin(TS_INT_GPIO_Port, TS_INT_Pin) == GPIO_PIN_RESET)
+#else
+#define TsIntActive()         0
+#endif
+#endif
+
 //=============================================================================
 void stmpe811_ts_Init(uint16_t DeviceAddr)
 {
@@ -195,13 +233,30 @@ void stmpe811_ts_Init(uint16_t DeviceAddr)
   Delay(2);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_ADC_CTRL2, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_TSC_CFG, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x9A", 1, TS_I2C_TIMEOUT);
+  #if STMPE811_INTMODE == 1
+  dt8 = STMPE811_FIFO_TH;
+  HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_TH, I2C_MEMADD_SIZE_8BIT, &dt8, 1, TS_I2C_TIMEOUT);
+  #else
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_TH, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
+  #endif
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_STA, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_STA, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x00", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_TSC_FRACT_XYZ, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_TSC_I_DRIVE, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_TSC_CTRL, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_INT_STA, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\xFF", 1, TS_I2C_TIMEOUT);
+  #if STMPE811_INTMODE == 1
+  /* FIFO threshold and touch detect interrupts, INT pin: level, active low */
+  dt8 = STMPE811_GIT_FTH | STMPE811_GIT_TOUCH;
+  HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_INT_EN, I2C_MEMADD_SIZE_8BIT, &dt8, 1, TS_I2C_TIMEOUT);
+  dt8 = STMPE811_GIT_EN;
+  HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_INT_CTRL, I2C_MEMADD_SIZE_8BIT, &dt8, 1, TS_I2C_TIMEOUT);
+  #if USE_HAL_I2C_REGISTER_CALLBACKS == 1
+  HAL_I2C_RegisterCallback(&TS_I2C_HANDLE, HAL_I2C_MEM_RX_COMPLETE_CB_ID, (pI2C_CallbackTypeDef)HAL_I2C_MemRxCpltCallback_Ts);
+  HAL_I2C_RegisterCallback(&TS_I2C_HANDLE, HAL_I2C_MEM_TX_COMPLETE_CB_ID, (pI2C_CallbackTypeDef)HAL_I2C_MemTxCpltCallback_Ts);
+  HAL_I2C_RegisterCallback(&TS_I2C_HANDLE, HAL_I2C_ERROR_CB_ID, (pI2C_CallbackTypeDef)HAL_I2C_ErrorCallback_Ts);
+  #endif
+  #endif
   Delay(2);
 
   HAL_I2C_Mem_Read(&TS_I2C_HANDLE, TS_I2C_ADDRESS, STMPE811_REG_CHP_ID_LSB, I2C_MEMADD_SIZE_8BIT, &idl, 1, TS_I2C_TIMEOUT);
@@ -210,9 +265,155 @@ void stmpe811_ts_Init(uint16_t DeviceAddr)
     stmpe811_inited = 1;
 }
 
+#if STMPE811_INTMODE == 1
+//-----------------------------------------------------------------------------
+/* I2C failure: the INT_STA is not cleared, so the INT pin stays low and there will not be a new falling edge
+   -> the stmpe811_ts_DetectTouch retries the clear */
+static void TsFail(void)
+{
+  ts_state = TS_STATE_IDLE;
+  ts_retry = 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Start the reading (TSC_CTRL .. FIFO_SIZE registers, one auto increment read) */
+static void TsReadStart(void)
+{
+  ts_pending = 0;
+  ts_state = TS_STATE_STATUS;
+  if(HAL_I2C_Mem_Read_DMA(&TS_I2C_HANDLE, TS_I2C_ADDRESS, STMPE811_REG_TSC_CTRL, I2C_MEMADD_SIZE_8BIT, ts_status, sizeof(ts_status)) != HAL_OK)
+    TsFail();
+}
+
+//-----------------------------------------------------------------------------
+/* Clear the interrupt status (the INT pin goes high, the next FIFO threshold or touch pulls it down again) */
+static void TsClearStart(void)
+{
+  static uint8_t clr = 0xFF;
+  ts_retry = 0;
+  ts_state = TS_STATE_CLEAR;
+  if(HAL_I2C_Mem_Write_DMA(&TS_I2C_HANDLE, TS_I2C_ADDRESS, STMPE811_REG_INT_STA, I2C_MEMADD_SIZE_8BIT, &clr, 1) != HAL_OK)
+    TsFail();
+}
+
+//-----------------------------------------------------------------------------
+/* Filtering: average of the last STMPE811_AVERAGE samples of the FIFO content */
+static void TsFifoFilter(uint32_t n)
+{
+  uint32_t i, x = 0, y = 0, c;
+  uint8_t  *p;
+  c = (n < STMPE811_AVERAGE) ? n : STMPE811_AVERAGE;
+  for(i = n - c; i < n; i++)
+  {
+    p = &ts_fifo[i * STMPE811_SAMPLE_SIZE];
+    x += (p[0] << 4) | (p[1] >> 4);
+    y += ((p[1] & 0x0F) << 8) | p[2];
+  }
+  ts_sample = TS_SAMPLE_TOUCH | ((y / c) << 16) | (x / c);
+}
+
+//-----------------------------------------------------------------------------
+/* I2C DMA read end interrupt */
+#if USE_HAL_I2C_REGISTER_CALLBACKS == 0
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+#elif USE_HAL_I2C_REGISTER_CALLBACKS == 1
+static void HAL_I2C_MemRxCpltCallback_Ts(I2C_HandleTypeDef *hi2c)
+#endif
+{
+  uint32_t n;
+  if(hi2c != &TS_I2C_HANDLE)
+    return;
+  if(ts_state == TS_STATE_STATUS)
+  {
+    n = ts_status[STMPE811_REG_FIFO_SIZE - STMPE811_REG_TSC_CTRL];
+    if(n > STMPE811_FIFO_SIZE)
+      n = STMPE811_FIFO_SIZE;
+    if(n)
+    { /* all samples with one transaction (the TSC_DATA non increment register gives the next FIFO byte) */
+      ts_state = TS_STATE_DATA;
+      if(HAL_I2C_Mem_Read_DMA(&TS_I2C_HANDLE, TS_I2C_ADDRESS, STMPE811_REG_TSC_DATA_NON_INC, I2C_MEMADD_SIZE_8BIT, ts_fifo, n * STMPE811_SAMPLE_SIZE) != HAL_OK)
+        TsFail();
+      return;
+    }
+    if(!(ts_status[0] & STMPE811_TS_CTRL_STATUS))
+      ts_sample &= ~TS_SAMPLE_TOUCH;    /* released */
+    TsClearStart();
+  }
+  else if(ts_state == TS_STATE_DATA)
+  {
+    n = ts_status[STMPE811_REG_FIFO_SIZE - STMPE811_REG_TSC_CTRL];
+    if(n > STMPE811_FIFO_SIZE)
+      n = STMPE811_FIFO_SIZE;
+    if(ts_status[0] & STMPE811_TS_CTRL_STATUS)
+      TsFifoFilter(n);
+    else
+      ts_sample &= ~TS_SAMPLE_TOUCH;    /* released (these are the last samples of the touch) */
+    TsClearStart();
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* I2C DMA write end interrupt */
+#if USE_HAL_I2C_REGISTER_CALLBACKS == 0
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+#elif USE_HAL_I2C_REGISTER_CALLBACKS == 1
+static void HAL_I2C_MemTxCpltCallback_Ts(I2C_HandleTypeDef *hi2c)
+#endif
+{
+  if((hi2c != &TS_I2C_HANDLE) || (ts_state != TS_STATE_CLEAR))
+    return;
+  ts_state = TS_STATE_IDLE;
+  if(ts_pending || TsIntActive())
+    TsReadStart();                      /* interrupt during the reading or new FIFO threshold after the clear */
+}
+
+//-----------------------------------------------------------------------------
+/* I2C error interrupt */
+#if USE_HAL_I2C_REGISTER_CALLBACKS == 0
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+#elif USE_HAL_I2C_REGISTER_CALLBACKS == 1
+static void HAL_I2C_ErrorCallback_Ts(I2C_HandleTypeDef *hi2c)
+#endif
+{
+  if((hi2c == &TS_I2C_HANDLE) && (ts_state != TS_STATE_IDLE))
+    TsFail();
+}
+
+//-----------------------------------------------------------------------------
+/* STMPE811 INT pin interrupt (call it from the HAL_GPIO_EXTI_Callback) */
+void stmpe811_ts_IntIrq(void)
+{
+  if(!stmpe811_inited)
+    return;
+  if(ts_state != TS_STATE_IDLE)
+    ts_pending = 1;
+  else
+    TsReadStart();
+}
+#endif /* #if STMPE811_INTMODE == 1 */
+
 //-----------------------------------------------------------------------------
 uint8_t stmpe811_ts_DetectTouch(uint16_t DeviceAddr)
 {
+  #if STMPE811_INTMODE == 1
+  uint32_t s, primask;
+  if(ts_retry)
+  { /* the last I2C transaction failed: clear the INT_STA again (the reading is restarted after the clear if INT is low) */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if(ts_retry && (ts_state == TS_STATE_IDLE))
+      TsClearStart();
+    __set_PRIMASK(primask);
+  }
+  s = ts_sample;                        /* one read: the touch and the position are from the same reading */
+  if(stmpe811_inited && (s & TS_SAMPLE_TOUCH))
+  {
+    tx = s & 0xFFF;
+    ty = (s >> 16) & 0xFFF;
+    return 1;
+  }
+  return 0;
+  #else
   uint8_t state, dt8, ret = 0;
 
   if(!stmpe811_inited)
@@ -234,11 +435,16 @@ uint8_t stmpe811_ts_DetectTouch(uint16_t DeviceAddr)
     HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_STA, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x00", 1, TS_I2C_TIMEOUT);
   }
   return ret;
+  #endif
 }
 
 //-----------------------------------------------------------------------------
 void stmpe811_ts_GetXY(uint16_t DeviceAddr, uint16_t *X, uint16_t *Y)
 {
+  #if STMPE811_INTMODE == 1
+  *X = tx;
+  *Y = ty;
+  #else
   uint8_t  dataXYZ[4];
   uint32_t uldataXYZ;
 
@@ -249,4 +455,5 @@ void stmpe811_ts_GetXY(uint16_t DeviceAddr, uint16_t *X, uint16_t *Y)
 
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_STA, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x01", 1, TS_I2C_TIMEOUT);
   HAL_I2C_Mem_Write(&TS_I2C_HANDLE, TS_I2C_ADDRESS, (uint16_t)STMPE811_REG_FIFO_STA, I2C_MEMADD_SIZE_8BIT, (uint8_t *)"\x00", 1, TS_I2C_TIMEOUT);
+  #endif
 }
@@ -13,6 +13,14 @@
  I2C
  - I2C Speed: Standard Mode
  - All other settings should remain default
+
+ Interrupt mode (STMPE811_INTMODE = 1)
+ - I2C DMA Settings: I2C_RX and I2C_TX DMA request (normal mode, byte data width, memory increment)
+ - NVIC: I2C event, I2C error and the DMA stream interrupts enabled
+ - STMPE811 INT pin: GPIO_EXTI mode with falling edge trigger, pull-up, User Label: TS_INT
+   the HAL_GPIO_EXTI_Callback must call the stmpe811_ts_IntIrq
+   (the INT pin is level triggered: with the TS_INT user label the driver checks the pin level after the interrupt
+   status clear and restarts the reading while it is low; after an I2C error the BSP_TS_GetState retries the clear)
 */
 
 //=============================================================================
@@ -26,3 +34,20 @@
 
 /* I2C device timeout (ms) */
 #define TS_I2C_TIMEOUT        30
+
+/* Interrupt mode
+   - 0: the BSP_TS_GetState reads the touchscreen (blocking, default)
+   - 1: the FIFO threshold and touch interrupts of the STMPE811 (INT pin -> stmpe811_ts_IntIrq) start the reading,
+        all samples of the FIFO are read with one I2C DMA transaction, they are filtered in the DMA completion
+        interrupt, the BSP_TS_GetState returns the last result immediately */
+#define STMPE811_INTMODE      0
+
+/* FIFO threshold in interrupt mode (1..127 samples, the FIFO is read when it has this many samples) */
+#define STMPE811_FIFO_TH      8
+
+/* Number of the last samples averaged from the FIFO content in interrupt mode */
+#define STMPE811_AVERAGE      4
+
+//=============================================================================
+/* Interface section (interrupt mode) */
+void    stmpe811_ts_IntIrq(void);
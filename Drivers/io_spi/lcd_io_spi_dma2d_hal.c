@@ -376,6 +376,7 @@ void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
     { /* dma operations have ended */
       HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
       LcdDmaTransEnd();
+      LCD_IO_DMATXEND();
       LCD_IO_DmaTxCpltCallback(hspi);
     }
   }
@@ -860,6 +861,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   #endif
 
   LcdTransStart();
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
   HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_RESET);
 
   /* Command write */
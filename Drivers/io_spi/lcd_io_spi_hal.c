@@ -5,12 +5,17 @@
 */
 
 //-----------------------------------------------------------------------------
+/* Public function name prefix in multi display mode (LCD_MULTI = 1, see lcd.h and lcd_io.h)
+   note: if you are using multiple SPI displays, copy this file with another name and LCD_IO_NAME */
+#define  LCD_IO_NAME          lcd_io_spi
+
 #include <stdio.h>
 
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
 #include "lcd_io_spi_hal.h"
+#include "lcd_io_rgb12.h"
 
 //-----------------------------------------------------------------------------
 #define  DMA_MINSIZE          0x0010
@@ -152,13 +157,27 @@
 //=============================================================================
 extern  SPI_HandleTypeDef   LCD_SPI_HANDLE;
 
+#if LCD_MULTI == 1 && (LCD_DMA_TX == 1 || LCD_DMA_RX == 1) && USE_HAL_SPI_REGISTER_CALLBACKS == 0
+#error "LCD_MULTI = 1 and DMA mode: please enable the USE_HAL_SPI_REGISTER_CALLBACKS in the cubemx"
+#endif
+
 #if LCD_RGB24_BUFFSIZE < DMA_MINSIZE
 #undef  LCD_RGB24_BUFFSIZE
 #define LCD_RGB24_BUFFSIZE    0
 #else
-uint8_t lcd_rgb24_buffer[LCD_RGB24_BUFFSIZE * 3 + 1];
+static uint8_t lcd_rgb24_buffer[LCD_RGB24_BUFFSIZE * 3 + 1];
 #endif  /* #else LCD_RGB24_DMA_BUFFERSIZE < DMA_MINSIZE */
 
+#if LCD_RGB12_BUFFSIZE < DMA_MINSIZE
+#undef  LCD_RGB12_BUFFSIZE
+#define LCD_RGB12_BUFFSIZE    0
+#elif LCD_RGB12_BUFFSIZE & 1
+#error "LCD_RGB12_BUFFSIZE must be even (two pixels are packed into three bytes)"
+#else
+/* DMA mode: ping-pong buffers */
+static uint8_t lcd_rgb12_buffer[LCD_DMA_TX + 1][LCD_RGB12_BUFFSIZE * 3 / 2];
+#endif  /* #else LCD_RGB12_BUFFSIZE < DMA_MINSIZE */
+
 //-----------------------------------------------------------------------------
 #if LCD_SPI_MODE == 0
 /* Transmit only mode */
@@ -171,7 +190,7 @@ uint8_t lcd_rgb24_buffer[LCD_RGB24_BUFFSIZE * 3 + 1];
 
 //-----------------------------------------------------------------------------
 /* Switch from SPI write mode to SPI read mode, read the dummy bits, modify the SPI speed */
-void LcdDirRead(uint32_t DummySize)
+static void LcdDirRead(uint32_t DummySize)
 {
   uint32_t RxDummy __attribute__((unused));
   __HAL_SPI_DISABLE(&LCD_SPI_HANDLE);   /* stop SPI */
@@ -193,7 +212,7 @@ void LcdDirRead(uint32_t DummySize)
 
 //-----------------------------------------------------------------------------
 /* Switch from SPI read mode to SPI write mode, modify the SPI speed */
-void LcdDirWrite(void)
+static void LcdDirWrite(void)
 {
   __HAL_SPI_DISABLE(&LCD_SPI_HANDLE);                           /* stop SPI */
   #if defined(LCD_SPI_SPD_WRITE) && defined(LCD_SPI_SPD_READ) && (LCD_SPI_SPD_WRITE != LCD_SPI_SPD_READ)
@@ -240,8 +259,9 @@ uint32_t LCD_IO_DmaBusy(void)
 #define DMA_STATUS_8BIT       (1 << 2)
 #define DMA_STATUS_16BIT      (1 << 3)
 #define DMA_STATUS_24BIT      (1 << 4)
+#define DMA_STATUS_12BIT      (1 << 5)
 
-struct
+static struct
 {
   volatile uint32_t status;   /* DMA status (0=free, other: see the DMA_STATUS... macros)  */
   uint32_t size;              /* all transactions data size */
@@ -279,8 +299,8 @@ struct
 #if osCMSIS < 0x20000
 /* DMA on, Freertos 1 mode */
 
-osSemaphoreId LcdSemIdHandle;
-osSemaphoreDef(LcdSemId);
+static osSemaphoreId LcdSemIdHandle;
+static osSemaphoreDef(LcdSemId);
 #define LcdSemNew0            LcdSemIdHandle = osSemaphoreCreate(osSemaphore(LcdSemId), 1); osSemaphoreWait(LcdSemIdHandle, 0)
 #define LcdSemNew1            LcdSemIdHandle = osSemaphoreCreate(osSemaphore(LcdSemId), 1)
 #define LcdSemWait            osSemaphoreWait(LcdSemIdHandle, osWaitForever)
@@ -290,7 +310,7 @@ osSemaphoreDef(LcdSemId);
 #else /* #if osCMSIS < 0x20000 */
 /* DMA on, Freertos 2 mode */
 
-osSemaphoreId_t LcdSemId;
+static osSemaphoreId_t LcdSemId;
 #define LcdSemNew0            LcdSemId = osSemaphoreNew(1, 0, 0)
 #define LcdSemNew1            LcdSemId = osSemaphoreNew(1, 1, 0)
 #define LcdSemWait            osSemaphoreAcquire(LcdSemId, osWaitForever)
@@ -339,7 +359,7 @@ uint32_t LCD_IO_DmaBusy(void)
    - color : 16 bit (RGB565) color
    - tg    : 24 bit (RGB888) color target bitmap pointer
    - Size  : number of pixel */
-void FillConvert16to24(uint16_t color, uint8_t * tg, uint32_t Size)
+static inline void FillConvert16to24(uint16_t color, uint8_t * tg, uint32_t Size)
 {
   uint32_t c24;
   c24 = RGB565TO888(color);
@@ -355,7 +375,7 @@ void FillConvert16to24(uint16_t color, uint8_t * tg, uint32_t Size)
    - src   : 16 bit (RGB565) color source bitmap pointer
    - tg    : 24 bit (RGB888) color target bitmap pointer
    - Size  : number of pixel */
-void BitmapConvert16to24(uint16_t * src, uint8_t * tg, uint32_t Size)
+static inline void BitmapConvert16to24(uint16_t * src, uint8_t * tg, uint32_t Size)
 {
   while(Size--)
   {
@@ -370,7 +390,7 @@ void BitmapConvert16to24(uint16_t * src, uint8_t * tg, uint32_t Size)
    - src   : 24 bit (RGB888) color source bitmap pointer
    - tg    : 16 bit (RGB565) color target bitmap pointer
    - Size  : number of pixel */
-void BitmapConvert24to16(uint8_t * src, uint16_t * tg, uint32_t Size)
+static inline void BitmapConvert24to16(uint8_t * src, uint16_t * tg, uint32_t Size)
 {
   uint32_t c24;
   while(Size--)
@@ -386,6 +406,46 @@ void BitmapConvert24to16(uint8_t * src, uint16_t * tg, uint32_t Size)
 /* TX DMA */
 #if LCD_DMA_TX == 1
 
+#if LCD_RGB12_BUFFSIZE > 0
+static uint8_t  rgb12_act;              /* the buffer of the actual DMA transaction */
+static uint32_t rgb12_next;             /* pixel number in the other buffer (already converted) */
+
+//-----------------------------------------------------------------------------
+/* Convert the next 16bit pixels into the free ping-pong buffer */
+static void Rgb12Prepare(void)
+{
+  uint32_t n = dmastatus.size - dmastatus.trsize;
+  if(n > LCD_RGB12_BUFFSIZE)
+    n = LCD_RGB12_BUFFSIZE;
+  if(n)
+  {
+    BitmapConvert16to12((uint16_t *)dmastatus.ptr, lcd_rgb12_buffer[rgb12_act ^ 1], n);
+    dmastatus.ptr += n << 1;
+  }
+  rgb12_next = n;
+}
+
+//-----------------------------------------------------------------------------
+/* Next 12bit DMA transaction (from the DMA interrupt) */
+static void Rgb12DmaNext(void)
+{
+  dmastatus.size -= dmastatus.trsize;
+  if(dmastatus.status & DMA_STATUS_FILL)
+  { /* the fill pattern is in the first buffer */
+    if(dmastatus.size <= dmastatus.maxtrsize)
+      dmastatus.trsize = dmastatus.size;
+  }
+  else
+  { /* the next pixels are already converted, start them and convert the next pixels during the DMA */
+    rgb12_act ^= 1;
+    dmastatus.trsize = rgb12_next;
+  }
+  HAL_SPI_Transmit_DMA(&LCD_SPI_HANDLE, lcd_rgb12_buffer[rgb12_act], (dmastatus.trsize * 3 + 1) >> 1);
+  if(dmastatus.status & DMA_STATUS_MULTIDATA)
+    Rgb12Prepare();
+}
+#endif /* #if LCD_RGB12_BUFFSIZE > 0 */
+
 //-----------------------------------------------------------------------------
 /* DMA operation end callback function prototype */
 __weak void LCD_IO_DmaTxCpltCallback(SPI_HandleTypeDef *hspi)
@@ -398,7 +458,7 @@ __weak void LCD_IO_DmaTxCpltCallback(SPI_HandleTypeDef *hspi)
 #if USE_HAL_SPI_REGISTER_CALLBACKS == 0
 void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
 #elif USE_HAL_SPI_REGISTER_CALLBACKS == 1
-void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
+static void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
 #endif
 {
   if(hspi == &LCD_SPI_HANDLE)
@@ -406,6 +466,14 @@ void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
     if(dmastatus.size > dmastatus.trsize)
     { /* dma operation is still required */
 
+      #if LCD_RGB12_BUFFSIZE > 0
+      if(dmastatus.status & DMA_STATUS_12BIT)
+      {
+        Rgb12DmaNext();
+        return;
+      }
+      #endif
+
       if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_8BIT))
         dmastatus.ptr += dmastatus.trsize;        /* 8bit multidata */
       else if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_16BIT))
@@ -435,6 +503,7 @@ void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
     { /* dma operations have ended */
       HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
       LcdDmaTransEnd();
+      LCD_IO_DMATXEND();
       LCD_IO_DmaTxCpltCallback(hspi);
     }
   }
@@ -446,7 +515,7 @@ void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
    - pData: 8 or 16 bits data pointer
    - Size: data number
    - Mode: 8 or 16 or 24 bit mode, write or read, fill or multidata (see the LCD_IO_... defines in lcd_io.h file) */
-void LCDWriteFillMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
+static void LCDWriteFillMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
 {
   if(Mode & LCD_IO_DATA8)
     LcdSpiMode8();
@@ -536,7 +605,7 @@ void LCDWriteFillMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
    - pData: RGB 16 bits data pointer
    - Size: data number
    - Mode: 8 or 16 or 24 bit mode, write or read, fill or multidata (see the LCD_IO_... defines in lcd_io.h file) */
-void LCDWriteFillMultiData16to24(uint8_t * pData, uint32_t Size, uint32_t Mode)
+static void LCDWriteFillMultiData16to24(uint8_t * pData, uint32_t Size, uint32_t Mode)
 {
   LcdSpiMode8();
 
@@ -641,6 +710,109 @@ void LCDWriteFillMultiData16to24(uint8_t * pData, uint32_t Size, uint32_t Mode)
   }
 }
 
+//-----------------------------------------------------------------------------
+/* Wrtite fill and multi data to Lcd (convert RGB16 bit (5-6-5) to RGB12 bit (4-4-4) mode, 3 bytes / 2 pixels)
+   - pData: RGB 16 bits data pointer
+   - Size: data number
+   - Mode: 8 or 16 or 24 bit mode, write or read, fill or multidata (see the LCD_IO_... defines in lcd_io.h file) */
+static void LCDWriteFillMultiData16to12(uint8_t * pData, uint32_t Size, uint32_t Mode)
+{
+  LcdSpiMode8();
+
+  #if LCD_DMA_TX == 1 && LCD_RGB12_BUFFSIZE > 0
+  if(Size > DMA_MINSIZE)
+  { /* DMA mode */
+    LCD_SPI_HANDLE.hdmatx->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    LCD_SPI_HANDLE.hdmatx->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    LCD_SPI_HANDLE.hdmatx->Init.MemInc = DMA_MINC_ENABLE;
+    __HAL_DMA_DISABLE(LCD_SPI_HANDLE.hdmatx);
+    HAL_DMA_Init(LCD_SPI_HANDLE.hdmatx);
+
+    dmastatus.maxtrsize = LCD_RGB12_BUFFSIZE;
+    dmastatus.size = Size;
+
+    if(Size > LCD_RGB12_BUFFSIZE)
+      dmastatus.trsize = LCD_RGB12_BUFFSIZE;
+    else
+      dmastatus.trsize = Size;
+
+    rgb12_act = 0;
+    if(Mode & LCD_IO_FILL)
+    { /* fill 16bit to 12bit */
+      dmastatus.status = DMA_STATUS_FILL | DMA_STATUS_12BIT;
+      FillConvert16to12(*(uint16_t *)pData, lcd_rgb12_buffer[0], LCD_RGB12_BUFFSIZE);
+    }
+    else
+    { /* multidata 16bit to 12bit: both buffers are converted before the DMA start */
+      dmastatus.status = DMA_STATUS_MULTIDATA | DMA_STATUS_12BIT;
+      BitmapConvert16to12((uint16_t *)pData, lcd_rgb12_buffer[0], dmastatus.trsize);
+      dmastatus.ptr = (uint32_t)pData + (dmastatus.trsize << 1);
+      Rgb12Prepare();
+    }
+
+    HAL_SPI_Transmit_DMA(&LCD_SPI_HANDLE, lcd_rgb12_buffer[0], (dmastatus.trsize * 3 + 1) >> 1);
+    LcdDmaWaitEnd(Mode & LCD_IO_MULTIDATA);
+  }
+  else
+  #endif
+  { /* not DMA mode */
+    #if LCD_RGB12_BUFFSIZE == 0
+    uint8_t rgb444[3];
+    if(Mode & LCD_IO_FILL)
+    { /* fill 16bit to 12bit */
+      FillConvert16to12(*(uint16_t *)pData, rgb444, 2);
+      while(Size >= 2)
+      {
+        HAL_SPI_Transmit(&LCD_SPI_HANDLE, rgb444, 3, LCD_SPI_TIMEOUT);
+        Size -= 2;
+      }
+      if(Size)
+        HAL_SPI_Transmit(&LCD_SPI_HANDLE, rgb444, 2, LCD_SPI_TIMEOUT);
+    }
+    else
+    { /* multidata 16bit to 12bit */
+      while(Size >= 2)
+      {
+        BitmapConvert16to12((uint16_t *)pData, rgb444, 2);
+        HAL_SPI_Transmit(&LCD_SPI_HANDLE, rgb444, 3, LCD_SPI_TIMEOUT);
+        pData += 4;
+        Size -= 2;
+      }
+      if(Size)
+      {
+        BitmapConvert16to12((uint16_t *)pData, rgb444, 1);
+        HAL_SPI_Transmit(&LCD_SPI_HANDLE, rgb444, 2, LCD_SPI_TIMEOUT);
+      }
+    }
+    #elif LCD_RGB12_BUFFSIZE > 0
+    uint32_t trsize;
+    if(Mode & LCD_IO_FILL)
+      FillConvert16to12(*(uint16_t *)pData, lcd_rgb12_buffer[0], LCD_RGB12_BUFFSIZE);
+    while(Size)
+    {
+      if(Size > LCD_RGB12_BUFFSIZE)
+      {
+        trsize = LCD_RGB12_BUFFSIZE;
+        Size -= LCD_RGB12_BUFFSIZE;
+      }
+      else
+      {
+        trsize = Size;
+        Size = 0;
+      }
+      if(!(Mode & LCD_IO_FILL))
+      { /* bitmap */
+        BitmapConvert16to12((uint16_t *)pData, lcd_rgb12_buffer[0], trsize);
+        pData += trsize << 1;
+      }
+      HAL_SPI_Transmit(&LCD_SPI_HANDLE, lcd_rgb12_buffer[0], (trsize * 3 + 1) >> 1, LCD_SPI_TIMEOUT);
+    }
+    #endif /* #elif LCD_RGB12_BUFFSIZE > 0 */
+    HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
+    LcdTransEnd();
+  }
+}
+
 //=============================================================================
 /* Read */
 
@@ -661,7 +833,7 @@ __weak void LCD_IO_DmaRxCpltCallback(SPI_HandleTypeDef *hspi)
 #if USE_HAL_SPI_REGISTER_CALLBACKS == 0
 void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
 #elif USE_HAL_SPI_REGISTER_CALLBACKS == 1
-void HAL_SPI_RxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
+static void HAL_SPI_RxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
 #endif
 {
   uint32_t dma_status = dmastatus.status;
@@ -711,7 +883,7 @@ void HAL_SPI_RxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
    - pData: 8 or 16 bits data pointer
    - Size: data number
    - Mode: 8 or 16 or 24 bit mode, write or read, fill or multidata (see the LCD_IO_... defines in lcd_io.h file) */
-void LCDReadMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
+static void LCDReadMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
 {
   if(Mode & LCD_IO_DATA8)
     LcdSpiMode8();
@@ -785,7 +957,7 @@ void LCDReadMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
    - pData: 16 bits RGB data pointer
    - Size: pixel number
    - Mode: 8 or 16 or 24 bit mode, write or read, fill or multidata (see the LCD_IO_... defines in lcd_io.h file) */
-void LCDReadMultiData24to16(uint8_t * pData, uint32_t Size, uint32_t Mode)
+static void LCDReadMultiData24to16(uint8_t * pData, uint32_t Size, uint32_t Mode)
 {
   LcdSpiMode8();
   #if LCD_DMA_RX == 1 && LCD_RGB24_BUFFSIZE > 0
@@ -923,6 +1095,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   #endif
 
   LcdTransStart();
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
   HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_RESET);
 
   /* Command write */
@@ -946,6 +1119,8 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   { /* Write Lcd */
     if(Mode & LCD_IO_DATA16TO24)
       LCDWriteFillMultiData16to24(pData, Size, Mode);
+    else if(Mode & LCD_IO_DATA16TO12)
+      LCDWriteFillMultiData16to12(pData, Size, Mode);
     else
       LCDWriteFillMultiData8and16(pData, Size, Mode);
   }
@@ -960,3 +1135,16 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   }
   #endif /* #if LCD_SPI_MODE != 0 */
 }
+
+//-----------------------------------------------------------------------------
+#if LCD_MULTI == 1
+/* Io driver function table (see the LCD_CtxTypeDef in the stm32_adafruit_lcd.h) */
+LCD_IO_DrvTypeDef LCD_IO_DRV =
+{
+  LCD_Delay,
+  LCD_IO_Init,
+  LCD_IO_Bl_OnOff,
+  LCD_IO_Transaction,
+  LCD_IO_DmaBusy
+};
+#endif
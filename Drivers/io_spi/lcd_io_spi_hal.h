@@ -155,4 +155,9 @@ void LCD_IO_DmaRxCpltCallback(SPI_HandleTypeDef *hspi);
    note: if 0 -> does not use DMA for 24-bit drawing and reading */
 #define LCD_RGB24_BUFFSIZE    0
 
+/* Pixel buffer size for the 12-bit (RGB444) drawing (even number, buffer size [byte] = 1.5 * pixel buffer size,
+   in DMA mode there are two buffers: one is sent by the DMA while the next pixels are converted into the other)
+   note: if 0 -> does not use DMA for 12-bit drawing */
+#define LCD_RGB12_BUFFSIZE    0
+
 #endif
@@ -27,6 +27,15 @@
 /* SPI clock pin default state */
 #define  LCDTS_SPI_DEFSTATE   0
 
+/* Arbiter: LCD DMA part size (the touchscreen transaction can be inserted between the parts) */
+#if LCDTS_ARBITER == 1 && LCD_DMA_TX == 1
+#define  DMA_CHUNKSIZE        LCDTS_ARB_CHUNK
+#else
+#undef   LCDTS_ARBITER
+#define  LCDTS_ARBITER        0
+#define  DMA_CHUNKSIZE        DMA_MAXSIZE
+#endif
+
 //-----------------------------------------------------------------------------
 /* Bitdepth convert macros */
 #if LCD_RGB24_ORDER == 0
@@ -394,6 +403,49 @@ __weak void LCD_IO_DmaTxCpltCallback(SPI_HandleTypeDef *hspi)
   UNUSED(hspi);
 }
 
+#if LCDTS_ARBITER == 1
+static volatile uint8_t  arb_req = 0;   /* 1: the touchscreen waits for the bus */
+static volatile uint8_t  arb_paused = 0;/* 1: the LCD DMA operation is paused at a part boundary */
+static uint32_t arb_pausestart;
+static LCDTS_ArbStatTypeDef arb_stat;
+
+//-----------------------------------------------------------------------------
+void LCDTS_IO_GetArbStat(LCDTS_ArbStatTypeDef *pStat)
+{
+  *pStat = arb_stat;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+/* Start the next part of the LCD DMA operation */
+static void LcdDmaNext(void)
+{
+  if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_8BIT))
+    dmastatus.ptr += dmastatus.trsize;        /* 8bit multidata */
+  else if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_16BIT))
+    dmastatus.ptr += dmastatus.trsize << 1; /* 16bit multidata */
+  else if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_24BIT))
+    dmastatus.ptr += dmastatus.trsize << 1; /* 24bit multidata */
+
+  dmastatus.size -= dmastatus.trsize;
+  if(dmastatus.size <= dmastatus.maxtrsize)
+    dmastatus.trsize = dmastatus.size;
+
+  #if LCD_RGB24_BUFFSIZE == 0
+  HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)dmastatus.ptr, dmastatus.trsize);
+  #else
+  if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_24BIT))
+  {
+    BitmapConvert16to24((uint16_t *)dmastatus.ptr, lcd_rgb24_buffer, dmastatus.trsize);
+    HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)lcd_rgb24_buffer, dmastatus.trsize * 3);
+  }
+  else if(dmastatus.status == (DMA_STATUS_FILL | DMA_STATUS_24BIT))
+    HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)lcd_rgb24_buffer, dmastatus.trsize * 3);
+  else
+    HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)dmastatus.ptr, dmastatus.trsize);
+  #endif
+}
+
 //-----------------------------------------------------------------------------
 /* SPI DMA operation interrupt */
 #if USE_HAL_SPI_REGISTER_CALLBACKS == 0
@@ -406,36 +458,23 @@ void HAL_SPI_TxCpltCallback_Lcd(SPI_HandleTypeDef *hspi)
   {
     if(dmastatus.size > dmastatus.trsize)
     { /* dma operation is still required */
-
-      if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_8BIT))
-        dmastatus.ptr += dmastatus.trsize;        /* 8bit multidata */
-      else if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_16BIT))
-        dmastatus.ptr += dmastatus.trsize << 1; /* 16bit multidata */
-      else if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_24BIT))
-        dmastatus.ptr += dmastatus.trsize << 1; /* 24bit multidata */
-
-      dmastatus.size -= dmastatus.trsize;
-      if(dmastatus.size <= dmastatus.maxtrsize)
-        dmastatus.trsize = dmastatus.size;
-
-      #if LCD_RGB24_BUFFSIZE == 0
-      HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)dmastatus.ptr, dmastatus.trsize);
-      #else
-      if(dmastatus.status == (DMA_STATUS_MULTIDATA | DMA_STATUS_24BIT))
-      {
-        BitmapConvert16to24((uint16_t *)dmastatus.ptr, lcd_rgb24_buffer, dmastatus.trsize);
-        HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)lcd_rgb24_buffer, dmastatus.trsize * 3);
+      #if LCDTS_ARBITER == 1
+      if(arb_req)
+      { /* the touchscreen waits: pause (the TS_IO_Transaction continues it) */
+        HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
+        arb_pausestart = LCDTS_ARB_GETTIME();
+        arb_stat.Preempts++;
+        arb_paused = 1;
+        return;
       }
-      else if(dmastatus.status == (DMA_STATUS_FILL | DMA_STATUS_24BIT))
-        HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)lcd_rgb24_buffer, dmastatus.trsize * 3);
-      else
-        HAL_SPI_Transmit_DMA(&LCDTS_SPI_HANDLE, (uint8_t *)dmastatus.ptr, dmastatus.trsize);
       #endif
+      LcdDmaNext();
     }
     else
     { /* dma operations have ended */
       HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_SET);
       LcdDmaTransEnd();
+      LCD_IO_DMATXEND();
       LCD_IO_DmaTxCpltCallback(hspi);
     }
   }
@@ -485,10 +524,10 @@ void LCDWriteFillMultiData8and16(uint8_t * pData, uint32_t Size, uint32_t Mode)
     }
 
     dmastatus.size = Size;
-    dmastatus.maxtrsize = DMA_MAXSIZE;
+    dmastatus.maxtrsize = DMA_CHUNKSIZE;
 
-    if(Size > DMA_MAXSIZE)
-      dmastatus.trsize = DMA_MAXSIZE;
+    if(Size > DMA_CHUNKSIZE)
+      dmastatus.trsize = DMA_CHUNKSIZE;
     else /* the transaction can be performed with one DMA operation */
       dmastatus.trsize = Size;
 
@@ -923,6 +962,7 @@ void LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t Du
   #endif
 
   LcdTransStart();
+  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode);
   HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_RESET);
 
   /* Command write */
@@ -1006,12 +1046,64 @@ void TS_IO_Delay(uint32_t c)
 #pragma GCC pop_options
 #endif
 
+#if LCDTS_ARBITER == 1
+//-----------------------------------------------------------------------------
+/* Get the bus for the touchscreen
+   return: 0 = free bus, 1 = the LCD DMA operation is paused at a part boundary */
+static uint32_t TsArbAcquire(void)
+{
+  uint32_t t = LCDTS_ARB_GETTIME();
+  arb_stat.TsTrans++;
+  arb_req = 1;
+  if(dmastatus.status)
+    arb_stat.TsWaits++;
+  while(dmastatus.status && !arb_paused);
+  arb_req = 0;                          /* after this the DMA interrupt does not pause */
+  if(arb_paused)
+  {
+    arb_stat.WaitTime += LCDTS_ARB_GETTIME() - t;
+    return 1;
+  }
+  LcdTransStart();
+  arb_stat.WaitTime += LCDTS_ARB_GETTIME() - t;
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Give back the bus (continue the paused LCD DMA operation) */
+static void TsArbRelease(uint32_t paused)
+{
+  if(paused)
+  {
+    if(dmastatus.status & DMA_STATUS_16BIT)
+      LcdSpiMode16();
+    HAL_GPIO_WritePin(LCD_CS_GPIO_Port, LCD_CS_Pin, GPIO_PIN_RESET);
+    arb_stat.PauseTime += LCDTS_ARB_GETTIME() - arb_pausestart;
+    arb_paused = 0;
+    LcdDmaNext();
+  }
+  else
+    LcdTransEnd();
+}
+
+#else  /* #if LCDTS_ARBITER == 1 */
+//-----------------------------------------------------------------------------
+void LCDTS_IO_GetArbStat(LCDTS_ArbStatTypeDef *pStat)
+{
+  *pStat = (LCDTS_ArbStatTypeDef){0};
+}
+#endif /* #else LCDTS_ARBITER == 1 */
+
 //-----------------------------------------------------------------------------
 uint16_t TS_IO_Transaction(uint8_t cmd)
 {
   const uint16_t d = 0;
   uint16_t ret;
+  #if LCDTS_ARBITER == 1
+  uint32_t paused = TsArbAcquire();
+  #else
   LcdTransStart();
+  #endif
   LCD_SPI_SETBAUDRATE(LCDTS_SPI_HANDLE, TS_SPI_SPD);           /* speed change */
   LcdSpiMode8();
   HAL_GPIO_WritePin(TS_CS_GPIO_Port, TS_CS_Pin, GPIO_PIN_RESET);
@@ -1023,7 +1115,11 @@ uint16_t TS_IO_Transaction(uint8_t cmd)
   HAL_GPIO_WritePin(TS_CS_GPIO_Port, TS_CS_Pin, GPIO_PIN_SET);
   ret = __REVSH(ret);
   LCD_SPI_SETBAUDRATE(LCDTS_SPI_HANDLE, LCD_SPI_SPD_WRITE);       /* speed change */
+  #if LCDTS_ARBITER == 1
+  TsArbRelease(paused);
+  #else
   LcdTransEnd();
+  #endif
   return ((ret & 0x7FFF) >> 3);
 }
 
@@ -190,4 +190,36 @@ void LCD_IO_DmaRxCpltCallback(SPI_HandleTypeDef *hspi);
 /* This is how many times it tries to read the same value */
 #define TOUCH_MAXREPEAT       8
 
+/* Bus arbiter between the LCD TX DMA and the touchscreen (only LCD_DMA_TX = 1)
+   - 0: the touchscreen reading waits for the end of the LCD DMA operation (e.g. a full screen fill)
+   - 1: the LCD DMA operation is divided into LCDTS_ARB_CHUNK size parts, the touchscreen reading is inserted
+        at the next part boundary (the LCD chip select is inactive meanwhile, the touchscreen SPI speed is set),
+        then the LCD SPI speed and data size are restored and the LCD DMA operation continues
+        note: the display controller must continue the memory write after the chip select pulse
+        (ILI9341, ST7789: yes) */
+#define LCDTS_ARBITER         0
+
+/* Maximum touch latency in arbiter mode: LCD DMA part size (pixel or byte)
+   the maximum wait = LCDTS_ARB_CHUNK * bits per data / SPI clock
+   (e.g. 4096 pixel * 16 bit / 21MHz = 3.1ms, smaller value: less wait, more DMA restart) */
+#define LCDTS_ARB_CHUNK       4096
+
+/* Time source of the arbiter statistics (e.g. HAL_GetTick(): ms, or DWT->CYCCNT: cpu cycle) */
+#define LCDTS_ARB_GETTIME()   HAL_GetTick()
+
+//=============================================================================
+/* Interface section (arbiter mode) */
+
+/* Arbiter statistics (cumulative values) */
+typedef struct
+{
+  uint32_t TsTrans;           /* touchscreen transactions */
+  uint32_t TsWaits;           /* touchscreen transactions that found an LCD DMA operation in progress */
+  uint32_t Preempts;          /* LCD DMA operations paused at a part boundary */
+  uint32_t WaitTime;          /* sum of the touchscreen wait times (LCDTS_ARB_GETTIME unit) */
+  uint32_t PauseTime;         /* sum of the LCD DMA pause times = LCD throughput loss (LCDTS_ARB_GETTIME unit) */
+}LCDTS_ArbStatTypeDef;
+
+void LCDTS_IO_GetArbStat(LCDTS_ArbStatTypeDef *pStat);
+
 #endif /* #ifndef __LCDTS_IO_XPT2046_SPI_HAL_H__ */
@@ -4,6 +4,7 @@
  * v.2023.04
  *
  * - software and hardware SPI
+ * - background mode with SPI DMA (XPT2046_BACKGROUND)
  */
 #include <stdlib.h>
 #include <stdio.h>
@@ -51,6 +52,27 @@
 
 static  uint16_t  tx, ty;
 
+#if XPT2046_BACKGROUND == 1
+#if !defined(TS_SPI_HANDLE) || TS_SPI_HANDLE == -1
+#error "XPT2046_BACKGROUND = 1 only with hardware SPI"
+#endif
+
+/* Conversions in one DMA transaction: X, Y pairs, then Z1, Z2 (the pressure is checked after the position) */
+#define TS_BURST_CONV         (XPT2046_BURST * 2 + 2)
+
+/* DMA transaction is in progress (if it is stuck for TS_BURST_TIMEOUT timer periods -> abort) */
+#define TS_BURST_TIMEOUT      4
+
+/* Last result: the DMA interrupt writes it in one word, so the reader does not need a lock
+   (bit 31: touch, bit 16..27: Y, bit 0..11: X) */
+#define TS_SAMPLE_TOUCH       (1UL << 31)
+
+static uint8_t  ts_txbuf[TS_BURST_CONV * 3];
+static uint8_t  ts_rxbuf[TS_BURST_CONV * 3];
+static volatile uint8_t  ts_busy = 0;
+static volatile uint32_t ts_sample = 0;
+#endif
+
 //=============================================================================
 /* TS chip select pin set */
 void    xpt2046_ts_Init(uint16_t DeviceAddr);
@@ -159,6 +181,118 @@ uint8_t TS_IO_DetectToch(void)
   return ret;
 }
 
+#if XPT2046_BACKGROUND == 1
+//-----------------------------------------------------------------------------
+/* n-th conversion result of the DMA transaction */
+static int32_t TsBurstConv(uint32_t n)
+{
+  return ((((uint16_t)ts_rxbuf[n * 3 + 1] << 8) | ts_rxbuf[n * 3 + 2]) & 0x7FFF) >> 3;
+}
+
+//-----------------------------------------------------------------------------
+/* Start the DMA transaction (if not in progress)
+   the pen and the timer interrupt can both call it: the ts_busy test and set is atomic, so only the caller
+   that started the transaction can release the CS and the ts_busy at the start failure */
+static void TsBurstStart(void)
+{
+  uint32_t primask;
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if(ts_busy)
+  {
+    __set_PRIMASK(primask);
+    return;
+  }
+  ts_busy = 1;
+  __set_PRIMASK(primask);
+  TS_CS_ON;
+  if(HAL_SPI_TransmitReceive_DMA(&TS_SPI_HANDLE, ts_txbuf, ts_rxbuf, sizeof(ts_txbuf)) != HAL_OK)
+  {
+    TS_CS_OFF;
+    ts_busy = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* End of the DMA transaction: filtering and store the result */
+static void TsBurstEnd(void)
+{
+  int32_t  x1, y1, x2, y2, z1, z2;
+  uint32_t i, s = ts_sample & ~TS_SAMPLE_TOUCH;
+  TS_CS_OFF;
+
+  #if defined(TS_IRQ_GPIO_Port) && defined (TS_IRQ_Pin)
+  z1 = 4095; z2 = 0;
+  if(!HAL_GPIO_ReadPin(TS_IRQ_GPIO_Port, TS_IRQ_Pin))
+  #else
+  z1 = TsBurstConv(XPT2046_BURST * 2);
+  z2 = TsBurstConv(XPT2046_BURST * 2 + 1);
+  if((z1 > TS_ZSENS) || (z2 < (4095 - TS_ZSENS)))
+  #endif
+  { /* pressed: two same values after each other */
+    x1 = TsBurstConv(0);
+    y1 = TsBurstConv(1);
+    for(i = 1; i < XPT2046_BURST; i++)
+    {
+      x2 = TsBurstConv(i * 2);
+      y2 = TsBurstConv(i * 2 + 1);
+      if((ABS(x1 - x2) < TOUCH_FILTER) && (ABS(y1 - y2) < TOUCH_FILTER))
+      {
+        s = TS_SAMPLE_TOUCH | (((y1 + y2) >> 1) << 16) | ((x1 + x2) >> 1);
+        break;
+      }
+      x1 = x2;
+      y1 = y2;
+    }
+  }
+  ts_sample = s;
+  ts_busy = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* SPI DMA transaction end interrupt */
+#if USE_HAL_SPI_REGISTER_CALLBACKS == 0
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+#elif USE_HAL_SPI_REGISTER_CALLBACKS == 1
+static void HAL_SPI_TxRxCpltCallback_Ts(SPI_HandleTypeDef *hspi)
+#endif
+{
+  if(hspi == &TS_SPI_HANDLE)
+    TsBurstEnd();
+}
+
+//-----------------------------------------------------------------------------
+/* Periodic measurement (call it from a timer interrupt) */
+void xpt2046_ts_TimerIrq(void)
+{
+  if(ts_busy)
+  { /* the previous transaction is not finished */
+    if(++ts_busy > TS_BURST_TIMEOUT)
+    {
+      HAL_SPI_Abort(&TS_SPI_HANDLE);
+      TS_CS_OFF;
+      ts_busy = 0;
+    }
+    return;
+  }
+  #if defined(TS_IRQ_GPIO_Port) && defined (TS_IRQ_Pin)
+  if(HAL_GPIO_ReadPin(TS_IRQ_GPIO_Port, TS_IRQ_Pin))
+  { /* not pressed: no measurement */
+    ts_sample &= ~TS_SAMPLE_TOUCH;
+    return;
+  }
+  #endif
+  TsBurstStart();
+}
+
+//-----------------------------------------------------------------------------
+/* Touch start (call it from the TS_IRQ pin falling edge interrupt) */
+void xpt2046_ts_PenIrq(void)
+{
+  TsBurstStart();
+}
+#endif /* #if XPT2046_BACKGROUND == 1 */
+
 TS_DrvTypeDef   xpt2046_ts_drv =
 {
   xpt2046_ts_Init,
@@ -182,11 +316,35 @@ void xpt2046_ts_Init(uint16_t DeviceAddr)
   #if TS_SPI_HANDLE != -1 && defined(TS_SPI_SPD) && TS_SPI_SPD >= 0 && TS_SPI_SPD <= 7
   TS_SPI_SETBAUDRATE(TS_SPI_HANDLE, TS_SPI_SPD);
   #endif
+
+  #if XPT2046_BACKGROUND == 1
+  uint32_t i;
+  for(i = 0; i < XPT2046_BURST; i++)
+  {
+    ts_txbuf[i * 6] = XPT2046_CMD_GETX;
+    ts_txbuf[i * 6 + 3] = XPT2046_CMD_GETY;
+  }
+  ts_txbuf[XPT2046_BURST * 6] = XPT2046_CMD_GETZ1;
+  ts_txbuf[XPT2046_BURST * 6 + 3] = XPT2046_CMD_GETZ2;
+  #if USE_HAL_SPI_REGISTER_CALLBACKS == 1
+  HAL_SPI_RegisterCallback(&TS_SPI_HANDLE, HAL_SPI_TX_RX_COMPLETE_CB_ID, (pSPI_CallbackTypeDef)HAL_SPI_TxRxCpltCallback_Ts);
+  #endif
+  #endif
 }
 
 //-----------------------------------------------------------------------------
 uint8_t xpt2046_ts_DetectTouch(uint16_t DeviceAddr)
 {
+  #if XPT2046_BACKGROUND == 1
+  uint32_t s = ts_sample;               /* one read: the touch and the position are from the same measurement */
+  if(s & TS_SAMPLE_TOUCH)
+  {
+    tx = s & 0xFFF;
+    ty = (s >> 16) & 0xFFF;
+    return 1;
+  }
+  return 0;
+  #else
   uint8_t ret = 0;
   int32_t x1, x2, y1, y2, i;
 
@@ -219,6 +377,7 @@ uint8_t xpt2046_ts_DetectTouch(uint16_t DeviceAddr)
     }
   }
   return ret;
+  #endif
 }
 
 //-----------------------------------------------------------------------------
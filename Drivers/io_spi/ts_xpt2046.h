@@ -87,6 +87,12 @@
      - Pull-up/Pull-down: No pull-up and no pull-down
      - Max output speed: n/a
      - User Label: TS_IRQ
+
+ Background mode (XPT2046_BACKGROUND = 1, only hardware SPI)
+   - SPI DMA Settings: SPI_RX and SPI_TX DMA request (normal mode, byte data width, memory increment)
+   - NVIC: SPI global interrupt and the DMA stream interrupts enabled
+   - a timer interrupt (e.g. 10ms) that calls the xpt2046_ts_TimerIrq
+   - Touchscreen IRQ (optional): GPIO_EXTI mode with falling edge trigger, it calls the xpt2046_ts_PenIrq
 */
 
 //=============================================================================
@@ -115,3 +121,21 @@
 
 /* This is how many times it tries to read the same value */
 #define TOUCH_MAXREPEAT       8
+
+/* Background touch acquisition (only hardware SPI with DMA)
+   - 0: the BSP_TS_GetState reads the touchscreen (blocking, default)
+   - 1: the measurements are started from interrupts, the BSP_TS_GetState returns the last result immediately
+        - xpt2046_ts_TimerIrq: it must be called periodically (e.g. 10ms timer, HAL_TIM_PeriodElapsedCallback)
+        - xpt2046_ts_PenIrq: it can be called from the TS_IRQ pin falling edge interrupt (HAL_GPIO_EXTI_Callback),
+          the first measurement starts without waiting for the timer
+        one SPI DMA transaction reads the X, Y pairs and the Z1, Z2 values (3 bytes / conversion), the filtering is
+        in the DMA completion interrupt */
+#define XPT2046_BACKGROUND    0
+
+/* Number of the X, Y pairs in one DMA transaction (background mode, it tries to find two same values in them) */
+#define XPT2046_BURST         4
+
+//=============================================================================
+/* Interface section (background mode) */
+void    xpt2046_ts_TimerIrq(void);
+void    xpt2046_ts_PenIrq(void);
@@ -39,6 +39,13 @@
  * Modify:
    - ReadID return type: uint16_t to uint32_t (there is a display that has a 24-bit ID)
    - Add the LCD_REVERSE16 macro (so that dma can be used on the fsmc 8-bit interface for bitmap drawing)
+   - Add the SetOrientation function (runtime display rotation, 0..3 as the xxx_ORIENTATION setting)
+   - Add the LCD_MULTI setting and the LCD_IO_DrvTypeDef io driver function table (more displays)
+   - Add the LCD_AUTODETECT setting (lcd driver selection from the controller ID, see lcd_probe.h)
+   - Add the InitStep function (non blocking initialization, see lcd_initseq.h)
+   - Add the GetOffscreenLines and SetVisibleY functions (off-screen GRAM rows, e.g. ST7789_GRAM_HEIGHT)
+   - Add the SetWriteBitDepth function (runtime 12/16 bit write mode, e.g. ST7789_WRITEBITDEPTH 12)
+   - Add the LCD_PIXFMT setting (pixel format of the colors and images in the memory, it replaces the LCD_REVERSE16)
  */
 
 /* Define to prevent recursive inclusion -------------------------------------*/
@@ -52,15 +59,37 @@ extern "C" {
 //=============================================================================
 /* Setting section (please set the necessary things in this section) */
 
-/* 16bit/pixel data byte order
-   - 0: no change (default)
-   - 1: change
-   note: Enter a value of 1 only if you use an 8-bit fmsc IO driver and want to use DMA to draw bitmap images.
-         The filling operation is DMA capable even with a value of 0.
-   attention: the byte order should also be in reverse order in memory blocks containing images,
-         because the displayed image will be incorrect. This is necessary because DMA can only write to the
-         fsmc 8-bit peripheral in ascending byte order, but the LCD display requires reverse pixel byte order. */
-#define  LCD_REVERSE16     0
+/* Pixel format of the 16bit/pixel colors and images in the memory
+   - LCD_PIXFMT_RGB565    : RGB565, uint16_t in the byte order of the processor (default)
+   - LCD_PIXFMT_RGB565_BE : RGB565, reverse byte order (high byte first in the memory)
+   - LCD_PIXFMT_BGR565    : BGR565 (red and blue exchanged, for BGR panels if the lcd driver has no COLORMODE setting)
+   - LCD_PIXFMT_BGR565_BE : BGR565, reverse byte order
+   note: Use the _BE formats only if you use an 8-bit fmsc IO driver and want to use DMA to draw bitmap images.
+         The filling operation is DMA capable even with the default format.
+         This is necessary because DMA can only write to the fsmc 8-bit peripheral in ascending byte order,
+         but the LCD display requires reverse pixel byte order.
+   note: the io drivers send the images without conversion (the DMA gets the memory block directly), so the color
+         constants and the images must be in this format: the LCD_COLOR and LCD_COLOR16 macros (stm32_adafruit_lcd.h)
+         convert the color constants, the Tools/LcdAssetConv host program converts the images
+   note: the 18 and 24 bit display interfaces (e.g. ILI9488_WRITEBITDEPTH 24) and the 12 bit write mode are
+         converted from this format in the io driver (LCD_IO_DATA16TO24, LCD_IO_DATA16TO12) */
+#define  LCD_PIXFMT        LCD_PIXFMT_RGB565
+
+/* Multiple displays (see LCD_CtxTypeDef and BSP_LCD_SetContext in the stm32_adafruit_lcd.h)
+   - 0: one display (default)
+   - 1: more displays, every display has an own lcd driver and io driver
+   note: the displays must have different lcd driver types (e.g. ili9341 and st7735), because the state of the
+         lcd drivers is static. The io drivers are called through the LCD_IO_DrvTypeDef table of the actual display
+         (see LCD_IO_NAME in the lcd_io.h, now the io_spi/lcd_io_spi_hal and io_host/lcd_io_host drivers support it).
+         If more displays are connected to the same type of io driver (e.g. two SPI buses), the io driver
+         source and header must be copied with a different file name and LCD_IO_NAME (and the other settings). */
+#define  LCD_MULTI         0
+
+/* Display controller auto detection (see lcd_probe.h)
+   - 0: one lcd driver is in the project, it sets the lcd_drv pointer (default)
+   - 1: more lcd drivers are in the project, the BSP_LCD_Init selects one of them from the controller ID
+   note: only with LCD_MULTI = 0 */
+#define  LCD_AUTODETECT    0
 
 //=============================================================================
 /* Interface section */
@@ -68,6 +97,27 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
 
+/* Pixel formats (LCD_PIXFMT) */
+#define  LCD_PIXFMT_RGB565      0
+#define  LCD_PIXFMT_RGB565_BE   1
+#define  LCD_PIXFMT_BGR565      2
+#define  LCD_PIXFMT_BGR565_BE   3
+
+/* 16bit/pixel data byte order for the lcd and io drivers (0: no change, 1: change) */
+#define  LCD_REVERSE16     (LCD_PIXFMT & 1)
+
+/* RGB565 color code -> LCD_PIXFMT color code */
+#if (LCD_PIXFMT & 2) == 0
+#define  LCD_PIXFMT_RB(c)       (c)
+#else
+#define  LCD_PIXFMT_RB(c)       ((((c) & 0xF800) >> 11) | ((c) & 0x07E0) | (((c) & 0x001F) << 11))
+#endif
+#if (LCD_PIXFMT & 1) == 0
+#define  LCD_PIXFMT16(c)        LCD_PIXFMT_RB(c)
+#else
+#define  LCD_PIXFMT16(c)        (((LCD_PIXFMT_RB(c) & 0xFF) << 8) | ((LCD_PIXFMT_RB(c) & 0xFF00) >> 8))
+#endif
+
 typedef struct
 {
   void     (*Init)(void);
@@ -90,8 +140,32 @@ typedef struct
   void     (*ReadRGBImage)(uint16_t, uint16_t, uint16_t, uint16_t, uint16_t*);
   void     (*Scroll)(int16_t, uint16_t, uint16_t);
   void     (*UserCommand)(uint16_t, uint8_t*, uint32_t, uint8_t);
+  void     (*SetOrientation)(uint8_t);
+  uint32_t (*InitStep)(void);
+  uint16_t (*GetOffscreenLines)(void);
+  void     (*SetVisibleY)(uint16_t);
+  uint8_t  (*SetWriteBitDepth)(uint8_t);
 }LCD_DrvTypeDef;    
 
+/* Io driver function table (only LCD_MULTI = 1, the io drivers export it with the LCD_IO_NAME##_drv name) */
+typedef struct
+{
+  void     (*Delay)(uint32_t);
+  void     (*Init)(void);
+  void     (*Bl_OnOff)(uint8_t);
+  void     (*Transaction)(uint16_t, uint8_t *, uint32_t, uint32_t, uint32_t);
+  uint32_t (*DmaBusy)(void);
+}LCD_IO_DrvTypeDef;
+
+/* LCD_AUTODETECT = 1: the LCD_Probe initializes the io driver before the ID read (lcd_io_probed = 1),
+   then the lcd driver Init does not initialize it again (no second reset, DMA and semaphore init) */
+#if LCD_AUTODETECT == 1
+extern uint8_t lcd_io_probed;
+#define  LCD_IO_PROBED     lcd_io_probed
+#else
+#define  LCD_IO_PROBED     0
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,7 @@
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
+#include "lcd_initseq.h"
 #include "hx8347g.h"
 
 void     hx8347g_Init(void);
@@ -21,6 +22,8 @@ void     hx8347g_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint
 void     hx8347g_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
 void     hx8347g_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void     hx8347g_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     hx8347g_SetOrientation(uint8_t Orientation);
+uint32_t hx8347g_InitStep(void);
 
 
 LCD_DrvTypeDef   hx8347g_drv =
@@ -42,11 +45,17 @@ LCD_DrvTypeDef   hx8347g_drv =
   hx8347g_FillRect,
   hx8347g_ReadRGBImage,
   hx8347g_Scroll,
-  hx8347g_UserCommand
-
+  hx8347g_UserCommand,
+  hx8347g_SetOrientation,
+  hx8347g_InitStep,
+  NULL,
+  NULL,
+  NULL
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &hx8347g_drv;
+#endif
 
 #define HX8347G_ID_AD              0x00
 #define HX8347G_MODE_CTRL          0x01
@@ -188,27 +197,26 @@ LCD_DrvTypeDef  *lcd_drv = &hx8347g_drv;
 #define HX8347G_ENTRY_COLORMODE    HX8347G_ENTRY_BGR
 #endif
 
-#if (HX8347G_ORIENTATION == 0)
-#define HX8347G_MAX_X                        (HX8347G_LCD_PIXEL_WIDTH - 1)
-#define HX8347G_MAX_Y                        (HX8347G_LCD_PIXEL_HEIGHT - 1)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN   (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_DOWN)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_UP     (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_UP)
-#elif (HX8347G_ORIENTATION == 1)
-#define HX8347G_MAX_X                        (HX8347G_LCD_PIXEL_HEIGHT - 1)
-#define HX8347G_MAX_Y                        (HX8347G_LCD_PIXEL_WIDTH - 1)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN   (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_DOWN | HX8347G_ENTRY_VERTICAL)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_UP     (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_DOWN | HX8347G_ENTRY_VERTICAL)
-#elif (HX8347G_ORIENTATION == 2)
-#define HX8347G_MAX_X                        (HX8347G_LCD_PIXEL_WIDTH - 1)
-#define HX8347G_MAX_Y                        (HX8347G_LCD_PIXEL_HEIGHT - 1)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN   (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_UP)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_UP     (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_DOWN)
-#elif (HX8347G_ORIENTATION == 3)
-#define HX8347G_MAX_X                        (HX8347G_LCD_PIXEL_HEIGHT - 1)
-#define HX8347G_MAX_Y                        (HX8347G_LCD_PIXEL_WIDTH - 1)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN   (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_UP   | HX8347G_ENTRY_VERTICAL)
-#define HX8347G_ENTRY_DATA_RIGHT_THEN_UP     (HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_UP   | HX8347G_ENTRY_VERTICAL)
-#endif
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint8_t  RightThenUp;                 /* MADCTL for right then up draw direction (bitmap) */
+  uint8_t  RightThenDown;               /* MADCTL for right then down draw direction */
+  uint8_t  ScrollTop;                   /* VSCRDEF top fix area parameter index (1 or 3) */
+  int8_t   ScrollDir;                   /* scroll direction */
+}hx8347g_OrientTypeDef;
+
+static const hx8347g_OrientTypeDef OrientTab[4] =
+{
+  {HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_UP,
+   HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_DOWN, 1, -1},
+  {HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_DOWN | HX8347G_ENTRY_VERTICAL,
+   HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_DOWN | HX8347G_ENTRY_VERTICAL, 1, -1},
+  {HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_DOWN,
+   HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_UP, 3, 1},
+  {HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_LEFT  | HX8347G_ENTRY_Y_UP   | HX8347G_ENTRY_VERTICAL,
+   HX8347G_ENTRY_COLORMODE | HX8347G_ENTRY_X_RIGHT | HX8347G_ENTRY_Y_UP   | HX8347G_ENTRY_VERTICAL, 3, 1}
+};
 
 #define HX8347G_SETCURSOR(x, y)              {hx8347g_WriteRegPair(HX8347G_HOR_START_AD, x); \
                                               hx8347g_WriteRegPair(HX8347G_HOR_END_AD, x);   \
@@ -223,11 +231,16 @@ LCD_DrvTypeDef  *lcd_drv = &hx8347g_drv;
 #define HX8347G_IO_INITIALIZED     0x02
 static  uint8_t   Is_hx8347g_Initialized = 0;
 
-const uint8_t EntryRightThenUp = HX8347G_ENTRY_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+/* actual orientation (see HX8347G_ORIENTATION, it can be changed with hx8347g_SetOrientation) */
+static  const hx8347g_OrientTypeDef * Orient = &OrientTab[HX8347G_ORIENTATION];
+static  uint16_t  SizeX = (HX8347G_ORIENTATION & 1) ? HX8347G_LCD_PIXEL_HEIGHT : HX8347G_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (HX8347G_ORIENTATION & 1) ? HX8347G_LCD_PIXEL_WIDTH : HX8347G_LCD_PIXEL_HEIGHT;
+
+static uint8_t EntryRightThenUp = 0;
+static uint8_t EntryRightThenDown = 0;
 
 /* the last set drawing direction is stored here */
-uint16_t LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+static uint16_t LastEntry = 0;
 
 static  uint16_t  yStart, yEnd;
 
@@ -266,65 +279,102 @@ void hx8347g_WriteRegPair(uint8_t CmdPair, uint16_t Data)
 }
 
 //-----------------------------------------------------------------------------
-void hx8347g_Init(void)
+/* Init sequence (see lcd_initseq.h) */
+#define INITFUNC_ORIENT       0
+
+static const uint8_t hx8347g_InitSeq[] =
+{
+  0xF3, 1, 0x08,
+
+  LCD_INITSEQ_WAIT(5),
+
+  HX8347G_CYCLE_CTRL2, 1, 0x89,
+  HX8347G_FRAMERATE_CTRL1, 1, 0x8F,
+  HX8347G_FRAMERATE_CTRL3, 1, 0x02,
+  0xE2, 1, 0x00,
+  HX8347G_PWR_SAVING1, 1, 0x01,
+  HX8347G_PWR_SAVING2, 1, 0x10,
+  HX8347G_PWR_SAVING3, 1, 0x01,
+  HX8347G_PWR_SAVING4, 1, 0x10,
+  HX8347G_SRC_OP_CTRL_NORM, 1, 0x70,
+  0xF2, 1, 0x00,
+
+  HX8347G_PWR_CTRL_INT, 1, 0x00, HX8347G_PWR_CTRL_INT + 1, 1, 0x20,
+  HX8347G_SRC_CTRL_INT, 1, 0x3C, HX8347G_SRC_CTRL_INT + 1, 1, 0xC8,
+  HX8347G_SRC_OP_CTRL_IDLE, 1, 0x38,
+  0xF1, 1, 0x01,
+
+  // skip gamma, do later
+  HX8347G_PWR_CTRL2, 1, 0x1A,
+  HX8347G_PWR_CTRL1, 1, 0x02,
+  HX8347G_VCOM_CTRL2, 1, 0x61,
+  HX8347G_VCOM_CTRL3, 1, 0x5C,
+
+  HX8347G_OSC_CTRL2, 1, 0x36,
+  HX8347G_OSC_CTRL2, 1, 0x01,
+  HX8347G_PWR_CTRL6, LCD_INITSEQ_DELAY | 1, 0x88, 5,
+  HX8347G_PWR_CTRL6, LCD_INITSEQ_DELAY | 1, 0x80, 5,
+  HX8347G_PWR_CTRL6, LCD_INITSEQ_DELAY | 1, 0x90, 5,
+  HX8347G_PWR_CTRL6, LCD_INITSEQ_DELAY | 1, 0xD4, 5,
+  #if HX8347G_WRITEBITDEPTH == 16
+  HX8347G_COLMOD, 1, 0x55,  // 16bit/pixel
+  #elif HX8347G_WRITEBITDEPTH == 24
+  HX8347G_COLMOD, 1, 0x66,  // 16bit/pixel
+  #endif
+
+  HX8347G_PANEL_CHAR, 1, 0x09,
+  HX8347G_DISP_CTRL3, LCD_INITSEQ_DELAY | 1, 0x38, 40,
+  HX8347G_DISP_CTRL3, 1, 0x3C,
+
+  LCD_INITSEQ_CALL(INITFUNC_ORIENT),     // ENTRY_MOD
+  HX8347G_MODE_CTRL, 1, 0x08,
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void hx8347g_InitFunc(uint8_t Func)
+{
+  if(Func == INITFUNC_ORIENT)
+  {
+    EntryRightThenUp = Orient->RightThenUp;
+    EntryRightThenDown = Orient->RightThenDown;
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
+  }
+}
+
+static void hx8347g_InitStart(void)
 {
   if((Is_hx8347g_Initialized & HX8347G_LCD_INITIALIZED) == 0)
   {
     Is_hx8347g_Initialized |= HX8347G_LCD_INITIALIZED;
-    if((Is_hx8347g_Initialized & HX8347G_IO_INITIALIZED) == 0)
+    if((Is_hx8347g_Initialized & HX8347G_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
       LCD_IO_Init();
     Is_hx8347g_Initialized |= HX8347G_IO_INITIALIZED;
+    LCD_InitSeqStart(&InitSeq, hx8347g_InitSeq, hx8347g_InitFunc, LCD_INITSEQ_CMD8);
+  }
+}
 
-    LCD_IO_WriteCmd8MultipleData8(0xF3, "\x08", 1);
-
-    LCD_Delay(5);
-
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_CYCLE_CTRL2, "\x89", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_FRAMERATE_CTRL1, "\x8F", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_FRAMERATE_CTRL3, "\x02", 1);
-    LCD_IO_WriteCmd8MultipleData8(0xE2, "\x00", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_SAVING1, "\x01", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_SAVING2, "\x10", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_SAVING3, "\x01", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_SAVING4, "\x10", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_SRC_OP_CTRL_NORM, "\x70", 1);
-    LCD_IO_WriteCmd8MultipleData8(0xF2, "\x00", 1);
-
-    hx8347g_WriteRegPair(HX8347G_PWR_CTRL_INT, 0x0020);
-    hx8347g_WriteRegPair(HX8347G_SRC_CTRL_INT, 0x3CC8);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_SRC_OP_CTRL_IDLE, "\x38", 1);
-    LCD_IO_WriteCmd8MultipleData8(0xF1, "\x01", 1);
-
-    // skip gamma, do later
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_CTRL2, "\x1A", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_CTRL1, "\x02", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_VCOM_CTRL2, "\x61", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_VCOM_CTRL3, "\x5C", 1);
-
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_OSC_CTRL2, "\x36", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_OSC_CTRL2, "\x01", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_CTRL6, "\x88", 1);
-    LCD_Delay(5);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_CTRL6, "\x80", 1);
-    LCD_Delay(5);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_CTRL6, "\x90", 1);
-    LCD_Delay(5);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PWR_CTRL6, "\xD4", 1);
-    LCD_Delay(5);
-    #if HX8347G_WRITEBITDEPTH == 16
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_COLMOD, "\x55", 1); // 16bit/pixel
-    #elif HX8347G_WRITEBITDEPTH == 24
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_COLMOD, "\x66", 1); // 16bit/pixel
-    #endif
-
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_PANEL_CHAR, "\x09", 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_DISP_CTRL3, "\x38", 1);
-    LCD_Delay(40);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_DISP_CTRL3, "\x3C", 1);
+//-----------------------------------------------------------------------------
+void hx8347g_Init(void)
+{
+  hx8347g_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
 
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
-    LCD_IO_WriteCmd8MultipleData8(HX8347G_MODE_CTRL, "\x08", 1);
-  }
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t hx8347g_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    hx8347g_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -355,7 +405,7 @@ void hx8347g_DisplayOff(void)
   */
 uint16_t hx8347g_GetLcdPixelWidth(void)
 {
-  return HX8347G_MAX_X + 1;
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -366,7 +416,7 @@ uint16_t hx8347g_GetLcdPixelWidth(void)
   */
 uint16_t hx8347g_GetLcdPixelHeight(void)
 {
-  return HX8347G_MAX_Y + 1;
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -378,7 +428,7 @@ uint16_t hx8347g_GetLcdPixelHeight(void)
 uint32_t hx8347g_ReadID(void)
 {
   uint32_t ret = 0;
-  if((Is_hx8347g_Initialized & HX8347G_IO_INITIALIZED) == 0)
+  if((Is_hx8347g_Initialized & HX8347G_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
   {
     LCD_IO_Init();
   }
@@ -408,9 +458,9 @@ void hx8347g_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void hx8347g_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   HX8347G_SETCURSOR(Xpos, Ypos);
@@ -426,9 +476,9 @@ void hx8347g_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t hx8347g_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   HX8347G_SETCURSOR(Xpos, Ypos);
@@ -465,9 +515,9 @@ void hx8347g_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
   */
 void hx8347g_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   hx8347g_WriteRegPair(HX8347G_HOR_START_AD, Xpos);
@@ -488,9 +538,9 @@ void hx8347g_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void hx8347g_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   hx8347g_WriteRegPair(HX8347G_HOR_START_AD, Xpos);
@@ -512,9 +562,9 @@ void hx8347g_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void hx8347g_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   hx8347g_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -543,13 +593,13 @@ void hx8347g_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index)/2;
   pbmp += index;
 
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenUp, 1);
   }
-  hx8347g_WriteRegPair(HX8347G_VER_START_AD, HX8347G_MAX_Y - yEnd);
-  hx8347g_WriteRegPair(HX8347G_VER_END_AD, HX8347G_MAX_Y - yStart);
+  hx8347g_WriteRegPair(HX8347G_VER_START_AD, SizeY - 1 - yEnd);
+  hx8347g_WriteRegPair(HX8347G_VER_END_AD, SizeY - 1 - yStart);
   LCD_IO_DrawBitmap((uint16_t *)pbmp, size);
 }
 
@@ -566,9 +616,9 @@ void hx8347g_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void hx8347g_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pdata)
 {
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   hx8347g_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -588,9 +638,9 @@ void hx8347g_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void hx8347g_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pdata)
 {
-  if(LastEntry != HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = HX8347G_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   hx8347g_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -608,67 +658,21 @@ void hx8347g_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
 void hx8347g_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
   static uint16_t scrparam[4] = {0, 0, 0, 0};
-  #if (HX8347G_ORIENTATION == 0)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
+  uint8_t top = Orient->ScrollTop;      /* the top fix area can be the physical bottom */
+  if((TopFix != scrparam[top]) || (BottonFix != scrparam[4 - top]) || (scrparam[2] == 0))
   {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
+    scrparam[top] = TopFix;
+    scrparam[4 - top] = BottonFix;
     scrparam[2] = HX8347G_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
     hx8347g_WriteRegPair(HX8347G_VER_SCR_TOP, scrparam[1]);
     hx8347g_WriteRegPair(HX8347G_VER_SCR_HEIGHT, scrparam[2]);
     hx8347g_WriteRegPair(HX8347G_VER_SCR_BTN, scrparam[3]);
   }
-  Scroll = (0 - Scroll) % scrparam[2];
+  Scroll = (Scroll * Orient->ScrollDir) % scrparam[2];
   if(Scroll < 0)
     Scroll = scrparam[2] + Scroll + scrparam[1];
   else
     Scroll = Scroll + scrparam[1];
-  #elif (HX8347G_ORIENTATION == 1)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
-  {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
-    scrparam[2] = HX8347G_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_TOP, scrparam[1]);
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_HEIGHT, scrparam[2]);
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_BTN, scrparam[3]);
-  }
-  Scroll = (0 - Scroll) % scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (HX8347G_ORIENTATION == 2)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = HX8347G_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_TOP, scrparam[1]);
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_HEIGHT, scrparam[2]);
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_BTN, scrparam[3]);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (HX8347G_ORIENTATION == 3)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = HX8347G_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_TOP, scrparam[1]);
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_HEIGHT, scrparam[2]);
-    hx8347g_WriteRegPair(HX8347G_VER_SCR_BTN, scrparam[3]);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #endif
   if(Scroll != scrparam[0])
   {
     scrparam[0] = Scroll;
@@ -696,3 +700,25 @@ void hx8347g_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_
   else if(Mode == 3)
     LCD_IO_ReadCmd8MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see HX8347G_ORIENTATION)
+  * @retval None
+  */
+void hx8347g_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? HX8347G_LCD_PIXEL_HEIGHT : HX8347G_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? HX8347G_LCD_PIXEL_WIDTH : HX8347G_LCD_PIXEL_HEIGHT;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  if(Is_hx8347g_Initialized & HX8347G_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(HX8347G_ENTRY_MOD, &EntryRightThenDown, 1);
+  }
+}
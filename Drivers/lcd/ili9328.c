@@ -1,6 +1,7 @@
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
+#include "lcd_initseq.h"
 #include "ili9328.h"
 
 void     ili9328_Init(void);
@@ -21,6 +22,8 @@ void     ili9328_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint
 void     ili9328_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
 void     ili9328_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void     ili9328_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     ili9328_SetOrientation(uint8_t Orientation);
+uint32_t ili9328_InitStep(void);
 
 LCD_DrvTypeDef   ili9328_drv =
 {
@@ -41,13 +44,20 @@ LCD_DrvTypeDef   ili9328_drv =
   ili9328_FillRect,
   ili9328_ReadRGBImage,
   ili9328_Scroll,
-  ili9328_UserCommand
+  ili9328_UserCommand,
+  ili9328_SetOrientation,
+  ili9328_InitStep,
+  NULL,
+  NULL,
+  NULL
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &ili9328_drv;
+#endif
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -123,47 +133,41 @@ union
 #define ILI9328_ENTRY_COLORMODE    ILI9328_ENTRY_BGR
 #endif
 
-#if ILI9328_ORIENTATION == 0
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_UP     (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_UP)
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN)
-#define ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL)
-#define ILI9328_DRIV_OUT_CTRL_DATA           0x0100
-#define ILI9328_GATE_SCAN_CTRL1_DATA         0xA700
-#define ILI9328_SETCURSOR(x, y)              {transdata.d16[0] = x;\
-                                              LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_HOR_AD, &transdata, 1);\
-                                              transdata.d16[0] = y;\
-                                              LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_VER_AD, &transdata, 1);}
-#elif ILI9328_ORIENTATION == 1
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_UP     (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_LEFT  | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL)
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL)
-#define ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN)
-#define ILI9328_DRIV_OUT_CTRL_DATA           0x0000
-#define ILI9328_GATE_SCAN_CTRL1_DATA         0xA700
-#define ILI9328_SETCURSOR(x, y)              {transdata.d16[0] = y;\
-                                              LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_HOR_AD, &transdata, 1);\
-                                              transdata.d16[0] = x;\
-                                              LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_VER_AD, &transdata, 1);}
-#elif ILI9328_ORIENTATION == 2
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_UP     (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_UP)
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN)
-#define ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL)
-#define ILI9328_DRIV_OUT_CTRL_DATA           0x0000
-#define ILI9328_GATE_SCAN_CTRL1_DATA         0x2700
-#define ILI9328_SETCURSOR(x, y)              {transdata.d16[0] = x;\
-                                              LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_HOR_AD, &transdata, 1);\
-                                              transdata.d16[0] = y;\
-                                              LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_VER_AD, &transdata, 1);}
-#elif ILI9328_ORIENTATION == 3
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_UP     (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_LEFT  | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL)
-#define ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL)
-#define ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT   (ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN)
-#define ILI9328_DRIV_OUT_CTRL_DATA           0x0100
-#define ILI9328_GATE_SCAN_CTRL1_DATA         0x2700
-#define ILI9328_SETCURSOR(x, y)              {transdata.d16[0] = y;\
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint16_t RightThenUp;                 /* entry mode for right then up draw direction (bitmap) */
+  uint16_t RightThenDown;               /* entry mode for right then down draw direction */
+  uint16_t DownThenRight;               /* entry mode for down then right draw direction (vertical line) */
+  uint16_t DrivOutCtrl;                 /* driver output control (source scan direction) */
+  uint16_t GateScanCtrl1;               /* gate scan control (gate scan direction) */
+  uint8_t  SwapXY;                      /* 1: the x coordinate is the GRAM vertical address */
+}ili9328_OrientTypeDef;
+
+static const ili9328_OrientTypeDef OrientTab[4] =
+{
+  {ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_UP,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL,
+   0x0100, 0xA700, 0},
+  {ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_LEFT  | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN,
+   0x0000, 0xA700, 1},
+  {ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_UP,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL,
+   0x0000, 0x2700, 0},
+  {ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_LEFT  | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN | ILI9328_ENTRY_VERTICAL,
+   ILI9328_ENTRY_COLORMODE | ILI9328_ENTRY_X_RIGHT | ILI9328_ENTRY_Y_DOWN,
+   0x0100, 0x2700, 1}
+};
+
+#define ILI9328_SETCURSOR(x, y)              {transdata.d16[0] = Orient->SwapXY ? y : x;\
                                               LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_HOR_AD, &transdata, 1);\
-                                              transdata.d16[0] = x;\
+                                              transdata.d16[0] = Orient->SwapXY ? x : y;\
                                               LCD_IO_WriteCmd16MultipleData16(ILI9328_GRAM_VER_AD, &transdata, 1);}
-#endif
 
 #ifndef LCD_REVERSE16
 #define LCD_REVERSE16    0
@@ -187,16 +191,21 @@ union
 #define ILI9328_IO_INITIALIZED     0x02
 static  uint8_t   Is_ili9328_Initialized = 0;
 
-const uint16_t DrivOutCtrlData = ILI9328_DRIV_OUT_CTRL_DATA;
-const uint16_t EntryRightThenUp = ILI9328_ENTRY_DATA_RIGHT_THEN_UP;
-const uint16_t EntryRightThenDown = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
-const uint16_t EntryDownThenRight = ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT;
-const uint16_t LcdPixelWidth = ILI9328_LCD_PIXEL_WIDTH - 1;
-const uint16_t LcdPixelHeight = ILI9328_LCD_PIXEL_HEIGHT - 1;
-const uint16_t GateScanCtrl1Data = ILI9328_GATE_SCAN_CTRL1_DATA;
+/* actual orientation (see ILI9328_ORIENTATION, it can be changed with ili9328_SetOrientation) */
+static  const ili9328_OrientTypeDef * Orient = &OrientTab[ILI9328_ORIENTATION];
+static  uint16_t  SizeX = (ILI9328_ORIENTATION & 1) ? ILI9328_LCD_PIXEL_HEIGHT : ILI9328_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ILI9328_ORIENTATION & 1) ? ILI9328_LCD_PIXEL_WIDTH : ILI9328_LCD_PIXEL_HEIGHT;
+
+static uint16_t DrivOutCtrlData = 0;
+static uint16_t EntryRightThenUp = 0;
+static uint16_t EntryRightThenDown = 0;
+static uint16_t EntryDownThenRight = 0;
+static const uint16_t LcdPixelWidth = ILI9328_LCD_PIXEL_WIDTH - 1;
+static const uint16_t LcdPixelHeight = ILI9328_LCD_PIXEL_HEIGHT - 1;
+static uint16_t GateScanCtrl1Data = 0;
 
 /* the last set drawing direction is stored here */
-uint16_t LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
+static uint16_t LastEntry = 0;
 
 //-----------------------------------------------------------------------------
 /* Pixel draw and read functions */
@@ -215,73 +224,130 @@ uint16_t LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
   LCD_IO_ReadCmd16MultipleData16(ILI9328_RW_GRAM, pData, Size, 2)
 
 //-----------------------------------------------------------------------------
-/* Init the Display and init the IO */
-void ili9328_Init(void)
+/* Init sequence (see lcd_initseq.h, the LCD_INITSEQ_CALL parameter is the register) */
+static const uint8_t ili9328_InitSeq[] =
+{
+  LCD_INITSEQ_WAIT(5),
+
+  LCD_INITSEQ_CALL(ILI9328_DRIV_OUT_CTRL),
+  ILI9328_DRIV_WAV_CTRL, 2, 0x07, 0x00,
+  LCD_INITSEQ_CALL(ILI9328_ENTRY_MOD),
+  ILI9328_DISP_CTRL2, 2, 0x03, 0x02,
+  ILI9328_DISP_CTRL3, 2, 0x00, 0x00,
+
+  /*POWER CONTROL REGISTER INITIAL*/
+  ILI9328_POW_CTRL1, 2, 0x00, 0x00,
+  ILI9328_POW_CTRL2, 2, 0x00, 0x07,
+  ILI9328_POW_CTRL3, 2, 0x00, 0x00,
+  ILI9328_POW_CTRL4, 2, 0x00, 0x00,
+
+  LCD_INITSEQ_WAIT(5),
+  /*POWER SUPPPLY STARTUP 1 SETTING*/
+  ILI9328_POW_CTRL1, 2, 0x14, 0xB0,
+
+  LCD_INITSEQ_WAIT(5),
+  ILI9328_POW_CTRL2, LCD_INITSEQ_DELAY | 2, 0x00, 0x07, 5,
+
+  /*POWER SUPPLY STARTUP 2 SETTING*/
+  ILI9328_POW_CTRL3, 2, 0x00, 0x8E,
+  ILI9328_POW_CTRL4, 2, 0x0C, 0x00,
+  ILI9328_POW_CTRL7, 2, 0x00, 0x15,
+
+  LCD_INITSEQ_WAIT(5),
+  /****GAMMA CLUSTER SETTING****/
+  ILI9328_GAMMA_CTRL1, 2, 0x00, 0x00,
+  ILI9328_GAMMA_CTRL2, 2, 0x01, 0x07,
+  ILI9328_GAMMA_CTRL3, 2, 0x00, 0x00,
+  ILI9328_GAMMA_CTRL4, 2, 0x02, 0x03,
+  ILI9328_GAMMA_CTRL5, 2, 0x04, 0x02,
+  ILI9328_GAMMA_CTRL6, 2, 0x00, 0x00,
+  ILI9328_GAMMA_CTRL7, 2, 0x02, 0x07,
+  ILI9328_GAMMA_CTRL8, 2, 0x00, 0x00,
+  ILI9328_GAMMA_CTRL9, 2, 0x02, 0x03,
+  ILI9328_GAMMA_CTRL10, 2, 0x04, 0x03,
+
+  //-DISPLAY WINDOWS 240*320-
+  ILI9328_HOR_START_AD, 2, 0x00, 0x00,
+  LCD_INITSEQ_CALL(ILI9328_HOR_END_AD),
+  ILI9328_VER_START_AD, 2, 0x00, 0x00,
+  LCD_INITSEQ_CALL(ILI9328_VER_END_AD),
+
+  //----FRAME RATE SETTING-----
+  LCD_INITSEQ_CALL(ILI9328_GATE_SCAN_CTRL1),
+  ILI9328_GATE_SCAN_CTRL2, 2, 0x00, 0x03,
+  ILI9328_PANEL_IF_CTRL1, LCD_INITSEQ_DELAY | 2, 0x00, 0x29, 5,
+
+  //------DISPLAY ON------
+  ILI9328_FRM_RATE_COL_CTRL, 2, 0x00, 0x0E,
+
+  ILI9328_DISP_CTRL1, 2, 0x01, 0x33,
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void ili9328_InitFunc(uint8_t Reg)
+{
+  const uint16_t * pData;
+  switch(Reg)
+  {
+    case ILI9328_DRIV_OUT_CTRL:
+      DrivOutCtrlData = Orient->DrivOutCtrl;
+      GateScanCtrl1Data = Orient->GateScanCtrl1;
+      EntryRightThenUp = Orient->RightThenUp;
+      EntryRightThenDown = Orient->RightThenDown;
+      EntryDownThenRight = Orient->DownThenRight;
+      LastEntry = EntryRightThenDown;
+      pData = &DrivOutCtrlData;
+      break;
+    case ILI9328_ENTRY_MOD:
+      pData = &EntryRightThenDown;
+      break;
+    case ILI9328_HOR_END_AD:
+      pData = &LcdPixelWidth;
+      break;
+    case ILI9328_VER_END_AD:
+      pData = &LcdPixelHeight;
+      break;
+    default: /* ILI9328_GATE_SCAN_CTRL1 */
+      pData = &GateScanCtrl1Data;
+      break;
+  }
+  LCD_IO_WriteCmd16MultipleData16(Reg, pData, 1);
+}
+
+static void ili9328_InitStart(void)
 {
   if((Is_ili9328_Initialized & ILI9328_LCD_INITIALIZED) == 0)
   {
     Is_ili9328_Initialized |= ILI9328_LCD_INITIALIZED;
-    if((Is_ili9328_Initialized & ILI9328_IO_INITIALIZED) == 0)
+    if((Is_ili9328_Initialized & ILI9328_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
       LCD_IO_Init();
     Is_ili9328_Initialized |= ILI9328_IO_INITIALIZED;
+    LCD_InitSeqStart(&InitSeq, ili9328_InitSeq, ili9328_InitFunc, LCD_INITSEQ_CMD16);
+  }
+}
 
-    LCD_Delay(5);
-
-    LCD_IO_WriteCmd16MultipleData16(ILI9328_DRIV_OUT_CTRL, &DrivOutCtrlData, 1);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_DRIV_WAV_CTRL, "\x07\x00", 2);
-    LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_DISP_CTRL2, "\x03\x02", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_DISP_CTRL3, "\x00\x00", 2);
-
-    /*POWER CONTROL REGISTER INITIAL*/
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL1, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL2, "\x00\x07", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL3, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL4, "\x00\x00", 2);
-
-    LCD_Delay(5);
-    /*POWER SUPPPLY STARTUP 1 SETTING*/
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL1, "\x14\xB0", 2);
-
-    LCD_Delay(5);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL2, "\x00\x07", 2);
-    LCD_Delay(5);
-
-    /*POWER SUPPLY STARTUP 2 SETTING*/
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL3, "\x00\x8E", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL4, "\x0C\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_POW_CTRL7, "\x00\x15", 2);
-
-    LCD_Delay(5);
-    /****GAMMA CLUSTER SETTING****/
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL1, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL2, "\x01\x07", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL3, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL4, "\x02\x03", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL5, "\x04\x02", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL6, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL7, "\x02\x07", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL8, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL9, "\x02\x03", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GAMMA_CTRL10, "\x04\x03", 2);
-
-    //-DISPLAY WINDOWS 240*320-
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_HOR_START_AD, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData16(ILI9328_HOR_END_AD, &LcdPixelWidth, 1);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_VER_START_AD, "\x00\x00", 2);
-    LCD_IO_WriteCmd16MultipleData16(ILI9328_VER_END_AD, &LcdPixelHeight, 1);
-
-    //----FRAME RATE SETTING-----
-    LCD_IO_WriteCmd16MultipleData16(ILI9328_GATE_SCAN_CTRL1, &GateScanCtrl1Data, 1);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_GATE_SCAN_CTRL2, "\x00\x03", 2);
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_PANEL_IF_CTRL1, "\x00\x29", 2);
-    LCD_Delay(5);
-
-    //------DISPLAY ON------
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_FRM_RATE_COL_CTRL, "\x00\x0E", 2);
+//-----------------------------------------------------------------------------
+/* Init the Display and init the IO */
+void ili9328_Init(void)
+{
+  ili9328_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
 
-    LCD_IO_WriteCmd16MultipleData8(ILI9328_DISP_CTRL1, "\x01\x33", 2);
-  }
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t ili9328_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    ili9328_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -330,11 +396,7 @@ void ili9328_DisplayOff(void)
    - retval The Lcd Pixel Width */
 uint16_t ili9328_GetLcdPixelWidth(void)
 {
-  #if ((ILI9328_ORIENTATION == 0) || (ILI9328_ORIENTATION == 2))
-  return (uint16_t)ILI9328_LCD_PIXEL_WIDTH;
-  #elif ((ILI9328_ORIENTATION == 1) || (ILI9328_ORIENTATION == 3))
-  return (uint16_t)ILI9328_LCD_PIXEL_HEIGHT;
-  #endif
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -342,11 +404,7 @@ uint16_t ili9328_GetLcdPixelWidth(void)
    - retval The Lcd Pixel Height */
 uint16_t ili9328_GetLcdPixelHeight(void)
 {
-  #if ((ILI9328_ORIENTATION == 0) || (ILI9328_ORIENTATION == 2))
-  return (uint16_t)ILI9328_LCD_PIXEL_HEIGHT;
-  #elif ((ILI9328_ORIENTATION == 1) || (ILI9328_ORIENTATION == 3))
-  return (uint16_t)ILI9328_LCD_PIXEL_WIDTH;
-  #endif
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -379,9 +437,9 @@ void ili9328_SetCursor(uint16_t Xpos, uint16_t Ypos)
    - RGBCode: the RGB pixel color */
 void ili9328_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ILI9328_SETCURSOR(Xpos, Ypos);
@@ -396,9 +454,9 @@ void ili9328_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t ili9328_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ILI9328_SETCURSOR(Xpos, Ypos);
@@ -416,7 +474,12 @@ uint16_t ili9328_ReadPixel(uint16_t Xpos, uint16_t Ypos)
    - Width:  display window width */
 void ili9328_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
 {
-  #if (ILI9328_ORIENTATION == 0) || (ILI9328_ORIENTATION == 2)
+  if(Orient->SwapXY)
+  { /* the x coordinate is the GRAM vertical address */
+    uint16_t t = Xpos; Xpos = Ypos; Ypos = t;
+    t = Width; Width = Height; Height = t;
+  }
+
   transdata.d16[0] = Xpos;
   LCD_IO_WriteCmd16MultipleData16(ILI9328_HOR_START_AD, &transdata, 1);
   transdata.d16[0] = Xpos + Width - 1;
@@ -426,18 +489,6 @@ void ili9328_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
   LCD_IO_WriteCmd16MultipleData16(ILI9328_VER_START_AD, &transdata, 1);
   transdata.d16[0] = Ypos + Height - 1;
   LCD_IO_WriteCmd16MultipleData16(ILI9328_VER_END_AD, &transdata, 1);
-
-  #elif (ILI9328_ORIENTATION == 1) || (ILI9328_ORIENTATION == 3)
-  transdata.d16[0] = Ypos;
-  LCD_IO_WriteCmd16MultipleData16(ILI9328_HOR_START_AD, &transdata, 1);
-  transdata.d16[0] = Ypos + Height - 1;
-  LCD_IO_WriteCmd16MultipleData16(ILI9328_HOR_END_AD, &transdata, 1);
-
-  transdata.d16[0] = Xpos;
-  LCD_IO_WriteCmd16MultipleData16(ILI9328_VER_START_AD, &transdata, 1);
-  transdata.d16[0] = Xpos + Width - 1;
-  LCD_IO_WriteCmd16MultipleData16(ILI9328_VER_END_AD, &transdata, 1);
-  #endif
 }
 
 //-----------------------------------------------------------------------------
@@ -448,9 +499,9 @@ void ili9328_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
    - Length:   specifies the Line length */
 void ili9328_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ILI9328_SETCURSOR(Xpos, Ypos);
@@ -465,9 +516,9 @@ void ili9328_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
    - Length:   specifies the Line length  */
 void ili9328_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT)
+  if(LastEntry != EntryDownThenRight)
   {
-    LastEntry = ILI9328_ENTRY_DATA_DOWN_THEN_RIGHT;
+    LastEntry = EntryDownThenRight;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryDownThenRight, 1);
   }
   ILI9328_SETCURSOR(Xpos, Ypos);
@@ -486,9 +537,9 @@ void ili9328_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9328_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ili9328_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -514,9 +565,9 @@ void ili9328_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index) / 2;
   pbmp += index;
 
-  if(LastEntry != ILI9328_ENTRY_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenUp, 1);
   }
   ILI9328_SETCURSOR(Xpos, Ypos);
@@ -532,9 +583,9 @@ void ili9328_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
    - Ysize: Image Y size in the LCD */
 void ili9328_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pdata)
 {
-  if(LastEntry != ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9328_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ili9328_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -595,3 +646,30 @@ void ili9328_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_
   else if(Mode == 3)
     LCD_IO_ReadCmd16MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ILI9328_ORIENTATION)
+  * @retval None
+  */
+void ili9328_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ILI9328_LCD_PIXEL_HEIGHT : ILI9328_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ILI9328_LCD_PIXEL_WIDTH : ILI9328_LCD_PIXEL_HEIGHT;
+  DrivOutCtrlData = Orient->DrivOutCtrl;
+  GateScanCtrl1Data = Orient->GateScanCtrl1;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  EntryDownThenRight = Orient->DownThenRight;
+  if(Is_ili9328_Initialized & ILI9328_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd16MultipleData16(ILI9328_DRIV_OUT_CTRL, &DrivOutCtrlData, 1);
+    LCD_IO_WriteCmd16MultipleData16(ILI9328_GATE_SCAN_CTRL1, &GateScanCtrl1Data, 1);
+    LCD_IO_WriteCmd16MultipleData16(ILI9328_ENTRY_MOD, &EntryRightThenDown, 1);
+  }
+}
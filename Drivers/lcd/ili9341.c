@@ -12,6 +12,7 @@
 #include "lcd.h"
 #include "lcd_io.h"
 #include "bmp.h"
+#include "lcd_initseq.h"
 #include "ili9341.h"
 
 void     ili9341_Init(void);
@@ -32,6 +33,8 @@ void     ili9341_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint
 void     ili9341_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
 void     ili9341_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void     ili9341_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     ili9341_SetOrientation(uint8_t Orientation);
+uint32_t ili9341_InitStep(void);
 
 LCD_DrvTypeDef   ili9341_drv =
 {
@@ -52,14 +55,21 @@ LCD_DrvTypeDef   ili9341_drv =
   ili9341_FillRect,
   ili9341_ReadRGBImage,
   ili9341_Scroll,
-  ili9341_UserCommand
+  ili9341_UserCommand,
+  ili9341_SetOrientation,
+  ili9341_InitStep,
+  NULL,
+  NULL,
+  NULL
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &ili9341_drv;
+#endif
 
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -150,35 +160,26 @@ union
 #define ILI9341_MAD_COLORMODE  ILI9341_MAD_BGR
 #endif
 
-#if (ILI9341_ORIENTATION == 0)
-#define ILI9341_SIZE_X                     ILI9341_LCD_PIXEL_WIDTH
-#define ILI9341_SIZE_Y                     ILI9341_LCD_PIXEL_HEIGHT
-#define ILI9341_MAD_DATA_RIGHT_THEN_UP     (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_UP)
-#define ILI9341_MAD_DATA_RIGHT_THEN_DOWN   (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_DOWN)
-#define XSIZE                              Xsize
-#define YSIZE                              Ysize
-#elif (ILI9341_ORIENTATION == 1)
-#define ILI9341_SIZE_X                     ILI9341_LCD_PIXEL_HEIGHT
-#define ILI9341_SIZE_Y                     ILI9341_LCD_PIXEL_WIDTH
-#define ILI9341_MAD_DATA_RIGHT_THEN_UP     (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_DOWN | ILI9341_MAD_VERTICAL)
-#define ILI9341_MAD_DATA_RIGHT_THEN_DOWN   (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_DOWN | ILI9341_MAD_VERTICAL)
-#define XSIZE                              Ysize
-#define YSIZE                              Xsize
-#elif (ILI9341_ORIENTATION == 2)
-#define ILI9341_SIZE_X                     ILI9341_LCD_PIXEL_WIDTH
-#define ILI9341_SIZE_Y                     ILI9341_LCD_PIXEL_HEIGHT
-#define ILI9341_MAD_DATA_RIGHT_THEN_UP     (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_DOWN)
-#define ILI9341_MAD_DATA_RIGHT_THEN_DOWN   (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_UP)
-#define XSIZE                              Xsize
-#define YSIZE                              Ysize
-#elif (ILI9341_ORIENTATION == 3)
-#define ILI9341_SIZE_X                     ILI9341_LCD_PIXEL_HEIGHT
-#define ILI9341_SIZE_Y                     ILI9341_LCD_PIXEL_WIDTH
-#define ILI9341_MAD_DATA_RIGHT_THEN_UP     (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_UP   | ILI9341_MAD_VERTICAL)
-#define ILI9341_MAD_DATA_RIGHT_THEN_DOWN   (ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_UP   | ILI9341_MAD_VERTICAL)
-#define XSIZE                              Ysize
-#define YSIZE                              Xsize
-#endif
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint8_t  RightThenUp;                 /* MADCTL for right then up draw direction (bitmap) */
+  uint8_t  RightThenDown;               /* MADCTL for right then down draw direction */
+  uint8_t  ScrollTop;                   /* VSCRDEF top fix area parameter index (1 or 3) */
+  int8_t   ScrollDir;                   /* scroll direction */
+}ili9341_OrientTypeDef;
+
+static const ili9341_OrientTypeDef OrientTab[4] =
+{
+  {ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_UP,
+   ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_DOWN, 1, -1},
+  {ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_DOWN | ILI9341_MAD_VERTICAL,
+   ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_DOWN | ILI9341_MAD_VERTICAL, 1, -1},
+  {ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_DOWN,
+   ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_UP, 3, 1},
+  {ILI9341_MAD_COLORMODE | ILI9341_MAD_X_LEFT  | ILI9341_MAD_Y_UP   | ILI9341_MAD_VERTICAL,
+   ILI9341_MAD_COLORMODE | ILI9341_MAD_X_RIGHT | ILI9341_MAD_Y_UP   | ILI9341_MAD_VERTICAL, 3, 1}
+};
 
 #define ILI9341_SETWINDOW(x1, x2, y1, y2) \
   { transdata.d16[0] = __REVSH(x1); transdata.d16[1] = __REVSH(x2); LCD_IO_WriteCmd8MultipleData8(ILI9341_CASET, &transdata, 4); \
@@ -191,11 +192,16 @@ union
 #define ILI9341_IO_INITIALIZED     0x02
 static  uint8_t   Is_ili9341_Initialized = 0;
 
-const uint8_t EntryRightThenUp = ILI9341_MAD_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+/* actual orientation (see ILI9341_ORIENTATION, it can be changed with ili9341_SetOrientation) */
+static  const ili9341_OrientTypeDef * Orient = &OrientTab[ILI9341_ORIENTATION];
+static  uint16_t  SizeX = (ILI9341_ORIENTATION & 1) ? ILI9341_LCD_PIXEL_HEIGHT : ILI9341_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ILI9341_ORIENTATION & 1) ? ILI9341_LCD_PIXEL_WIDTH : ILI9341_LCD_PIXEL_HEIGHT;
+
+static uint8_t EntryRightThenUp = 0;
+static uint8_t EntryRightThenDown = 0;
 
 /* the last set drawing direction is stored here */
-uint8_t LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+static uint8_t LastEntry = 0;
 
 static  uint16_t  yStart, yEnd;
 
@@ -207,7 +213,7 @@ static  uint16_t  yStart, yEnd;
 #define SetWriteDir()
 #define SetReadDir()
 #else /* #if ILI9341_WRITEBITDEPTH == ILI9341_READBITDEPTH */
-uint8_t lastdir = 0;
+static uint8_t lastdir = 0;
 #if ILI9341_WRITEBITDEPTH == 16
 /* 16/24 bit */
 #define SetWriteDir() {                                      \
@@ -297,7 +303,7 @@ void ili9341_DisplayOff(void)
   */
 uint16_t ili9341_GetLcdPixelWidth(void)
 {
-  return ILI9341_SIZE_X;
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -308,7 +314,7 @@ uint16_t ili9341_GetLcdPixelWidth(void)
   */
 uint16_t ili9341_GetLcdPixelHeight(void)
 {
-  return ILI9341_SIZE_Y;
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -325,70 +331,114 @@ uint32_t ili9341_ReadID(void)
 }
 
 //-----------------------------------------------------------------------------
-void ili9341_Init(void)
-{
-  if((Is_ili9341_Initialized & ILI9341_LCD_INITIALIZED) == 0)
-  {
-    Is_ili9341_Initialized |= ILI9341_LCD_INITIALIZED;
-    if((Is_ili9341_Initialized & ILI9341_IO_INITIALIZED) == 0)
-      LCD_IO_Init();
-    Is_ili9341_Initialized |= ILI9341_IO_INITIALIZED;
-  }
+/* Init sequence (see lcd_initseq.h) */
+#define INITFUNC_ORIENT       0
+#define INITFUNC_CLEAR        1
 
-  LCD_Delay(10);
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_SWRESET, NULL, 0);
-  LCD_Delay(10);
+static const uint8_t ili9341_InitSeq[] =
+{
+  LCD_INITSEQ_WAIT(10),
+  ILI9341_SWRESET, LCD_INITSEQ_DELAY | 0, 10,
 
-  LCD_IO_WriteCmd8MultipleData8(0xEF, (uint8_t *)"\x03\x80\x02", 3);
-  LCD_IO_WriteCmd8MultipleData8(0xCF, (uint8_t *)"\x00\xC1\x30", 3);
-  LCD_IO_WriteCmd8MultipleData8(0xED, (uint8_t *)"\x64\x03\x12\x81", 4);
-  LCD_IO_WriteCmd8MultipleData8(0xE8, (uint8_t *)"\x85\x00\x78", 3);
-  LCD_IO_WriteCmd8MultipleData8(0xCB, (uint8_t *)"\x39\x2C\x00\x34\x02", 5);
-  LCD_IO_WriteCmd8MultipleData8(0xF7, (uint8_t *)"\x20", 1);
-  LCD_IO_WriteCmd8MultipleData8(0xEA, (uint8_t *)"\x00\x00", 2);
+  0xEF, 3, 0x03, 0x80, 0x02,
+  0xCF, 3, 0x00, 0xC1, 0x30,
+  0xED, 4, 0x64, 0x03, 0x12, 0x81,
+  0xE8, 3, 0x85, 0x00, 0x78,
+  0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02,
+  0xF7, 1, 0x20,
+  0xEA, 2, 0x00, 0x00,
 
   // Power Control 1 (Vreg1out, Verg2out)
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_PWCTR1, (uint8_t *)"\x23", 1);
+  ILI9341_PWCTR1, 1, 0x23,
 
   // Power Control 2 (VGH,VGL)
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_PWCTR2, (uint8_t *)"\x10", 1);
+  ILI9341_PWCTR2, 1, 0x10,
 
   // Power Control 3 (Vcom)
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_VMCTR1, (uint8_t *)"\x3E\x28", 2);
+  ILI9341_VMCTR1, 2, 0x3E, 0x28,
 
   // Power Control 3 (Vcom)
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_VMCTR2, (uint8_t *)"\x86", 1);
+  ILI9341_VMCTR2, 1, 0x86,
 
   // Vertical scroll zero
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_VSCRSADD, (uint8_t *)"\x00", 1);
+  ILI9341_VSCRSADD, 1, 0x00,
   #if ILI9341_WRITEBITDEPTH == 16
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_PIXFMT, (uint8_t *)"\x55", 1);
+  ILI9341_PIXFMT, 1, 0x55,
   #elif ILI9341_WRITEBITDEPTH == 24
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_PIXFMT, (uint8_t *)"\x66", 1);
+  ILI9341_PIXFMT, 1, 0x66,
   #endif
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_FRMCTR1, (uint8_t *)"\x00\x18", 2);
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_DFUNCTR, (uint8_t *)"\x08\x82\x27", 3);  // Display Function Control
-  LCD_IO_WriteCmd8MultipleData8(0xF2, (uint8_t *)"\x00", 1);            // 3Gamma Function Disable
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_GAMMASET, (uint8_t *)"\x01", 1);// Gamma curve selected
+  ILI9341_FRMCTR1, 2, 0x00, 0x18,
+  ILI9341_DFUNCTR, 3, 0x08, 0x82, 0x27,  // Display Function Control
+  0xF2, 1, 0x00,                         // 3Gamma Function Disable
+  ILI9341_GAMMASET, 1, 0x01,             // Gamma curve selected
 
   // positive gamma control
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_GMCTRP1, (uint8_t *)"\x0F\x31\x2B\x0C\x0E\x08\x4E\xF1\x37\x07\x10\x03\x0E\x09\x00", 15);
+  ILI9341_GMCTRP1, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1, 0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
 
   // negative gamma control
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_GMCTRN1, (uint8_t *)"\x00\x0E\x14\x03\x11\x07\x31\xC1\x48\x08\x0F\x0C\x31\x36\x0F", 15);
+  ILI9341_GMCTRN1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1, 0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_SLPOUT, NULL, 0);    // Exit Sleep
-  LCD_Delay(10);
+  LCD_INITSEQ_CALL(INITFUNC_ORIENT),     // MADCTL
+  ILI9341_SLPOUT, LCD_INITSEQ_DELAY | 0, 10,  // Exit Sleep
 
   #if ILI9341_INITCLEAR == 1
-  ili9341_FillRect(0, 0, ILI9341_SIZE_X, ILI9341_SIZE_Y, 0x0000);
-  LCD_Delay(10);
+  LCD_INITSEQ_CALL(INITFUNC_CLEAR),
+  LCD_INITSEQ_WAIT(10),
   #endif
-  
-  LCD_IO_WriteCmd8MultipleData8(ILI9341_DISPON, NULL, 0);    // Display on
-  LCD_Delay(10);
+
+  ILI9341_DISPON, LCD_INITSEQ_DELAY | 0, 10,  // Display on
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void ili9341_InitFunc(uint8_t Func)
+{
+  if(Func == INITFUNC_ORIENT)
+  {
+    EntryRightThenUp = Orient->RightThenUp;
+    EntryRightThenDown = Orient->RightThenDown;
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
+  }
+  #if ILI9341_INITCLEAR == 1
+  else if(Func == INITFUNC_CLEAR)
+    ili9341_FillRect(0, 0, SizeX, SizeY, 0x0000);
+  #endif
+}
+
+static void ili9341_InitStart(void)
+{
+  if((Is_ili9341_Initialized & ILI9341_LCD_INITIALIZED) == 0)
+  {
+    Is_ili9341_Initialized |= ILI9341_LCD_INITIALIZED;
+    if((Is_ili9341_Initialized & ILI9341_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
+      LCD_IO_Init();
+    Is_ili9341_Initialized |= ILI9341_IO_INITIALIZED;
+  }
+  LCD_InitSeqStart(&InitSeq, ili9341_InitSeq, ili9341_InitFunc, LCD_INITSEQ_CMD8);
+}
+
+//-----------------------------------------------------------------------------
+void ili9341_Init(void)
+{
+  ili9341_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t ili9341_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    ili9341_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -413,9 +463,9 @@ void ili9341_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void ili9341_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ILI9341_SETCURSOR(Xpos, Ypos);
@@ -432,9 +482,9 @@ void ili9341_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t ili9341_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ILI9341_SETCURSOR(Xpos, Ypos);
@@ -468,9 +518,9 @@ void ili9341_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
   */
 void ili9341_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ILI9341_SETWINDOW(Xpos, Xpos + Length - 1, Ypos, Ypos);
@@ -488,9 +538,9 @@ void ili9341_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9341_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ILI9341_SETWINDOW(Xpos, Xpos, Ypos, Ypos + Length - 1);
@@ -509,9 +559,9 @@ void ili9341_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9341_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ILI9341_SETWINDOW(Xpos, Xpos + Xsize - 1, Ypos, Ypos + Ysize - 1);
@@ -537,13 +587,13 @@ void ili9341_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index) / 2;
   pbmp += index;
 
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenUp, 1);
   }
-  transdata.d16[0] = __REVSH(ILI9341_SIZE_Y - 1 - yEnd);
-  transdata.d16[1] = __REVSH(ILI9341_SIZE_Y - 1 - yStart);
+  transdata.d16[0] = __REVSH(SizeY - 1 - yEnd);
+  transdata.d16[1] = __REVSH(SizeY - 1 - yStart);
   LCD_IO_WriteCmd8MultipleData8(ILI9341_PASET, &transdata, 4);
   LCD_IO_DrawBitmap(pbmp, size);
 }
@@ -561,9 +611,9 @@ void ili9341_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void ili9341_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ili9341_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -583,9 +633,9 @@ void ili9341_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void ili9341_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ILI9341_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9341_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
   }
   ili9341_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -603,59 +653,19 @@ void ili9341_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
 void ili9341_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
   static uint16_t scrparam[4] = {0, 0, 0, 0};
-  #if (ILI9341_ORIENTATION == 0)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
-  {
-    scrparam[1] = __REVSH(TopFix);
-    scrparam[3] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ILI9341_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ILI9341_VSCRDEF, &scrparam[1], 6);
-  }
-  Scroll = (0 - Scroll) % __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ILI9341_ORIENTATION == 1)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
-  {
-    scrparam[1] = __REVSH(TopFix);
-    scrparam[3] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ILI9341_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ILI9341_VSCRDEF, &scrparam[1], 6);
-  }
-  Scroll = (0 - Scroll) % __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ILI9341_ORIENTATION == 2)
-  if((TopFix != __REVSH(scrparam[3])) || (BottonFix != __REVSH(scrparam[1])))
-  {
-    scrparam[3] = __REVSH(TopFix);
-    scrparam[1] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ILI9341_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ILI9341_VSCRDEF, &scrparam[1], 6);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ILI9341_ORIENTATION == 3)
-  if((TopFix != __REVSH(scrparam[3])) || (BottonFix != __REVSH(scrparam[1])))
+  uint8_t top = Orient->ScrollTop;      /* orientation 2, 3: the top fix area is the physical bottom */
+  if((TopFix != __REVSH(scrparam[top])) || (BottonFix != __REVSH(scrparam[4 - top])) || (scrparam[2] == 0))
   {
-    scrparam[3] = __REVSH(TopFix);
-    scrparam[1] = __REVSH(BottonFix);
+    scrparam[top] = __REVSH(TopFix);
+    scrparam[4 - top] = __REVSH(BottonFix);
     scrparam[2] = __REVSH(ILI9341_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
     LCD_IO_WriteCmd8MultipleData8(ILI9341_VSCRDEF, &scrparam[1], 6);
   }
-  Scroll %= __REVSH(scrparam[2]);
+  Scroll = (Scroll * Orient->ScrollDir) % __REVSH(scrparam[2]);
   if(Scroll < 0)
     Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
   else
     Scroll = Scroll + __REVSH(scrparam[1]);
-  #endif
   if(Scroll != __REVSH(scrparam[0]))
   {
     scrparam[0] = __REVSH(Scroll);
@@ -683,3 +693,25 @@ void ili9341_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_
   else if(Mode == 3)
     LCD_IO_ReadCmd8MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ILI9341_ORIENTATION)
+  * @retval None
+  */
+void ili9341_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ILI9341_LCD_PIXEL_HEIGHT : ILI9341_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ILI9341_LCD_PIXEL_WIDTH : ILI9341_LCD_PIXEL_HEIGHT;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  if(Is_ili9341_Initialized & ILI9341_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ILI9341_MADCTL, &EntryRightThenDown, 1);
+  }
+}
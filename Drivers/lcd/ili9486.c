@@ -6,6 +6,7 @@
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
+#include "lcd_initseq.h"
 #include "ili9486.h"
 
 /* Lcd */
@@ -27,6 +28,8 @@ void     ili9486_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint
 void     ili9486_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
 void     ili9486_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void     ili9486_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     ili9486_SetOrientation(uint8_t Orientation);
+uint32_t ili9486_InitStep(void);
 
 LCD_DrvTypeDef   ili9486_drv =
 {
@@ -47,14 +50,21 @@ LCD_DrvTypeDef   ili9486_drv =
   ili9486_FillRect,
   ili9486_ReadRGBImage,
   ili9486_Scroll,
-  ili9486_UserCommand
+  ili9486_UserCommand,
+  ili9486_SetOrientation,
+  ili9486_InitStep,
+  NULL,
+  NULL,
+  NULL
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &ili9486_drv;
+#endif
 
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -143,44 +153,44 @@ union
   { transdata.d16[0] = x; transdata.d16[1] = transdata.d16[0]; LCD_IO_WriteCmd8MultipleData16(ILI9486_CASET, (uint16_t *)&transdata, 2); \
     transdata.d16[0] = y; transdata.d16[1] = transdata.d16[0]; LCD_IO_WriteCmd8MultipleData16(ILI9486_PASET, (uint16_t *)&transdata, 2); }
 
-#if (ILI9486_ORIENTATION == 0)
-#define ILI9486_SIZE_X                     ILI9486_LCD_PIXEL_WIDTH
-#define ILI9486_SIZE_Y                     ILI9486_LCD_PIXEL_HEIGHT
-#define ILI9486_MAD_DATA_RIGHT_THEN_UP     (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_UP)
-#define ILI9486_MAD_DATA_RIGHT_THEN_DOWN   (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_DOWN)
-#define ILI9486_MAD_DATA_RGBMODE           (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_DOWN)
-#elif (ILI9486_ORIENTATION == 1)
-#define ILI9486_SIZE_X                     ILI9486_LCD_PIXEL_HEIGHT
-#define ILI9486_SIZE_Y                     ILI9486_LCD_PIXEL_WIDTH
-#define ILI9486_MAD_DATA_RIGHT_THEN_UP     (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_DOWN | ILI9486_MAD_VERTICAL)
-#define ILI9486_MAD_DATA_RIGHT_THEN_DOWN   (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_DOWN | ILI9486_MAD_VERTICAL)
-#define ILI9486_MAD_DATA_RGBMODE           (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_DOWN)
-#elif (ILI9486_ORIENTATION == 2)
-#define ILI9486_SIZE_X                     ILI9486_LCD_PIXEL_WIDTH
-#define ILI9486_SIZE_Y                     ILI9486_LCD_PIXEL_HEIGHT
-#define ILI9486_MAD_DATA_RIGHT_THEN_UP     (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_DOWN)
-#define ILI9486_MAD_DATA_RIGHT_THEN_DOWN   (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_UP)
-#define ILI9486_MAD_DATA_RGBMODE           (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_UP)
-#elif (ILI9486_ORIENTATION == 3)
-#define ILI9486_SIZE_X                     ILI9486_LCD_PIXEL_HEIGHT
-#define ILI9486_SIZE_Y                     ILI9486_LCD_PIXEL_WIDTH
-#define ILI9486_MAD_DATA_RIGHT_THEN_UP     (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_UP   | ILI9486_MAD_VERTICAL)
-#define ILI9486_MAD_DATA_RIGHT_THEN_DOWN   (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_UP   | ILI9486_MAD_VERTICAL)
-#define ILI9486_MAD_DATA_RGBMODE           (ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_UP)
-#endif
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint8_t  RightThenUp;                 /* MADCTL for right then up draw direction (bitmap) */
+  uint8_t  RightThenDown;               /* MADCTL for right then down draw direction */
+  uint8_t  ScrollTop;                   /* VSCRDEF top fix area parameter index (1 or 3) */
+  int8_t   ScrollDir;                   /* scroll direction */
+}ili9486_OrientTypeDef;
+
+static const ili9486_OrientTypeDef OrientTab[4] =
+{
+  {ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_UP,
+   ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_DOWN, 1, -1},
+  {ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_DOWN | ILI9486_MAD_VERTICAL,
+   ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_DOWN | ILI9486_MAD_VERTICAL, 1, -1},
+  {ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_DOWN,
+   ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_UP, 3, 1},
+  {ILI9486_MAD_COLORMODE | ILI9486_MAD_X_LEFT  | ILI9486_MAD_Y_UP   | ILI9486_MAD_VERTICAL,
+   ILI9486_MAD_COLORMODE | ILI9486_MAD_X_RIGHT | ILI9486_MAD_Y_UP   | ILI9486_MAD_VERTICAL, 3, 1}
+};
 
 //-----------------------------------------------------------------------------
 #define ILI9486_LCD_INITIALIZED    0x01
 #define ILI9486_IO_INITIALIZED     0x02
 static  uint8_t   Is_ili9486_Initialized = 0;
 
-const uint8_t EntryRightThenUp = ILI9486_MAD_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+/* actual orientation (see ILI9486_ORIENTATION, it can be changed with ili9486_SetOrientation) */
+static  const ili9486_OrientTypeDef * Orient = &OrientTab[ILI9486_ORIENTATION];
+static  uint16_t  SizeX = (ILI9486_ORIENTATION & 1) ? ILI9486_LCD_PIXEL_HEIGHT : ILI9486_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ILI9486_ORIENTATION & 1) ? ILI9486_LCD_PIXEL_WIDTH : ILI9486_LCD_PIXEL_HEIGHT;
+
+static uint8_t EntryRightThenUp = 0;
+static uint8_t EntryRightThenDown = 0;
 
 /* the last set drawing direction is stored here */
-uint8_t LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+static uint8_t LastEntry = 0;
 
-uint16_t  yStart, yEnd;
+static uint16_t  yStart, yEnd;
 
 //-----------------------------------------------------------------------------
 /* Pixel draw and read functions */
@@ -190,7 +200,7 @@ uint16_t  yStart, yEnd;
 #define SetWriteDir()
 #define SetReadDir()
 #else /* #if ILI9486_WRITEBITDEPTH == ILI9486_READBITDEPTH */
-uint8_t lastdir = 0;
+static uint8_t lastdir = 0;
 #if ILI9486_WRITEBITDEPTH == 16
 /* 16/24 bit */
 #define SetWriteDir() {                                      \
@@ -264,60 +274,104 @@ uint8_t lastdir = 0;
 #endif /* #elif ILI9486_READBITDEPTH == 24 */
 
 //-----------------------------------------------------------------------------
-/**
-  * @brief  ILI9486 initialization
-  * @param  None
-  * @retval None
-  */
-void ili9486_Init(void)
+/* Init sequence (see lcd_initseq.h) */
+#define INITFUNC_ORIENT       0
+#define INITFUNC_CLEAR        1
+
+static const uint8_t ili9486_InitSeq[] =
 {
-  if((Is_ili9486_Initialized & ILI9486_LCD_INITIALIZED) == 0)
-  {
-    Is_ili9486_Initialized |= ILI9486_LCD_INITIALIZED;
-    if((Is_ili9486_Initialized & ILI9486_IO_INITIALIZED) == 0)
-      LCD_IO_Init();
-    Is_ili9486_Initialized |= ILI9486_IO_INITIALIZED;
-  }
-  LCD_Delay(10);
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_SWRESET, NULL, 0);
-  LCD_Delay(100);
+  LCD_INITSEQ_WAIT(10),
+  ILI9486_SWRESET, LCD_INITSEQ_DELAY | 0, 100,
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_RGB_INTERFACE, (uint8_t *)"\x00", 1);   /* RGB mode off (0xB0) */
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_SLPOUT, NULL, 0);                       /* Exit Sleep (0x11) */
-  LCD_Delay(10);
+  ILI9486_RGB_INTERFACE, 1, 0x00,        /* RGB mode off (0xB0) */
+  ILI9486_SLPOUT, LCD_INITSEQ_DELAY | 0, 10, /* Exit Sleep (0x11) */
 
   #if ILI9486_WRITEBITDEPTH == 16
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_PIXFMT, (uint8_t *)"\x55", 1); /* interface format (16 bit) */
+  ILI9486_PIXFMT, 1, 0x55,               /* interface format (16 bit) */
   #elif ILI9486_WRITEBITDEPTH == 24
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_PIXFMT, (uint8_t *)"\x66", 1); /* interface format (24 bit) */
+  ILI9486_PIXFMT, 1, 0x66,               /* interface format (24 bit) */
   #endif
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
+  LCD_INITSEQ_CALL(INITFUNC_ORIENT),     /* MADCTL */
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_PWCTR3, (uint8_t *)"\x44", 1); /* 0xC2 */
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_VMCTR1, (uint8_t *)"\x00\x00\x00\x00", 4); /* 0xC5 */
+  ILI9486_PWCTR3, 1, 0x44,               /* 0xC2 */
+  ILI9486_VMCTR1, 4, 0x00, 0x00, 0x00, 0x00, /* 0xC5 */
 
   /* positive gamma control (0xE0) */
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_GMCTRP1, (uint8_t *)"\x0F\x1F\x1C\x0C\x0F\x08\x48\x98\x37\x0A\x13\x04\x11\x0D\x00", 15);
+  ILI9486_GMCTRP1, 15, 0x0F, 0x1F, 0x1C, 0x0C, 0x0F, 0x08, 0x48, 0x98, 0x37, 0x0A, 0x13, 0x04, 0x11, 0x0D, 0x00,
 
   /* negative gamma control (0xE1) */
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_GMCTRN1, (uint8_t *)"\x0F\x32\x2E\x0B\x0D\x05\x47\x75\x37\x06\x10\x03\x24\x20\x00", 15);
+  ILI9486_GMCTRN1, 15, 0x0F, 0x32, 0x2E, 0x0B, 0x0D, 0x05, 0x47, 0x75, 0x37, 0x06, 0x10, 0x03, 0x24, 0x20, 0x00,
 
   /* Digital gamma control1 (0xE2) */
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_DGCTR1, (uint8_t *)"\x0F\x32\x2E\x0B\x0D\x05\x47\x75\x37\x06\x10\x03\x24\x20\x00", 15);
+  ILI9486_DGCTR1, 15, 0x0F, 0x32, 0x2E, 0x0B, 0x0D, 0x05, 0x47, 0x75, 0x37, 0x06, 0x10, 0x03, 0x24, 0x20, 0x00,
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_NORON, NULL, 0);    /* Normal display on (0x13) */
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_INVOFF, NULL, 0);   /* Display inversion off (0x20) */
+  ILI9486_NORON, 0,                      /* Normal display on (0x13) */
+  ILI9486_INVOFF, 0,                     /* Display inversion off (0x20) */
 
   #if ILI9486_INITCLEAR == 1
-  ili9486_FillRect(0, 0, ILI9486_SIZE_X, ILI9486_SIZE_Y, 0x0000);
-  LCD_Delay(1);
+  LCD_INITSEQ_CALL(INITFUNC_CLEAR),
+  LCD_INITSEQ_WAIT(1),
   #endif
 
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_SLPOUT, NULL, 0);   /* Exit Sleep (0x11) */
-  LCD_Delay(200);
-  LCD_IO_WriteCmd8MultipleData8(ILI9486_DISPON, NULL, 0);   /* Display on (0x29) */
-  LCD_Delay(10);
+  ILI9486_SLPOUT, LCD_INITSEQ_DELAY | 0, 200, /* Exit Sleep (0x11) */
+  ILI9486_DISPON, LCD_INITSEQ_DELAY | 0, 10,  /* Display on (0x29) */
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void ili9486_InitFunc(uint8_t Func)
+{
+  if(Func == INITFUNC_ORIENT)
+  {
+    EntryRightThenUp = Orient->RightThenUp;
+    EntryRightThenDown = Orient->RightThenDown;
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
+  }
+  #if ILI9486_INITCLEAR == 1
+  else if(Func == INITFUNC_CLEAR)
+    ili9486_FillRect(0, 0, SizeX, SizeY, 0x0000);
+  #endif
+}
+
+static void ili9486_InitStart(void)
+{
+  if((Is_ili9486_Initialized & ILI9486_LCD_INITIALIZED) == 0)
+  {
+    Is_ili9486_Initialized |= ILI9486_LCD_INITIALIZED;
+    if((Is_ili9486_Initialized & ILI9486_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
+      LCD_IO_Init();
+    Is_ili9486_Initialized |= ILI9486_IO_INITIALIZED;
+  }
+  LCD_InitSeqStart(&InitSeq, ili9486_InitSeq, ili9486_InitFunc, LCD_INITSEQ_CMD8);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  ILI9486 initialization
+  * @param  None
+  * @retval None
+  */
+void ili9486_Init(void)
+{
+  ili9486_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t ili9486_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    ili9486_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -352,7 +406,7 @@ void ili9486_DisplayOff(void)
   */
 uint16_t ili9486_GetLcdPixelWidth(void)
 {
-  return ILI9486_SIZE_X;
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -363,7 +417,7 @@ uint16_t ili9486_GetLcdPixelWidth(void)
   */
 uint16_t ili9486_GetLcdPixelHeight(void)
 {
-  return ILI9486_SIZE_Y;
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -407,9 +461,9 @@ void ili9486_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void ili9486_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   SETCURSOR(Xpos, Ypos);
@@ -426,9 +480,9 @@ void ili9486_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t ili9486_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   SETCURSOR(Xpos, Ypos);
@@ -462,9 +516,9 @@ void ili9486_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
   */
 void ili9486_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   ili9486_FillRect(Xpos, Ypos, Length, 1, RGBCode);
@@ -481,9 +535,9 @@ void ili9486_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9486_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   ili9486_FillRect(Xpos, Ypos, 1, Length, RGBCode);
@@ -501,9 +555,9 @@ void ili9486_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9486_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   ili9486_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -532,13 +586,13 @@ void ili9486_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index)/2;
   pbmp += index;
 
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenUp, 1);
   }
-  transdata.d16[0] = ILI9486_SIZE_X - 1 - yEnd;
-  transdata.d16[1] = ILI9486_SIZE_Y - 1 - yStart;
+  transdata.d16[0] = SizeY - 1 - yEnd;
+  transdata.d16[1] = SizeY - 1 - yStart;
   LCD_IO_WriteCmd8MultipleData16(ILI9486_PASET, &transdata, 2);
   LCD_IO_DrawBitmap(pbmp, size);
 }
@@ -556,9 +610,9 @@ void ili9486_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void ili9486_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   ili9486_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -578,9 +632,9 @@ void ili9486_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void ili9486_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ILI9486_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9486_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
   }
   ili9486_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -598,59 +652,19 @@ void ili9486_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
 void ili9486_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
   static uint16_t scrparam[4] = {0, 0, 0, 0};
-  #if (ILI9486_ORIENTATION == 0)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
+  uint8_t top = Orient->ScrollTop;      /* the top fix area can be the physical bottom */
+  if((TopFix != scrparam[top]) || (BottonFix != scrparam[4 - top]) || (scrparam[2] == 0))
   {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
+    scrparam[top] = TopFix;
+    scrparam[4 - top] = BottonFix;
     scrparam[2] = ILI9486_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
     LCD_IO_WriteCmd8MultipleData16(ILI9486_VSCRDEF, &scrparam[1], 3);
   }
-  Scroll = (0 - Scroll) % scrparam[2];
+  Scroll = (Scroll * Orient->ScrollDir) % scrparam[2];
   if(Scroll < 0)
     Scroll = scrparam[2] + Scroll + scrparam[1];
   else
     Scroll = Scroll + scrparam[1];
-  #elif (ILI9486_ORIENTATION == 1)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
-  {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
-    scrparam[2] = ILI9486_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ILI9486_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll = (0 - Scroll) % scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ILI9486_ORIENTATION == 2)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = ILI9486_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ILI9486_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ILI9486_ORIENTATION == 3)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = ILI9486_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ILI9486_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #endif
   if(Scroll != scrparam[0])
   {
     scrparam[0] = Scroll;
@@ -678,3 +692,25 @@ void ili9486_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_
   else if(Mode == 3)
     LCD_IO_ReadCmd8MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ILI9486_ORIENTATION)
+  * @retval None
+  */
+void ili9486_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ILI9486_LCD_PIXEL_HEIGHT : ILI9486_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ILI9486_LCD_PIXEL_WIDTH : ILI9486_LCD_PIXEL_HEIGHT;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  if(Is_ili9486_Initialized & ILI9486_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ILI9486_MADCTL, &EntryRightThenDown, 1);
+  }
+}
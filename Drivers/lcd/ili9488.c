@@ -1,6 +1,7 @@
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
+#include "lcd_initseq.h"
 #include "ili9488.h"
 
 void     ili9488_Init(void);
@@ -21,6 +22,8 @@ void     ili9488_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint
 void     ili9488_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
 void     ili9488_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix); 
 void     ili9488_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     ili9488_SetOrientation(uint8_t Orientation);
+uint32_t ili9488_InitStep(void);
 
 LCD_DrvTypeDef   ili9488_drv =
 {
@@ -41,14 +44,21 @@ LCD_DrvTypeDef   ili9488_drv =
   ili9488_FillRect,
   ili9488_ReadRGBImage,
   ili9488_Scroll,
-  ili9488_UserCommand
+  ili9488_UserCommand,
+  ili9488_SetOrientation,
+  ili9488_InitStep,
+  NULL,
+  NULL,
+  NULL
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &ili9488_drv;
+#endif
 
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -141,28 +151,27 @@ union
   { transdata.d16[0] = x; transdata.d16[1] = transdata.d16[0]; LCD_IO_WriteCmd8MultipleData16(ILI9488_CASET, (uint16_t *)&transdata, 2); \
     transdata.d16[0] = y; transdata.d16[1] = transdata.d16[0]; LCD_IO_WriteCmd8MultipleData16(ILI9488_PASET, (uint16_t *)&transdata, 2); }
 
-/* the drawing directions of the 4 orientations */
-#if ILI9488_ORIENTATION == 0
-#define ILI9488_MAX_X                      (ILI9488_LCD_PIXEL_WIDTH - 1)
-#define ILI9488_MAX_Y                      (ILI9488_LCD_PIXEL_HEIGHT - 1)
-#define ILI9488_MAD_DATA_RIGHT_THEN_UP     (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_UP)
-#define ILI9488_MAD_DATA_RIGHT_THEN_DOWN   (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_DOWN)
-#elif ILI9488_ORIENTATION == 1
-#define ILI9488_MAX_X                      (ILI9488_LCD_PIXEL_HEIGHT - 1)
-#define ILI9488_MAX_Y                      (ILI9488_LCD_PIXEL_WIDTH - 1)
-#define ILI9488_MAD_DATA_RIGHT_THEN_UP     (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_DOWN | ILI9488_MAD_VERTICAL)
-#define ILI9488_MAD_DATA_RIGHT_THEN_DOWN   (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_DOWN | ILI9488_MAD_VERTICAL)
-#elif ILI9488_ORIENTATION == 2
-#define ILI9488_MAX_X                      (ILI9488_LCD_PIXEL_WIDTH - 1)
-#define ILI9488_MAX_Y                      (ILI9488_LCD_PIXEL_HEIGHT - 1)
-#define ILI9488_MAD_DATA_RIGHT_THEN_UP     (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_DOWN)
-#define ILI9488_MAD_DATA_RIGHT_THEN_DOWN   (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_UP)
-#elif ILI9488_ORIENTATION == 3
-#define ILI9488_MAX_X                      (ILI9488_LCD_PIXEL_HEIGHT - 1)
-#define ILI9488_MAX_Y                      (ILI9488_LCD_PIXEL_WIDTH - 1)
-#define ILI9488_MAD_DATA_RIGHT_THEN_UP     (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_UP   | ILI9488_MAD_VERTICAL)
-#define ILI9488_MAD_DATA_RIGHT_THEN_DOWN   (ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_UP   | ILI9488_MAD_VERTICAL)
-#endif
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint8_t  RightThenUp;                 /* MADCTL for right then up draw direction (bitmap) */
+  uint8_t  RightThenDown;               /* MADCTL for right then down draw direction */
+  uint8_t  ScrollTop;                   /* VSCRDEF top fix area parameter index (1 or 3) */
+  int8_t   ScrollDir;                   /* scroll direction */
+  uint8_t  Mirror;                      /* paralell interface coordinate mirror (bit0: x, bit1: y) */
+}ili9488_OrientTypeDef;
+
+static const ili9488_OrientTypeDef OrientTab[4] =
+{
+  {ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_UP,
+   ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_DOWN, 1, -1, 1},
+  {ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_DOWN | ILI9488_MAD_VERTICAL,
+   ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_DOWN | ILI9488_MAD_VERTICAL, 1, -1, 0},
+  {ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_DOWN,
+   ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_UP, 3, 1, 2},
+  {ILI9488_MAD_COLORMODE | ILI9488_MAD_X_LEFT  | ILI9488_MAD_Y_UP   | ILI9488_MAD_VERTICAL,
+   ILI9488_MAD_COLORMODE | ILI9488_MAD_X_RIGHT | ILI9488_MAD_Y_UP   | ILI9488_MAD_VERTICAL, 3, 1, 3}
+};
 
 #if ILI9488_INTERFACE == 0 || ILI9488_INTERFACE == 1
 static  uint16_t  yStart, yEnd;
@@ -171,19 +180,10 @@ static  uint16_t  yStart, yEnd;
 #define SETCURSOR(x, y)                    ILI9488_SETCURSOR(x, y)
 
 #elif ILI9488_INTERFACE == 2
-#if ILI9488_ORIENTATION == 0
-#define SETWINDOW(x1, x2, y1, y2)          ILI9488_SETWINDOW(ILI9488_MAX_X - (x2), ILI9488_MAX_X - (x1), y1, y2)
-#define SETCURSOR(x, y)                    ILI9488_SETCURSOR(ILI9488_MAX_X - (x), y)
-#elif ILI9488_ORIENTATION == 1
-#define SETWINDOW(x1, x2, y1, y2)          ILI9488_SETWINDOW(x1, x2, y1, y2)
-#define SETCURSOR(x, y)                    ILI9488_SETCURSOR(x, y)
-#elif ILI9488_ORIENTATION == 2
-#define SETWINDOW(x1, x2, y1, y2)          ILI9488_SETWINDOW(x1, x2, ILI9488_MAX_Y - (y2), ILI9488_MAX_Y - (y1))
-#define SETCURSOR(x, y)                    ILI9488_SETCURSOR(x, ILI9488_MAX_Y - (y))
-#elif ILI9488_ORIENTATION == 3
-#define SETWINDOW(x1, x2, y1, y2)          ILI9488_SETWINDOW(ILI9488_MAX_X - (x2), ILI9488_MAX_X - (x1), ILI9488_MAX_Y - (y2), ILI9488_MAX_Y - (y1))
-#define SETCURSOR(x, y)                    ILI9488_SETCURSOR(ILI9488_MAX_X - (x), ILI9488_MAX_Y - (y))
-#endif
+static  void ili9488_SetWindowMirror(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2);
+
+#define SETWINDOW(x1, x2, y1, y2)          ili9488_SetWindowMirror(x1, x2, y1, y2)
+#define SETCURSOR(x, y)                    ili9488_SetWindowMirror(x, x, y, y)
 #endif
 
 #ifndef LCD_REVERSE16
@@ -194,11 +194,34 @@ static  uint16_t  yStart, yEnd;
 #define ILI9488_IO_INITIALIZED     0x02
 static  uint8_t   Is_ili9488_Initialized = 0;
 
-const uint8_t EntryRightThenUp = ILI9488_MAD_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+/* actual orientation (see ILI9488_ORIENTATION, it can be changed with ili9488_SetOrientation) */
+static  const ili9488_OrientTypeDef * Orient = &OrientTab[ILI9488_ORIENTATION];
+static  uint16_t  SizeX = (ILI9488_ORIENTATION & 1) ? ILI9488_LCD_PIXEL_HEIGHT : ILI9488_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ILI9488_ORIENTATION & 1) ? ILI9488_LCD_PIXEL_WIDTH : ILI9488_LCD_PIXEL_HEIGHT;
+
+static uint8_t EntryRightThenUp = 0;
+static uint8_t EntryRightThenDown = 0;
 
 /* the last set drawing direction is stored here */
-uint8_t LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+static uint8_t LastEntry = 0;
+
+#if ILI9488_INTERFACE == 2
+//-----------------------------------------------------------------------------
+/* Set the window with the mirrored coordinates (see OrientTab Mirror) */
+static void ili9488_SetWindowMirror(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2)
+{
+  uint16_t t;
+  if(Orient->Mirror & 1)
+  {
+    t = x1; x1 = SizeX - 1 - x2; x2 = SizeX - 1 - t;
+  }
+  if(Orient->Mirror & 2)
+  {
+    t = y1; y1 = SizeY - 1 - y2; y2 = SizeY - 1 - t;
+  }
+  ILI9488_SETWINDOW(x1, x2, y1, y2);
+}
+#endif
 
 //-----------------------------------------------------------------------------
 /* Pixel draw and read functions */
@@ -208,7 +231,7 @@ uint8_t LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
 #define SetWriteDir()
 #define SetReadDir()
 #else /* #if ILI9488_WRITEBITDEPTH == ILI9488_READBITDEPTH */
-uint8_t lastdir = 0;
+static uint8_t lastdir = 0;
 #if ILI9488_WRITEBITDEPTH == 16
 /* 16/24 bit */
 #define SetWriteDir() {                                      \
@@ -282,57 +305,100 @@ uint8_t lastdir = 0;
 #endif /* #elif ILI9488_READBITDEPTH == 24 */
 
 //-----------------------------------------------------------------------------
-void ili9488_Init(void)
-{
-  if((Is_ili9488_Initialized & ILI9488_LCD_INITIALIZED) == 0)
-  {
-    Is_ili9488_Initialized |= ILI9488_LCD_INITIALIZED;
-    if((Is_ili9488_Initialized & ILI9488_IO_INITIALIZED) == 0)
-      LCD_IO_Init();
-    Is_ili9488_Initialized |= ILI9488_IO_INITIALIZED;
-  }
+/* Init sequence (see lcd_initseq.h) */
+#define INITFUNC_ORIENT       0
+#define INITFUNC_CLEAR        1
+#define INITFUNC_MADCTL       2
 
-  LCD_Delay(105);
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_SWRESET, NULL, 0);
-  LCD_Delay(5);
+static const uint8_t ili9488_InitSeq[] =
+{
+  LCD_INITSEQ_WAIT(105),
+  ILI9488_SWRESET, LCD_INITSEQ_DELAY | 0, 5,
+  LCD_INITSEQ_CALL(INITFUNC_ORIENT),
   // positive gamma control
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_GMCTRP1, (uint8_t *)"\x00\x01\x02\x04\x14\x09\x3F\x57\x4D\x05\x0B\x09\x1A\x1D\x0F", 15);
+  ILI9488_GMCTRP1, 15, 0x00, 0x01, 0x02, 0x04, 0x14, 0x09, 0x3F, 0x57, 0x4D, 0x05, 0x0B, 0x09, 0x1A, 0x1D, 0x0F,
   // negative gamma control
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_GMCTRN1, (uint8_t *)"\x00\x1D\x20\x02\x0E\x03\x35\x12\x47\x02\x0D\x0C\x38\x39\x0F", 15);
+  ILI9488_GMCTRN1, 15, 0x00, 0x1D, 0x20, 0x02, 0x0E, 0x03, 0x35, 0x12, 0x47, 0x02, 0x0D, 0x0C, 0x38, 0x39, 0x0F,
   // Power Control 1 (Vreg1out, Verg2out)
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_PWCTR1, (uint8_t *)"\x17\x15", 2);
-  LCD_Delay(5);
+  ILI9488_PWCTR1, LCD_INITSEQ_DELAY | 2, 0x17, 0x15, 5,
   // Power Control 2 (VGH,VGL)
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_PWCTR2, (uint8_t *)"\x41", 1);
-  LCD_Delay(5);
+  ILI9488_PWCTR2, LCD_INITSEQ_DELAY | 1, 0x41, 5,
   // Power Control 3 (Vcom)
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_VMCTR1, (uint8_t *)"\x00\x12\x80", 3);
-  LCD_Delay(5);
+  ILI9488_VMCTR1, LCD_INITSEQ_DELAY | 3, 0x00, 0x12, 0x80, 5,
   #if ILI9488_WRITEBITDEPTH == 16
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_PIXFMT, (uint8_t *)"\x55", 1);  // Interface Pixel Format (16 bit)
+  ILI9488_PIXFMT, 1, 0x55,               // Interface Pixel Format (16 bit)
   #elif ILI9488_WRITEBITDEPTH == 24
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_PIXFMT, (uint8_t *)"\x66", 1);  // Interface Pixel Format (24 bit)
+  ILI9488_PIXFMT, 1, 0x66,               // Interface Pixel Format (24 bit)
   #endif
   #if ILI9488_INTERFACE == 0
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_IMCTR, (uint8_t *)"\x80", 1);   // Interface Mode Control (SDO NOT USE)
+  ILI9488_IMCTR, 1, 0x80,                // Interface Mode Control (SDO NOT USE)
   #elif ILI9488_INTERFACE == 1
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_IMCTR, (uint8_t *)"\x00", 1);   // Interface Mode Control (SDO USE)
+  ILI9488_IMCTR, 1, 0x00,                // Interface Mode Control (SDO USE)
   #endif
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_FRMCTR1, (uint8_t *)"\xA0", 1); // Frame rate (60Hz)
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_INVCTR, (uint8_t *)"\x02", 1);  // Display Inversion Control (2-dot)
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_DFUNCTR, (uint8_t *)"\x02\x02", 2); // Display Function Control RGB/MCU Interface Control
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_IMGFUNCT, (uint8_t *)"\x01", 1); // Set Image Functio (Disable 24 bit data)
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_ADJCTR3, (uint8_t *)"\xA9\x51\x2C\x82", 4); // Adjust Control (D7 stream, loose)
-  LCD_Delay(5);
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_SLPOUT, NULL, 0); // Exit Sleep
-  LCD_Delay(120);
+  ILI9488_FRMCTR1, 1, 0xA0,              // Frame rate (60Hz)
+  ILI9488_INVCTR, 1, 0x02,               // Display Inversion Control (2-dot)
+  ILI9488_DFUNCTR, 2, 0x02, 0x02,        // Display Function Control RGB/MCU Interface Control
+  ILI9488_IMGFUNCT, 1, 0x01,             // Set Image Functio (Disable 24 bit data)
+  ILI9488_ADJCTR3, LCD_INITSEQ_DELAY | 4, 0xA9, 0x51, 0x2C, 0x82, 5, // Adjust Control (D7 stream, loose)
+  ILI9488_SLPOUT, LCD_INITSEQ_DELAY | 0, 120, // Exit Sleep
   #if ILI9488_INITCLEAR == 1
-  ili9488_FillRect(0, 0, ILI9488_MAX_X + 1, ILI9488_MAX_Y + 1, 0x0000);
-  LCD_Delay(1);
+  LCD_INITSEQ_CALL(INITFUNC_CLEAR),
+  LCD_INITSEQ_WAIT(1),
   #endif
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_DISPON, NULL, 0); // Display on
-  LCD_Delay(5);
-  LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
+  ILI9488_DISPON, LCD_INITSEQ_DELAY | 0, 5, // Display on
+  LCD_INITSEQ_CALL(INITFUNC_MADCTL),
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void ili9488_InitFunc(uint8_t Func)
+{
+  if(Func == INITFUNC_ORIENT)
+  {
+    EntryRightThenUp = Orient->RightThenUp;
+    EntryRightThenDown = Orient->RightThenDown;
+    LastEntry = EntryRightThenDown;
+  }
+  else if(Func == INITFUNC_MADCTL)
+    LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
+  #if ILI9488_INITCLEAR == 1
+  else if(Func == INITFUNC_CLEAR)
+    ili9488_FillRect(0, 0, SizeX, SizeY, 0x0000);
+  #endif
+}
+
+static void ili9488_InitStart(void)
+{
+  if((Is_ili9488_Initialized & ILI9488_LCD_INITIALIZED) == 0)
+  {
+    Is_ili9488_Initialized |= ILI9488_LCD_INITIALIZED;
+    if((Is_ili9488_Initialized & ILI9488_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
+      LCD_IO_Init();
+    Is_ili9488_Initialized |= ILI9488_IO_INITIALIZED;
+  }
+  LCD_InitSeqStart(&InitSeq, ili9488_InitSeq, ili9488_InitFunc, LCD_INITSEQ_CMD8);
+}
+
+//-----------------------------------------------------------------------------
+void ili9488_Init(void)
+{
+  ili9488_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t ili9488_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    ili9488_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -367,7 +433,7 @@ void ili9488_DisplayOff(void)
   */
 uint16_t ili9488_GetLcdPixelWidth(void)
 {
-  return ILI9488_MAX_X + 1;
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -378,7 +444,7 @@ uint16_t ili9488_GetLcdPixelWidth(void)
   */
 uint16_t ili9488_GetLcdPixelHeight(void)
 {
-  return ILI9488_MAX_Y + 1;
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -421,9 +487,9 @@ void ili9488_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void ili9488_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   SETCURSOR(Xpos, Ypos);
@@ -439,9 +505,9 @@ void ili9488_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t ili9488_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   SETCURSOR(Xpos, Ypos);
@@ -477,9 +543,9 @@ void ili9488_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
   */
 void ili9488_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   ili9488_FillRect(Xpos, Ypos, Length, 1, RGBCode);
@@ -496,9 +562,9 @@ void ili9488_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9488_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   ili9488_FillRect(Xpos, Ypos, 1, Length, RGBCode);
@@ -516,9 +582,9 @@ void ili9488_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9488_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   ili9488_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -547,14 +613,14 @@ void ili9488_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index)/2;
   pbmp += index;
 
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenUp, 1);
   }
   #if ILI9488_INTERFACE == 0 || ILI9488_INTERFACE == 1
-  transdata.d16[0] = ILI9488_MAX_Y - yEnd;
-  transdata.d16[1] = ILI9488_MAX_Y - yStart;
+  transdata.d16[0] = SizeY - 1 - yEnd;
+  transdata.d16[1] = SizeY - 1 - yStart;
   LCD_IO_WriteCmd8MultipleData16(ILI9488_PASET, &transdata, 2);
   LCD_IO_DrawBitmap(pbmp, size);
   #elif ILI9488_INTERFACE == 2
@@ -575,9 +641,9 @@ void ili9488_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void ili9488_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   ili9488_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -597,9 +663,9 @@ void ili9488_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void ili9488_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ILI9488_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ILI9488_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
   }
   ili9488_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -617,59 +683,19 @@ void ili9488_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
 void ili9488_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
   static uint16_t scrparam[4] = {0, 0, 0, 0};
-  #if (ILI9488_ORIENTATION == 0)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
+  uint8_t top = Orient->ScrollTop;      /* the top fix area can be the physical bottom */
+  if((TopFix != scrparam[top]) || (BottonFix != scrparam[4 - top]) || (scrparam[2] == 0))
   {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
+    scrparam[top] = TopFix;
+    scrparam[4 - top] = BottonFix;
     scrparam[2] = ILI9488_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
     LCD_IO_WriteCmd8MultipleData16(ILI9488_VSCRDEF, &scrparam[1], 3);
   }
-  Scroll = (0 - Scroll) % scrparam[2];
+  Scroll = (Scroll * Orient->ScrollDir) % scrparam[2];
   if(Scroll < 0)
     Scroll = scrparam[2] + Scroll + scrparam[1];
   else
     Scroll = Scroll + scrparam[1];
-  #elif (ILI9488_ORIENTATION == 1)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
-  {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
-    scrparam[2] = ILI9488_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ILI9488_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll = (0 - Scroll) % scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ILI9488_ORIENTATION == 2)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = ILI9488_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ILI9488_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ILI9488_ORIENTATION == 3)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = ILI9488_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ILI9488_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #endif
   if(Scroll != scrparam[0])
   {
     scrparam[0] = Scroll;
@@ -697,3 +723,25 @@ void ili9488_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_
   else if(Mode == 3)
     LCD_IO_ReadCmd8MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ILI9488_ORIENTATION)
+  * @retval None
+  */
+void ili9488_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ILI9488_LCD_PIXEL_HEIGHT : ILI9488_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ILI9488_LCD_PIXEL_WIDTH : ILI9488_LCD_PIXEL_HEIGHT;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  if(Is_ili9488_Initialized & ILI9488_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ILI9488_MADCTL, &EntryRightThenDown, 1);
+  }
+}
@@ -12,6 +12,7 @@
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
+#include "lcd_initseq.h"
 #include "st7735.h"
 
 void     st7735_Init(void);
@@ -32,6 +33,11 @@ void     st7735_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint1
 void     st7735_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
 void     st7735_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void     st7735_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     st7735_SetOrientation(uint8_t Orientation);
+uint32_t st7735_InitStep(void);
+uint16_t st7735_GetOffscreenLines(void);
+void     st7735_SetVisibleY(uint16_t Ypos);
+uint8_t  st7735_SetWriteBitDepth(uint8_t BitDepth);
 
 LCD_DrvTypeDef   st7735_drv =
 {
@@ -52,14 +58,21 @@ LCD_DrvTypeDef   st7735_drv =
   st7735_FillRect,
   st7735_ReadRGBImage,
   st7735_Scroll,
-  st7735_UserCommand
+  st7735_UserCommand,
+  st7735_SetOrientation,
+  st7735_InitStep,
+  st7735_GetOffscreenLines,
+  st7735_SetVisibleY,
+  st7735_SetWriteBitDepth
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &st7735_drv;
+#endif
 
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -139,31 +152,39 @@ union
 #define ST7735_MAD_COLORMODE  ST7735_MAD_BGR
 #endif
 
-#if (ST7735_ORIENTATION == 0)
-#define ST7735_SIZE_X                     ST7735_LCD_PIXEL_WIDTH
-#define ST7735_SIZE_Y                     ST7735_LCD_PIXEL_HEIGHT
-#define ST7735_MAD_DATA_RIGHT_THEN_UP     (ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_UP)
-#define ST7735_MAD_DATA_RIGHT_THEN_DOWN   (ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_DOWN)
-#elif (ST7735_ORIENTATION == 1)
-#define ST7735_SIZE_X                     ST7735_LCD_PIXEL_HEIGHT
-#define ST7735_SIZE_Y                     ST7735_LCD_PIXEL_WIDTH
-#define ST7735_MAD_DATA_RIGHT_THEN_UP     (ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_DOWN | ST7735_MAD_VERTICAL)
-#define ST7735_MAD_DATA_RIGHT_THEN_DOWN   (ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_DOWN | ST7735_MAD_VERTICAL)
-#elif (ST7735_ORIENTATION == 2)
-#define ST7735_SIZE_X                     ST7735_LCD_PIXEL_WIDTH
-#define ST7735_SIZE_Y                     ST7735_LCD_PIXEL_HEIGHT
-#define ST7735_MAD_DATA_RIGHT_THEN_UP     (ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_DOWN)
-#define ST7735_MAD_DATA_RIGHT_THEN_DOWN   (ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_UP)
-#elif (ST7735_ORIENTATION == 3)
-#define ST7735_SIZE_X                     ST7735_LCD_PIXEL_HEIGHT
-#define ST7735_SIZE_Y                     ST7735_LCD_PIXEL_WIDTH
-#define ST7735_MAD_DATA_RIGHT_THEN_UP     (ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_UP   | ST7735_MAD_VERTICAL)
-#define ST7735_MAD_DATA_RIGHT_THEN_DOWN   (ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_UP   | ST7735_MAD_VERTICAL)
-#endif
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint8_t  RightThenUp;                 /* MADCTL for right then up draw direction (bitmap) */
+  uint8_t  RightThenDown;               /* MADCTL for right then down draw direction */
+  uint8_t  ScrollTop;                   /* VSCRDEF top fix area parameter index (1 or 3) */
+  int8_t   ScrollDir;                   /* scroll direction */
+}st7735_OrientTypeDef;
+
+static const st7735_OrientTypeDef OrientTab[4] =
+{
+  {ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_UP,
+   ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_DOWN, 1, -1},
+  {ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_DOWN | ST7735_MAD_VERTICAL,
+   ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_DOWN | ST7735_MAD_VERTICAL, 1, -1},
+  {ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_DOWN,
+   ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_UP, 3, 1},
+  {ST7735_MAD_COLORMODE | ST7735_MAD_X_RIGHT | ST7735_MAD_Y_UP   | ST7735_MAD_VERTICAL,
+   ST7735_MAD_COLORMODE | ST7735_MAD_X_LEFT  | ST7735_MAD_Y_UP   | ST7735_MAD_VERTICAL, 3, 1}
+};
 
+#if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+/* off-screen GRAM rows */
+#define ST7735_OFFSCREEN      (ST7735_GRAM_HEIGHT - ST7735_LCD_PIXEL_HEIGHT)
+#define ST7735_GRAMROW(a, ofs) (((a) + (ofs)) % ST7735_GRAM_HEIGHT)
+#define ST7735_SETWINDOW(x1, x2, y1, y2) \
+  { transdata.d16[0] = ST7735_GRAMROW(x1, GramOfsX); transdata.d16[1] = ST7735_GRAMROW(x2, GramOfsX); LCD_IO_WriteCmd8MultipleData16(ST7735_CASET, (uint16_t *)&transdata, 2); \
+    transdata.d16[0] = ST7735_GRAMROW(y1, GramOfsY); transdata.d16[1] = ST7735_GRAMROW(y2, GramOfsY); LCD_IO_WriteCmd8MultipleData16(ST7735_PASET, (uint16_t *)&transdata, 2); }
+#else
 #define ST7735_SETWINDOW(x1, x2, y1, y2) \
   { transdata.d16[0] = x1; transdata.d16[1] = x2; LCD_IO_WriteCmd8MultipleData16(ST7735_CASET, (uint16_t *)&transdata, 2); \
     transdata.d16[0] = y1; transdata.d16[1] = y2; LCD_IO_WriteCmd8MultipleData16(ST7735_PASET, (uint16_t *)&transdata, 2); }
+#endif
 
 #define ST7735_SETCURSOR(x, y)            ST7735_SETWINDOW(x, x, y, y)
 
@@ -172,21 +193,54 @@ union
 #define ST7735_IO_INITIALIZED     0x02
 static  uint8_t   Is_st7735_Initialized = 0;
 
-const uint8_t EntryRightThenUp = ST7735_MAD_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+/* actual orientation (see ST7735_ORIENTATION, it can be changed with st7735_SetOrientation) */
+static  const st7735_OrientTypeDef * Orient = &OrientTab[ST7735_ORIENTATION];
+static  uint16_t  SizeX = (ST7735_ORIENTATION & 1) ? ST7735_LCD_PIXEL_HEIGHT : ST7735_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ST7735_ORIENTATION & 1) ? ST7735_LCD_PIXEL_WIDTH : ST7735_LCD_PIXEL_HEIGHT;
+
+static uint8_t EntryRightThenUp = 0;
+static uint8_t EntryRightThenDown = 0;
 
 /* the last set drawing direction is stored here */
-uint16_t LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+static uint16_t LastEntry = 0;
 
 static  uint16_t  yStart, yEnd;
 
+#if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+/* GRAM row offset of the x and y addresses (MY = 1: the panel is at the end of the reversed GRAM rows)
+   and the y address of the DrawBitmap (right then up) */
+static  uint16_t  GramOfsX, GramOfsY, GramOfsUp;
+
+static void st7735_GramOffset(void)
+{
+  uint16_t ofs = (EntryRightThenDown & ST7735_MAD_Y_UP) ? ST7735_OFFSCREEN : 0;
+  if(EntryRightThenDown & ST7735_MAD_VERTICAL)
+  { /* the GRAM rows are the x addresses */
+    GramOfsX = ofs;
+    GramOfsY = 0;
+    GramOfsUp = 0;
+  }
+  else
+  {
+    GramOfsX = 0;
+    GramOfsY = ofs;
+    GramOfsUp = ST7735_OFFSCREEN - ofs;
+  }
+}
+#endif
+
 //-----------------------------------------------------------------------------
+#if ST7735_WRITEBITDEPTH == 12
+/* 12 bit write mode (it can be switched to 16 bit in runtime: st7735_SetWriteBitDepth) */
+static uint8_t WriteBitDepth = 12;
+#endif
+
 #if ST7735_WRITEBITDEPTH == ST7735_READBITDEPTH
 /* 16/16 and 24/24 bit, no need to change bitdepth data */
 #define SetWriteDir()
 #define SetReadDir()
 #else /* #if ST7735_WRITEBITDEPTH == ST7735_READBITDEPTH */
-uint8_t lastdir = 0;
+static uint8_t lastdir = 0;
 #if ST7735_WRITEBITDEPTH == 16
 /* 16/24 bit */
 #define SetWriteDir() {                                     \
@@ -215,7 +269,26 @@ uint8_t lastdir = 0;
     LCD_IO_WriteCmd8MultipleData8(ST7735_COLMOD, "\55", 1); \
     lastdir = 1;                                            \
   }                                                         }
-#endif /* #elif ST7735_WRITEBITDEPTH == 24 */
+#elif ST7735_WRITEBITDEPTH == 12
+/* 12(16)/16 or 12(16)/24 bit */
+#if ST7735_READBITDEPTH == 16
+#define  ST7735_READPIXFMT  "\55"
+#elif ST7735_READBITDEPTH == 24
+#define  ST7735_READPIXFMT  "\66"
+#endif
+#define SetWriteDir() {                                      \
+  if(lastdir != 0)                                           \
+  {                                                          \
+    LCD_IO_WriteCmd8MultipleData8(ST7735_COLMOD, ((WriteBitDepth == 12) ? "\53" : "\55"), 1); \
+    lastdir = 0;                                             \
+  }                                                          }
+#define SetReadDir() {                                       \
+  if(lastdir == 0)                                           \
+  {                                                          \
+    LCD_IO_WriteCmd8MultipleData8(ST7735_COLMOD, ST7735_READPIXFMT, 1); \
+    lastdir = 1;                                             \
+  }                                                          }
+#endif /* #elif ST7735_WRITEBITDEPTH == 12 */
 #endif /* #else ST7735_WRITEBITDEPTH == ST7735_READBITDEPTH */
 
 #if ST7735_WRITEBITDEPTH == 16
@@ -232,7 +305,20 @@ uint8_t lastdir = 0;
 #define  LCD_IO_DrawBitmap(pData, Size) { \
   SetWriteDir(); \
   LCD_IO_WriteCmd8MultipleData16to24(ST7735_RAMWR, pData, Size); }   /* Draw 24 bit Lcd bitmap from 16 bit bitmap data */
-#endif /* #elif ST7735_WRITEBITDEPTH == 24 */
+#elif ST7735_WRITEBITDEPTH == 12
+#define  LCD_IO_DrawFill(Color, Size) { \
+  SetWriteDir(); \
+  if(WriteBitDepth == 12) \
+    LCD_IO_WriteCmd8DataFill16to12(ST7735_RAMWR, Color, Size); \
+  else \
+    LCD_IO_WriteCmd8DataFill16(ST7735_RAMWR, Color, Size); }          /* Fill 12 (or 16) bit pixel(s) from 16 bit color code */
+#define  LCD_IO_DrawBitmap(pData, Size) { \
+  SetWriteDir(); \
+  if(WriteBitDepth == 12) \
+    LCD_IO_WriteCmd8MultipleData16to12(ST7735_RAMWR, pData, Size); \
+  else \
+    LCD_IO_WriteCmd8MultipleData16(ST7735_RAMWR, pData, Size); }      /* Draw 12 (or 16) bit Lcd bitmap from 16 bit bitmap data */
+#endif /* #elif ST7735_WRITEBITDEPTH == 12 */
 
 #if ST7735_READBITDEPTH == 16
 #define  LCD_IO_ReadBitmap(pData, Size) { \
@@ -245,59 +331,119 @@ uint8_t lastdir = 0;
 #endif /* #elif ST7735_READBITDEPTH == 24 */
 
 //-----------------------------------------------------------------------------
-void st7735_Init(void)
-{
-  if((Is_st7735_Initialized & ST7735_LCD_INITIALIZED) == 0)
-  {
-    Is_st7735_Initialized |= ST7735_LCD_INITIALIZED;
-    if((Is_st7735_Initialized & ST7735_IO_INITIALIZED) == 0)
-      LCD_IO_Init();
-    Is_st7735_Initialized |= ST7735_IO_INITIALIZED;
-  }
+/* Init sequence (see lcd_initseq.h) */
+#define INITFUNC_ORIENT       0
+#define INITFUNC_CLEAR        1
 
-  LCD_Delay(1);
-  LCD_IO_WriteCmd8MultipleData8(ST7735_SWRESET, NULL, 0);
-  LCD_Delay(1);
+static const uint8_t st7735_InitSeq[] =
+{
+  LCD_INITSEQ_WAIT(1),
+  ST7735_SWRESET, LCD_INITSEQ_DELAY | 0, 1,
 
   // positive gamma control
-  LCD_IO_WriteCmd8MultipleData8(ST7735_GMCTRP1, (uint8_t *)"\x09\x16\x09\x20\x21\x1B\x13\x19\x17\x15\x1E\x2B\x04\x05\x02\x0E", 16);
+  ST7735_GMCTRP1, 16, 0x09, 0x16, 0x09, 0x20, 0x21, 0x1B, 0x13, 0x19, 0x17, 0x15, 0x1E, 0x2B, 0x04, 0x05, 0x02, 0x0E,
 
   // negative gamma control
-  LCD_IO_WriteCmd8MultipleData8(ST7735_GMCTRN1, (uint8_t *)"\x0B\x14\x08\x1E\x22\x1D\x18\x1E\x1B\x1A\x24\x2B\x06\x06\x02\x0F", 16);
+  ST7735_GMCTRN1, 16, 0x0B, 0x14, 0x08, 0x1E, 0x22, 0x1D, 0x18, 0x1E, 0x1B, 0x1A, 0x24, 0x2B, 0x06, 0x06, 0x02, 0x0F,
 
   // Power Control 1 (Vreg1out, Verg2out)
-  LCD_IO_WriteCmd8MultipleData8(ST7735_PWCTR1, (uint8_t *)"\x17\x15", 2);
+  ST7735_PWCTR1, 2, 0x17, 0x15,
 
   // Power Control 2 (VGH,VGL)
-  LCD_IO_WriteCmd8MultipleData8(ST7735_PWCTR2, (uint8_t *)"\x41", 1);
+  ST7735_PWCTR2, 1, 0x41,
 
   // Power Control 3 (Vcom)
-  LCD_IO_WriteCmd8MultipleData8(ST7735_VMCTR1, (uint8_t *)"\x00\x12\x80", 3);
+  ST7735_VMCTR1, 3, 0x00, 0x12, 0x80,
 
   #if ST7735_WRITEBITDEPTH == 16
-  LCD_IO_WriteCmd8MultipleData8(ST7735_COLMOD, (uint8_t *)"\x55", 1); // Interface Pixel Format (16 bit)
+  ST7735_COLMOD, 1, 0x55,                // Interface Pixel Format (16 bit)
   #elif ST7735_WRITEBITDEPTH == 24
-  LCD_IO_WriteCmd8MultipleData8(ST7735_COLMOD, (uint8_t *)"\x66", 1); // Interface Pixel Format (16 bit)
+  ST7735_COLMOD, 1, 0x66,                // Interface Pixel Format (24 bit)
+  #elif ST7735_WRITEBITDEPTH == 12
+  ST7735_COLMOD, 1, 0x53,                // Interface Pixel Format (12 bit)
   #endif
 
   #if ST7735_SPIMODE == 0
-  LCD_IO_WriteCmd8MultipleData8(0xB0, (uint8_t *)"\x80", 1); // Interface Mode Control (SDO NOT USE)
+  0xB0, 1, 0x80,                         // Interface Mode Control (SDO NOT USE)
   #elif ST7735_SPIMODE == 1
-  LCD_IO_WriteCmd8MultipleData8(0xB0, (uint8_t *)"\x00", 1); // Interface Mode Control (SDO USE)
+  0xB0, 1, 0x00,                         // Interface Mode Control (SDO USE)
   #endif
-  LCD_IO_WriteCmd8MultipleData8(0xB1, (uint8_t *)"\xA0", 1);// Frame rate (60Hz)
-  LCD_IO_WriteCmd8MultipleData8(0xB4, (uint8_t *)"\x02", 1);// Display Inversion Control (2-dot)
-  LCD_IO_WriteCmd8MultipleData8(0xB6, (uint8_t *)"\x02\x02", 2); // Display Function Control RGB/MCU Interface Control
-  LCD_IO_WriteCmd8MultipleData8(0xE9, (uint8_t *)"\x00", 1);// Set Image Functio (Disable 24 bit data)
-  LCD_IO_WriteCmd8MultipleData8(0xF7, (uint8_t *)"\xA9\x51\x2C\x82", 4);// Adjust Control (D7 stream, loose)
+  0xB1, 1, 0xA0,                         // Frame rate (60Hz)
+  0xB4, 1, 0x02,                         // Display Inversion Control (2-dot)
+  0xB6, 2, 0x02, 0x02,                   // Display Function Control RGB/MCU Interface Control
+  0xE9, 1, 0x00,                         // Set Image Functio (Disable 24 bit data)
+  0xF7, 4, 0xA9, 0x51, 0x2C, 0x82,       // Adjust Control (D7 stream, loose)
+
+  LCD_INITSEQ_CALL(INITFUNC_ORIENT),     // MADCTL
+  ST7735_SLPOUT, 0,                      // Exit Sleep
+  #if ST7735_INITCLEAR == 1
+  LCD_INITSEQ_CALL(INITFUNC_CLEAR),
+  LCD_INITSEQ_WAIT(10),
+  #endif
+  ST7735_DISPON, 0,                      // Display on
+  LCD_INITSEQ_END
+};
 
-  LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
-  LCD_IO_WriteCmd8MultipleData8(ST7735_SLPOUT, NULL, 0);    // Exit Sleep
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void st7735_InitFunc(uint8_t Func)
+{
+  if(Func == INITFUNC_ORIENT)
+  {
+    EntryRightThenUp = Orient->RightThenUp;
+    EntryRightThenDown = Orient->RightThenDown;
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
+    #if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+    st7735_GramOffset();
+    #endif
+  }
   #if ST7735_INITCLEAR == 1
-  st7735_FillRect(0, 0, ST7735_SIZE_X, ST7735_SIZE_Y, 0x0000);
-  LCD_Delay(10);
+  else if(Func == INITFUNC_CLEAR)
+  {
+    st7735_FillRect(0, 0, SizeX, SizeY, 0x0000);
+    #if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+    if(st7735_GetOffscreenLines())
+      st7735_FillRect(0, SizeY, SizeX, ST7735_OFFSCREEN, 0x0000);
+    #endif
+  }
+  #endif
+}
+
+static void st7735_InitStart(void)
+{
+  if((Is_st7735_Initialized & ST7735_LCD_INITIALIZED) == 0)
+  {
+    Is_st7735_Initialized |= ST7735_LCD_INITIALIZED;
+    if((Is_st7735_Initialized & ST7735_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
+      LCD_IO_Init();
+    Is_st7735_Initialized |= ST7735_IO_INITIALIZED;
+  }
+  #if ST7735_WRITEBITDEPTH == 12
+  lastdir = 1;                          /* the init sequence sets the 12 bit mode, the actual write mode is set before the first drawing */
   #endif
-  LCD_IO_WriteCmd8MultipleData8(ST7735_DISPON, NULL, 0);    // Display on
+  LCD_InitSeqStart(&InitSeq, st7735_InitSeq, st7735_InitFunc, LCD_INITSEQ_CMD8);
+}
+
+//-----------------------------------------------------------------------------
+void st7735_Init(void)
+{
+  st7735_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t st7735_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    st7735_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -332,7 +478,7 @@ void st7735_DisplayOff(void)
   */
 uint16_t st7735_GetLcdPixelWidth(void)
 {
-  return ST7735_SIZE_X;
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -343,7 +489,7 @@ uint16_t st7735_GetLcdPixelWidth(void)
   */
 uint16_t st7735_GetLcdPixelHeight(void)
 {
-  return ST7735_SIZE_Y;
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -381,9 +527,9 @@ void st7735_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void st7735_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   ST7735_SETCURSOR(Xpos, Ypos);
@@ -400,9 +546,9 @@ void st7735_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t st7735_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   ST7735_SETCURSOR(Xpos, Ypos);
@@ -436,9 +582,9 @@ void st7735_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint1
   */
 void st7735_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   ST7735_SETWINDOW(Xpos, Xpos + Length - 1, Ypos, Ypos);
@@ -456,9 +602,9 @@ void st7735_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t L
   */
 void st7735_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   ST7735_SETWINDOW(Xpos, Xpos, Ypos, Ypos + Length - 1);
@@ -477,9 +623,9 @@ void st7735_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t L
   */
 void st7735_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   ST7735_SETWINDOW(Xpos, Xpos + Xsize - 1, Ypos, Ypos + Ysize - 1);
@@ -507,13 +653,18 @@ void st7735_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index)/2;
   pbmp += index;
 
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenUp, 1);
   }
-  transdata.d16[0] = ST7735_SIZE_Y - 1 - yEnd;
-  transdata.d16[1] = ST7735_SIZE_Y - 1 - yStart;
+  #if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+  transdata.d16[0] = ST7735_GRAMROW(ST7735_GRAM_HEIGHT + SizeY - 1 - yEnd, GramOfsUp);
+  transdata.d16[1] = ST7735_GRAMROW(ST7735_GRAM_HEIGHT + SizeY - 1 - yStart, GramOfsUp);
+  #else
+  transdata.d16[0] = SizeY - 1 - yEnd;
+  transdata.d16[1] = SizeY - 1 - yStart;
+  #endif
   LCD_IO_WriteCmd8MultipleData16(ST7735_PASET, &transdata, 2);
   LCD_IO_DrawBitmap(pbmp, size);
 }
@@ -531,9 +682,9 @@ void st7735_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void st7735_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   st7735_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -553,9 +704,9 @@ void st7735_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void st7735_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ST7735_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7735_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
   }
   st7735_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -574,59 +725,26 @@ void st7735_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
   static uint16_t scrparam[4] = {0, 0, 0, 0};
   // Scroll = Scroll % ST7735_LCD_PIXEL_HEIGHT;
-  #if (ST7735_ORIENTATION == 0)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
-  {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
-    scrparam[2] = ST7735_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ST7735_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll = (0 - Scroll) % scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ST7735_ORIENTATION == 1)
-  if((TopFix != scrparam[1]) || (BottonFix != scrparam[3]))
-  {
-    scrparam[1] = TopFix;
-    scrparam[3] = BottonFix;
-    scrparam[2] = ST7735_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ST7735_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll = (0 - Scroll) % scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ST7735_ORIENTATION == 2)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
-  {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = ST7735_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
-    LCD_IO_WriteCmd8MultipleData16(ST7735_VSCRDEF, &scrparam[1], 3);
-  }
-  Scroll %= scrparam[2];
-  if(Scroll < 0)
-    Scroll = scrparam[2] + Scroll + scrparam[1];
-  else
-    Scroll = Scroll + scrparam[1];
-  #elif (ST7735_ORIENTATION == 3)
-  if((TopFix != scrparam[3]) || (BottonFix != scrparam[1]))
+  uint8_t top = Orient->ScrollTop;      /* the top fix area can be the physical bottom */
+  #if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+  /* the off-screen rows are at the physical bottom: in the bottom fix area if it is not empty, else in the scroll area */
+  if(top == 3 && TopFix)
+    TopFix += ST7735_OFFSCREEN;
+  else if(top == 1 && BottonFix)
+    BottonFix += ST7735_OFFSCREEN;
+  #endif
+  if((TopFix != scrparam[top]) || (BottonFix != scrparam[4 - top]) || (scrparam[2] == 0))
   {
-    scrparam[3] = TopFix;
-    scrparam[1] = BottonFix;
-    scrparam[2] = ST7735_LCD_PIXEL_HEIGHT - TopFix - BottonFix;
+    scrparam[top] = TopFix;
+    scrparam[4 - top] = BottonFix;
+    scrparam[2] = ST7735_GRAM_HEIGHT - TopFix - BottonFix;
     LCD_IO_WriteCmd8MultipleData16(ST7735_VSCRDEF, &scrparam[1], 3);
   }
-  Scroll %= scrparam[2];
+  Scroll = (Scroll * Orient->ScrollDir) % scrparam[2];
   if(Scroll < 0)
     Scroll = scrparam[2] + Scroll + scrparam[1];
   else
     Scroll = Scroll + scrparam[1];
-  #endif
   if(Scroll != scrparam[0])
   {
     scrparam[0] = Scroll;
@@ -654,3 +772,80 @@ void st7735_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_t
   else if(Mode == 3)
     LCD_IO_ReadCmd8MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ST7735_ORIENTATION)
+  * @retval None
+  */
+void st7735_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ST7735_LCD_PIXEL_HEIGHT : ST7735_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ST7735_LCD_PIXEL_WIDTH : ST7735_LCD_PIXEL_HEIGHT;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  #if ST7735_GRAM_HEIGHT > ST7735_LCD_PIXEL_HEIGHT
+  st7735_GramOffset();
+  #endif
+  if(Is_st7735_Initialized & ST7735_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ST7735_MADCTL, &EntryRightThenDown, 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Get the number of the off-screen GRAM rows (see ST7735_GRAM_HEIGHT)
+  * @param  None
+  * @retval rows after the visible area (0 = none, or landscape orientation)
+  */
+uint16_t st7735_GetOffscreenLines(void)
+{
+  if(Orient->RightThenDown & ST7735_MAD_VERTICAL)
+    return 0;
+  return ST7735_GRAM_HEIGHT - ST7735_LCD_PIXEL_HEIGHT;
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the first visible row (the visible rows: Ypos..Ypos+SizeY-1, modulo SizeY + off-screen rows)
+  * @param  Ypos : first visible row
+  * @retval None
+  * @note   It sets the scroll area to the full GRAM (no fix area)
+  */
+void st7735_SetVisibleY(uint16_t Ypos)
+{
+  if(st7735_GetOffscreenLines() == 0)
+    return;
+  /* MY = 1: the y rows are in reverse order in the GRAM */
+  if(EntryRightThenDown & ST7735_MAD_Y_UP)
+    st7735_Scroll(-(int16_t)Ypos * Orient->ScrollDir, 0, 0);
+  else
+    st7735_Scroll((int16_t)Ypos * Orient->ScrollDir, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the write bitdepth in runtime (only if ST7735_WRITEBITDEPTH == 12)
+  * @param  BitDepth : 12 (RGB444) or 16 (RGB565)
+  * @retval the active write bitdepth
+  */
+uint8_t st7735_SetWriteBitDepth(uint8_t BitDepth)
+{
+  #if ST7735_WRITEBITDEPTH == 12
+  if((BitDepth == 12 || BitDepth == 16) && BitDepth != WriteBitDepth)
+  {
+    WriteBitDepth = BitDepth;
+    lastdir = 1;                        /* the COLMOD is sent before the next drawing */
+  }
+  return WriteBitDepth;
+  #else
+  (void)BitDepth;
+  return ST7735_WRITEBITDEPTH;
+  #endif
+}
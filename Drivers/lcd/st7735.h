@@ -20,11 +20,21 @@
    - 1: clear */
 #define  ST7735_INITCLEAR         1
 
-/* Draw and read bitdeph (16: RGB565, 24: RGB888)
-   note: my ST7735 LCD only readable if ST7735_READBITDEPTH 24 */
+/* Draw and read bitdeph (16: RGB565, 24: RGB888, write only 12: RGB444)
+   note: my ST7735 LCD only readable if ST7735_READBITDEPTH 24
+   note: the 12 bit write mode needs the LCD_IO_DATA16TO12 io support (io_spi/lcd_io_spi_hal, io_host),
+         the write bitdepth can be switched between 12 and 16 in runtime (BSP_LCD_SetWriteBitDepth) */
 #define  ST7735_WRITEBITDEPTH     16
 #define  ST7735_READBITDEPTH      24
 
 /* Physical resolution in default orientation */
 #define  ST7735_LCD_PIXEL_WIDTH   128
 #define  ST7735_LCD_PIXEL_HEIGHT  160
+
+/* GRAM height (the ST7735 GRAM is 132x162, the smaller panels show only a part of it, e.g. 128x128)
+   - ST7735_LCD_PIXEL_HEIGHT: the GRAM rows after the panel are not used (default)
+   - 162 (or 160 with the GM = 11 controller setting): the rows after the panel are off-screen rows, they can be
+          drawn and scrolled into the view in the portrait orientations (see BSP_LCD_GetOffscreenLines,
+          BSP_LCD_SetVisibleY), and the GRAM row offset of the MY = 1 orientations is also set with it
+   note: the panel must be connected to the first gate lines (GRAM rows 0..ST7735_LCD_PIXEL_HEIGHT-1) */
+#define  ST7735_GRAM_HEIGHT       ST7735_LCD_PIXEL_HEIGHT
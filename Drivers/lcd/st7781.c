@@ -1,6 +1,7 @@
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
+#include "lcd_initseq.h"
 #include "st7781.h"
 
 // Lcd
@@ -22,6 +23,8 @@ void      st7781_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint
 void      st7781_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
 void      st7781_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void      st7781_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void      st7781_SetOrientation(uint8_t Orientation);
+uint32_t  st7781_InitStep(void);
 
 // Touchscreen
 void      st7781_ts_Init(uint16_t DeviceAddr);
@@ -47,13 +50,20 @@ LCD_DrvTypeDef   st7781_drv =
   st7781_FillRect,
   st7781_ReadRGBImage,
   st7781_Scroll,
-  st7781_UserCommand
+  st7781_UserCommand,
+  st7781_SetOrientation,
+  st7781_InitStep,
+  NULL,
+  NULL,
+  NULL
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &st7781_drv;
+#endif
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -130,70 +140,61 @@ union
 #define ST7781_ENTRY_COLORMODE    ST7781_ENTRY_BGR
 #endif
 
-#if ST7781_ORIENTATION == 0
-#define ST7781_XSIZE                      ST7781_LCD_PIXEL_WIDTH
-#define ST7781_YSIZE                      ST7781_LCD_PIXEL_HEIGHT
-#define ST7781_ENTRY_DATA_RIGHT_THEN_UP   (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_UP)
-#define ST7781_ENTRY_DATA_RIGHT_THEN_DOWN (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN)
-#define ST7781_ENTRY_DATA_DOWN_THEN_RIGHT (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL)
-#define ST7781_DRIV_OUT_CTRL_DATA         0x0100
-#define ST7781_GATE_SCAN_CTRL1_DATA       0xA700
-#define ST7781_SETCURSOR(x, y)            {transdata.d16[0] = x;\
-                                           LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_HOR_AD, &transdata, 1);\
-                                           transdata.d16[0] = y;\
-                                           LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_VER_AD, &transdata, 1);}
-#elif ST7781_ORIENTATION == 1
-#define ST7781_XSIZE                      ST7781_LCD_PIXEL_HEIGHT
-#define ST7781_YSIZE                      ST7781_LCD_PIXEL_WIDTH
-#define ST7781_ENTRY_DATA_RIGHT_THEN_UP   (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_LEFT  | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL)
-#define ST7781_ENTRY_DATA_RIGHT_THEN_DOWN (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL)
-#define ST7781_ENTRY_DATA_DOWN_THEN_RIGHT (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN)
-#define ST7781_DRIV_OUT_CTRL_DATA         0x0000
-#define ST7781_GATE_SCAN_CTRL1_DATA       0xA700
-#define ST7781_SETCURSOR(x, y)            {transdata.d16[0] = y;\
-                                           LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_HOR_AD, &transdata, 1);\
-                                           transdata.d16[0] = x;\
-                                           LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_VER_AD, &transdata, 1);}
-#elif ST7781_ORIENTATION == 2
-#define ST7781_XSIZE                      ST7781_LCD_PIXEL_WIDTH
-#define ST7781_YSIZE                      ST7781_LCD_PIXEL_HEIGHT
-#define ST7781_ENTRY_DATA_RIGHT_THEN_UP   (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_UP)
-#define ST7781_ENTRY_DATA_RIGHT_THEN_DOWN (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN)
-#define ST7781_ENTRY_DATA_DOWN_THEN_RIGHT (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL)
-#define ST7781_DRIV_OUT_CTRL_DATA         0x0000
-#define ST7781_GATE_SCAN_CTRL1_DATA       0x2700
-#define ST7781_SETCURSOR(x, y)            {transdata.d16[0] = x;\
-                                           LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_HOR_AD, &transdata, 1);\
-                                           transdata.d16[0] = y;\
-                                           LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_VER_AD, &transdata, 1);}
-#elif ST7781_ORIENTATION == 3
-#define ST7781_XSIZE                      ST7781_LCD_PIXEL_HEIGHT
-#define ST7781_YSIZE                      ST7781_LCD_PIXEL_WIDTH
-#define ST7781_ENTRY_DATA_RIGHT_THEN_UP   (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_LEFT  | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL)
-#define ST7781_ENTRY_DATA_RIGHT_THEN_DOWN (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL)
-#define ST7781_ENTRY_DATA_DOWN_THEN_RIGHT (ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN)
-#define ST7781_DRIV_OUT_CTRL_DATA         0x0100
-#define ST7781_GATE_SCAN_CTRL1_DATA       0x2700
-#define ST7781_SETCURSOR(x, y)            {transdata.d16[0] = y;\
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint16_t RightThenUp;                 /* entry mode for right then up draw direction (bitmap) */
+  uint16_t RightThenDown;               /* entry mode for right then down draw direction */
+  uint16_t DownThenRight;               /* entry mode for down then right draw direction (vertical line) */
+  uint16_t DrivOutCtrl;                 /* driver output control (source scan direction) */
+  uint16_t GateScanCtrl1;               /* gate scan control (gate scan direction) */
+  uint8_t  SwapXY;                      /* 1: the x coordinate is the GRAM vertical address */
+}st7781_OrientTypeDef;
+
+static const st7781_OrientTypeDef OrientTab[4] =
+{
+  {ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_UP,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL,
+   0x0100, 0xA700, 0},
+  {ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_LEFT  | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN,
+   0x0000, 0xA700, 1},
+  {ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_UP,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL,
+   0x0000, 0x2700, 0},
+  {ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_LEFT  | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN | ST7781_ENTRY_VERTICAL,
+   ST7781_ENTRY_COLORMODE | ST7781_ENTRY_X_RIGHT | ST7781_ENTRY_Y_DOWN,
+   0x0100, 0x2700, 1}
+};
+
+#define ST7781_SETCURSOR(x, y)            {transdata.d16[0] = Orient->SwapXY ? y : x;\
                                            LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_HOR_AD, &transdata, 1);\
-                                           transdata.d16[0] = x;\
+                                           transdata.d16[0] = Orient->SwapXY ? x : y;\
                                            LCD_IO_WriteCmd16MultipleData16(ST7781_GRAM_VER_AD, &transdata, 1);}
-#endif
 
 #ifndef LCD_REVERSE16
 #define LCD_REVERSE16    0
 #endif
 
-const uint16_t DrivOutCtrlData = ST7781_DRIV_OUT_CTRL_DATA;
-const uint16_t EntryRightThenUp = ST7781_ENTRY_DATA_RIGHT_THEN_UP;
-const uint16_t EntryRightThenDown = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
-const uint16_t EntryDownThenRight = ST7781_ENTRY_DATA_DOWN_THEN_RIGHT;
-const uint16_t LcdPixelWidth = ST7781_LCD_PIXEL_WIDTH - 1;
-const uint16_t LcdPixelHeight = ST7781_LCD_PIXEL_HEIGHT - 1;
-const uint16_t GateScanCtrl1Data = ST7781_GATE_SCAN_CTRL1_DATA;
+/* actual orientation (see ST7781_ORIENTATION, it can be changed with st7781_SetOrientation) */
+static  const st7781_OrientTypeDef * Orient = &OrientTab[ST7781_ORIENTATION];
+static  uint16_t  SizeX = (ST7781_ORIENTATION & 1) ? ST7781_LCD_PIXEL_HEIGHT : ST7781_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ST7781_ORIENTATION & 1) ? ST7781_LCD_PIXEL_WIDTH : ST7781_LCD_PIXEL_HEIGHT;
+
+static uint16_t DrivOutCtrlData = 0;
+static uint16_t EntryRightThenUp = 0;
+static uint16_t EntryRightThenDown = 0;
+static uint16_t EntryDownThenRight = 0;
+static const uint16_t LcdPixelWidth = ST7781_LCD_PIXEL_WIDTH - 1;
+static const uint16_t LcdPixelHeight = ST7781_LCD_PIXEL_HEIGHT - 1;
+static uint16_t GateScanCtrl1Data = 0;
 
 /* the last set drawing direction is stored here */
-uint16_t LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+static uint16_t LastEntry = 0;
 
 //-----------------------------------------------------------------------------
 /* Pixel draw and read functions */
@@ -215,68 +216,126 @@ uint16_t LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
 #endif
 
 //-----------------------------------------------------------------------------
-void st7781_Init(void)
+/* Init sequence (see lcd_initseq.h, the LCD_INITSEQ_CALL parameter is the register) */
+static const uint8_t st7781_InitSeq[] =
 {
-  LCD_IO_Init();
-
-  LCD_IO_WriteCmd16MultipleData8(0xF3, "\x00\x08", 2);
+  0xF3, 2, 0x00, 0x08,
 
-  LCD_Delay(5);
+  LCD_INITSEQ_WAIT(5),
 
-  LCD_IO_WriteCmd16MultipleData16(ST7781_DRIV_OUT_CTRL, &DrivOutCtrlData, 1);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_DRIV_WAV_CTRL, "\x07\x00", 2);
-  LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
+  LCD_INITSEQ_CALL(ST7781_DRIV_OUT_CTRL),
+  ST7781_DRIV_WAV_CTRL, 2, 0x07, 0x00,
+  LCD_INITSEQ_CALL(ST7781_ENTRY_MOD),
 
-  LCD_IO_WriteCmd16MultipleData8(ST7781_DISP_CTRL2, "\x03\x02", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_DISP_CTRL3, "\x00\x00", 2);
+  ST7781_DISP_CTRL2, 2, 0x03, 0x02,
+  ST7781_DISP_CTRL3, 2, 0x00, 0x00,
   /*POWER CONTROL REGISTER INITIAL*/
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL1, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL2, "\x00\x07", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL3, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL4, "\x00\x00", 2);
+  ST7781_POW_CTRL1, 2, 0x00, 0x00,
+  ST7781_POW_CTRL2, 2, 0x00, 0x07,
+  ST7781_POW_CTRL3, 2, 0x00, 0x00,
+  ST7781_POW_CTRL4, 2, 0x00, 0x00,
 
-  LCD_Delay(5);
+  LCD_INITSEQ_WAIT(5),
   /*POWER SUPPPLY STARTUP 1 SETTING*/
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL1, "\x14\xB0", 2);
+  ST7781_POW_CTRL1, 2, 0x14, 0xB0,
 
-  LCD_Delay(5);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL2, "\x00\x07", 2);
-  LCD_Delay(5);
+  LCD_INITSEQ_WAIT(5),
+  ST7781_POW_CTRL2, LCD_INITSEQ_DELAY | 2, 0x00, 0x07, 5,
 
   /*POWER SUPPLY STARTUP 2 SETTING*/
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL3, "\x00\x8E", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL4, "\x0C\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_POW_CTRL7, "\x00\x15", 2);
+  ST7781_POW_CTRL3, 2, 0x00, 0x8E,
+  ST7781_POW_CTRL4, 2, 0x0C, 0x00,
+  ST7781_POW_CTRL7, 2, 0x00, 0x15,
 
-  LCD_Delay(5);
+  LCD_INITSEQ_WAIT(5),
 
   /****GAMMA CLUSTER SETTING****/
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL1, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL2, "\x01\x07", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL3, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL4, "\x02\x03", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL5, "\x04\x02", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL6, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL7, "\x02\x07", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL8, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL9, "\x02\x03", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GAMMA_CTRL10, "\x04\x03", 2);
+  ST7781_GAMMA_CTRL1, 2, 0x00, 0x00,
+  ST7781_GAMMA_CTRL2, 2, 0x01, 0x07,
+  ST7781_GAMMA_CTRL3, 2, 0x00, 0x00,
+  ST7781_GAMMA_CTRL4, 2, 0x02, 0x03,
+  ST7781_GAMMA_CTRL5, 2, 0x04, 0x02,
+  ST7781_GAMMA_CTRL6, 2, 0x00, 0x00,
+  ST7781_GAMMA_CTRL7, 2, 0x02, 0x07,
+  ST7781_GAMMA_CTRL8, 2, 0x00, 0x00,
+  ST7781_GAMMA_CTRL9, 2, 0x02, 0x03,
+  ST7781_GAMMA_CTRL10, 2, 0x04, 0x03,
 
   //-DISPLAY WINDOWS 240*320-
-  LCD_IO_WriteCmd16MultipleData8(ST7781_HOR_START_AD, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData16(ST7781_HOR_END_AD, &LcdPixelWidth, 1);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_VER_START_AD, "\x00\x00", 2);
-  LCD_IO_WriteCmd16MultipleData16(ST7781_VER_END_AD, &LcdPixelHeight, 1);
+  ST7781_HOR_START_AD, 2, 0x00, 0x00,
+  LCD_INITSEQ_CALL(ST7781_HOR_END_AD),
+  ST7781_VER_START_AD, 2, 0x00, 0x00,
+  LCD_INITSEQ_CALL(ST7781_VER_END_AD),
 
   //----FRAME RATE SETTING-----
-  LCD_IO_WriteCmd16MultipleData16(ST7781_GATE_SCAN_CTRL1, &GateScanCtrl1Data, 1);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_GATE_SCAN_CTRL2, "\x00\x03", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_PANEL_IF_CTRL1, "\x00\x29", 2);
-  LCD_Delay(5);
+  LCD_INITSEQ_CALL(ST7781_GATE_SCAN_CTRL1),
+  ST7781_GATE_SCAN_CTRL2, 2, 0x00, 0x03,
+  ST7781_PANEL_IF_CTRL1, LCD_INITSEQ_DELAY | 2, 0x00, 0x29, 5,
 
   //------DISPLAY ON------
-  LCD_IO_WriteCmd16MultipleData8(ST7781_FRM_RATE_COL_CTRL, "\x00\x0E", 2);
-  LCD_IO_WriteCmd16MultipleData8(ST7781_DISP_CTRL1, "\x01\x33", 2);
+  ST7781_FRM_RATE_COL_CTRL, 2, 0x00, 0x0E,
+  ST7781_DISP_CTRL1, 2, 0x01, 0x33,
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void st7781_InitFunc(uint8_t Reg)
+{
+  const uint16_t * pData;
+  switch(Reg)
+  {
+    case ST7781_DRIV_OUT_CTRL:
+      DrivOutCtrlData = Orient->DrivOutCtrl;
+      GateScanCtrl1Data = Orient->GateScanCtrl1;
+      EntryRightThenUp = Orient->RightThenUp;
+      EntryRightThenDown = Orient->RightThenDown;
+      EntryDownThenRight = Orient->DownThenRight;
+      LastEntry = EntryRightThenDown;
+      pData = &DrivOutCtrlData;
+      break;
+    case ST7781_ENTRY_MOD:
+      pData = &EntryRightThenDown;
+      break;
+    case ST7781_HOR_END_AD:
+      pData = &LcdPixelWidth;
+      break;
+    case ST7781_VER_END_AD:
+      pData = &LcdPixelHeight;
+      break;
+    default: /* ST7781_GATE_SCAN_CTRL1 */
+      pData = &GateScanCtrl1Data;
+      break;
+  }
+  LCD_IO_WriteCmd16MultipleData16(Reg, pData, 1);
+}
+
+static void st7781_InitStart(void)
+{
+  if(!LCD_IO_PROBED)
+    LCD_IO_Init();
+  LCD_InitSeqStart(&InitSeq, st7781_InitSeq, st7781_InitFunc, LCD_INITSEQ_CMD16);
+}
+
+//-----------------------------------------------------------------------------
+void st7781_Init(void)
+{
+  st7781_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t st7781_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    st7781_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -313,11 +372,7 @@ void st7781_DisplayOff(void)
   */
 uint16_t st7781_GetLcdPixelWidth(void)
 {
-  #if ((ST7781_ORIENTATION == 0) || (ST7781_ORIENTATION == 2))
-  return (uint16_t)ST7781_LCD_PIXEL_WIDTH;
-  #elif ((ST7781_ORIENTATION == 1) || (ST7781_ORIENTATION == 3))
-  return (uint16_t)ST7781_LCD_PIXEL_HEIGHT;
-  #endif
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -328,11 +383,7 @@ uint16_t st7781_GetLcdPixelWidth(void)
   */
 uint16_t st7781_GetLcdPixelHeight(void)
 {
-  #if ((ST7781_ORIENTATION == 0) || (ST7781_ORIENTATION == 2))
-  return (uint16_t)ST7781_LCD_PIXEL_HEIGHT;
-  #elif ((ST7781_ORIENTATION == 1) || (ST7781_ORIENTATION == 3))
-  return (uint16_t)ST7781_LCD_PIXEL_WIDTH;
-  #endif
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -370,9 +421,9 @@ void st7781_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void st7781_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ST7781_SETCURSOR(Xpos, Ypos);
@@ -388,9 +439,9 @@ void st7781_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t st7781_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ST7781_SETCURSOR(Xpos, Ypos);
@@ -409,7 +460,12 @@ uint16_t st7781_ReadPixel(uint16_t Xpos, uint16_t Ypos)
   */
 void st7781_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
 {
-  #if (ST7781_ORIENTATION == 0) || (ST7781_ORIENTATION == 2)
+  if(Orient->SwapXY)
+  { /* the x coordinate is the GRAM vertical address */
+    uint16_t t = Xpos; Xpos = Ypos; Ypos = t;
+    t = Width; Width = Height; Height = t;
+  }
+
   transdata.d16[0] = Xpos;
   LCD_IO_WriteCmd16MultipleData16(ST7781_HOR_START_AD, &transdata, 1);
   transdata.d16[0] = Xpos + Width - 1;
@@ -419,18 +475,6 @@ void st7781_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint1
   LCD_IO_WriteCmd16MultipleData16(ST7781_VER_START_AD, &transdata, 1);
   transdata.d16[0] = Ypos + Height - 1;
   LCD_IO_WriteCmd16MultipleData16(ST7781_VER_END_AD, &transdata, 1);
-
-  #elif (ST7781_ORIENTATION == 1) || (ST7781_ORIENTATION == 3)
-  transdata.d16[0] = Ypos;
-  LCD_IO_WriteCmd16MultipleData16(ST7781_HOR_START_AD, &transdata, 1);
-  transdata.d16[0] = Ypos + Height - 1;
-  LCD_IO_WriteCmd16MultipleData16(ST7781_HOR_END_AD, &transdata, 1);
-
-  transdata.d16[0] = Xpos;
-  LCD_IO_WriteCmd16MultipleData16(ST7781_VER_START_AD, &transdata, 1);
-  transdata.d16[0] = Xpos + Width - 1;
-  LCD_IO_WriteCmd16MultipleData16(ST7781_VER_END_AD, &transdata, 1);
-  #endif
 }
 
 //-----------------------------------------------------------------------------
@@ -444,9 +488,9 @@ void st7781_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint1
   */
 void st7781_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ST7781_SETCURSOR(Xpos, Ypos);
@@ -464,9 +508,9 @@ void st7781_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t L
   */
 void st7781_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ST7781_ENTRY_DATA_DOWN_THEN_RIGHT)
+  if(LastEntry != EntryDownThenRight)
   {
-    LastEntry = ST7781_ENTRY_DATA_DOWN_THEN_RIGHT;
+    LastEntry = EntryDownThenRight;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryDownThenRight, 1);
   }
   ST7781_SETCURSOR(Xpos, Ypos);
@@ -486,9 +530,9 @@ void st7781_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t L
 void st7781_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
   st7781_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   ST7781_SETCURSOR(Xpos, Ypos);
@@ -516,9 +560,9 @@ void st7781_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index)/2;
   pbmp += index;
 
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenUp, 1);
   }
   ST7781_SETCURSOR(Xpos, Ypos);
@@ -538,9 +582,9 @@ void st7781_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void st7781_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pdata)
 {
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   st7781_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -561,9 +605,9 @@ void st7781_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void st7781_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pdata)
 {
-  if(LastEntry != ST7781_ENTRY_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7781_ENTRY_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
   }
   st7781_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -604,3 +648,30 @@ void st7781_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_t
   else if(Mode == 3)
     LCD_IO_ReadCmd16MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ST7781_ORIENTATION)
+  * @retval None
+  */
+void st7781_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ST7781_LCD_PIXEL_HEIGHT : ST7781_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ST7781_LCD_PIXEL_WIDTH : ST7781_LCD_PIXEL_HEIGHT;
+  DrivOutCtrlData = Orient->DrivOutCtrl;
+  GateScanCtrl1Data = Orient->GateScanCtrl1;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  EntryDownThenRight = Orient->DownThenRight;
+  if(LastEntry)                         /* LastEntry == 0: the display is not initialized yet */
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd16MultipleData16(ST7781_DRIV_OUT_CTRL, &DrivOutCtrlData, 1);
+    LCD_IO_WriteCmd16MultipleData16(ST7781_GATE_SCAN_CTRL1, &GateScanCtrl1Data, 1);
+    LCD_IO_WriteCmd16MultipleData16(ST7781_ENTRY_MOD, &EntryRightThenDown, 1);
+  }
+}
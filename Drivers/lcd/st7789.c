@@ -6,6 +6,7 @@
 #include "lcd.h"
 #include "lcd_io.h"
 #include "bmp.h"
+#include "lcd_initseq.h"
 #include "st7789.h"
 
 void     st7789_Init(void);
@@ -26,6 +27,11 @@ void     st7789_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint1
 void     st7789_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
 void     st7789_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 void     st7789_UserCommand(uint16_t Command, uint8_t * pData, uint32_t Size, uint8_t Mode);
+void     st7789_SetOrientation(uint8_t Orientation);
+uint32_t st7789_InitStep(void);
+uint16_t st7789_GetOffscreenLines(void);
+void     st7789_SetVisibleY(uint16_t Ypos);
+uint8_t  st7789_SetWriteBitDepth(uint8_t BitDepth);
 
 LCD_DrvTypeDef   st7789_drv =
 {
@@ -46,14 +52,21 @@ LCD_DrvTypeDef   st7789_drv =
   st7789_FillRect,
   st7789_ReadRGBImage,
   st7789_Scroll,
-  st7789_UserCommand
+  st7789_UserCommand,
+  st7789_SetOrientation,
+  st7789_InitStep,
+  st7789_GetOffscreenLines,
+  st7789_SetVisibleY,
+  st7789_SetWriteBitDepth
 };
 
+#if LCD_MULTI == 0 && LCD_AUTODETECT == 0
 LCD_DrvTypeDef  *lcd_drv = &st7789_drv;
+#endif
 
 /* transaction data */
 #define TRANSDATAMAXSIZE  4
-union
+static union
 {
   char       c[TRANSDATAMAXSIZE];
   uint8_t   d8[TRANSDATAMAXSIZE];
@@ -145,39 +158,40 @@ union
 #define ST7789_MAD_COLORMODE  ST7789_MAD_BGR
 #endif
 
-#if (ST7789_ORIENTATION == 0)
-#define ST7789_SIZE_X                     ST7789_LCD_PIXEL_WIDTH
-#define ST7789_SIZE_Y                     ST7789_LCD_PIXEL_HEIGHT
-#define ST7789_MAD_DATA_RIGHT_THEN_UP     (ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_UP | ST7789_MAD_HORIZONTAL)
-#define ST7789_MAD_DATA_RIGHT_THEN_DOWN   (ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_DOWN | ST7789_MAD_HORIZONTAL)
-#define XSIZE                              Xsize
-#define YSIZE                              Ysize
-#elif (ST7789_ORIENTATION == 1)
-#define ST7789_SIZE_X                     ST7789_LCD_PIXEL_HEIGHT
-#define ST7789_SIZE_Y                     ST7789_LCD_PIXEL_WIDTH
-#define ST7789_MAD_DATA_RIGHT_THEN_UP     (ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_DOWN | ST7789_MAD_VERTICAL)
-#define ST7789_MAD_DATA_RIGHT_THEN_DOWN   (ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_DOWN | ST7789_MAD_VERTICAL)
-#define XSIZE                              Ysize
-#define YSIZE                              Xsize
-#elif (ST7789_ORIENTATION == 2)
-#define ST7789_SIZE_X                     ST7789_LCD_PIXEL_WIDTH
-#define ST7789_SIZE_Y                     ST7789_LCD_PIXEL_HEIGHT
-#define ST7789_MAD_DATA_RIGHT_THEN_UP     (ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_DOWN | ST7789_MAD_HORIZONTAL)
-#define ST7789_MAD_DATA_RIGHT_THEN_DOWN   (ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_UP | ST7789_MAD_HORIZONTAL)
-#define XSIZE                              Xsize
-#define YSIZE                              Ysize
-#elif (ST7789_ORIENTATION == 3)
-#define ST7789_SIZE_X                     ST7789_LCD_PIXEL_HEIGHT
-#define ST7789_SIZE_Y                     ST7789_LCD_PIXEL_WIDTH
-#define ST7789_MAD_DATA_RIGHT_THEN_UP     (ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_UP | ST7789_MAD_VERTICAL)
-#define ST7789_MAD_DATA_RIGHT_THEN_DOWN   (ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_UP | ST7789_MAD_VERTICAL)
-#define XSIZE                              Ysize
-#define YSIZE                              Xsize
-#endif
+/* Orientation dependent parameters (index: orientation) */
+typedef struct
+{
+  uint8_t  RightThenUp;                 /* MADCTL for right then up draw direction (bitmap) */
+  uint8_t  RightThenDown;               /* MADCTL for right then down draw direction */
+  uint8_t  ScrollTop;                   /* VSCRDEF top fix area parameter index (1 or 3) */
+  int8_t   ScrollDir;                   /* scroll direction (as the other drivers: positive Scroll moves the content
+                                           down / right, MY = 1: 1, MY = 0: -1) */
+}st7789_OrientTypeDef;
+
+static const st7789_OrientTypeDef OrientTab[4] =
+{
+  {ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_UP | ST7789_MAD_HORIZONTAL,
+   ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_DOWN | ST7789_MAD_HORIZONTAL, 3, 1},
+  {ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_DOWN | ST7789_MAD_VERTICAL,
+   ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_DOWN | ST7789_MAD_VERTICAL, 3, 1},
+  {ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_DOWN | ST7789_MAD_HORIZONTAL,
+   ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_UP | ST7789_MAD_HORIZONTAL, 1, -1},
+  {ST7789_MAD_COLORMODE | ST7789_MAD_X_LEFT  | ST7789_MAD_Y_UP | ST7789_MAD_VERTICAL,
+   ST7789_MAD_COLORMODE | ST7789_MAD_X_RIGHT | ST7789_MAD_Y_UP | ST7789_MAD_VERTICAL, 1, -1}
+};
 
+#if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+/* off-screen GRAM rows */
+#define ST7789_OFFSCREEN      (ST7789_GRAM_HEIGHT - ST7789_LCD_PIXEL_HEIGHT)
+#define ST7789_GRAMROW(a, ofs) (((a) + (ofs)) % ST7789_GRAM_HEIGHT)
+#define ST7789_SETWINDOW(x1, x2, y1, y2) \
+  { transdata.d16[0] = __REVSH(ST7789_GRAMROW(x1, GramOfsX)); transdata.d16[1] = __REVSH(ST7789_GRAMROW(x2, GramOfsX)); LCD_IO_WriteCmd8MultipleData8(ST7789_CASET, &transdata, 4); \
+    transdata.d16[0] = __REVSH(ST7789_GRAMROW(y1, GramOfsY)); transdata.d16[1] = __REVSH(ST7789_GRAMROW(y2, GramOfsY)); LCD_IO_WriteCmd8MultipleData8(ST7789_PASET, &transdata, 4); }
+#else
 #define ST7789_SETWINDOW(x1, x2, y1, y2) \
   { transdata.d16[0] = __REVSH(x1); transdata.d16[1] = __REVSH(x2); LCD_IO_WriteCmd8MultipleData8(ST7789_CASET, &transdata, 4); \
     transdata.d16[0] = __REVSH(y1); transdata.d16[1] = __REVSH(y2); LCD_IO_WriteCmd8MultipleData8(ST7789_PASET, &transdata, 4); }
+#endif
 
 #define ST7789_SETCURSOR(x, y)            ST7789_SETWINDOW(x, x, y, y)
 
@@ -186,23 +200,56 @@ union
 #define ST7789_IO_INITIALIZED     0x02
 static  uint8_t   Is_st7789_Initialized = 0;
 
-const uint8_t EntryRightThenUp = ST7789_MAD_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+/* actual orientation (see ST7789_ORIENTATION, it can be changed with st7789_SetOrientation) */
+static  const st7789_OrientTypeDef * Orient = &OrientTab[ST7789_ORIENTATION];
+static  uint16_t  SizeX = (ST7789_ORIENTATION & 1) ? ST7789_LCD_PIXEL_HEIGHT : ST7789_LCD_PIXEL_WIDTH;
+static  uint16_t  SizeY = (ST7789_ORIENTATION & 1) ? ST7789_LCD_PIXEL_WIDTH : ST7789_LCD_PIXEL_HEIGHT;
+
+static uint8_t EntryRightThenUp = 0;
+static uint8_t EntryRightThenDown = 0;
 
 /* the last set drawing direction is stored here */
-uint8_t LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+static uint8_t LastEntry = 0;
 
 static  uint16_t  yStart, yEnd;
 
+#if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+/* GRAM row offset of the x and y addresses (MY = 1: the panel is at the end of the reversed GRAM rows)
+   and the y address of the DrawBitmap (right then up) */
+static  uint16_t  GramOfsX, GramOfsY, GramOfsUp;
+
+static void st7789_GramOffset(void)
+{
+  uint16_t ofs = (EntryRightThenDown & ST7789_MAD_Y_DOWN) ? ST7789_OFFSCREEN : 0;
+  if(EntryRightThenDown & ST7789_MAD_VERTICAL)
+  { /* the GRAM rows are the x addresses */
+    GramOfsX = ofs;
+    GramOfsY = 0;
+    GramOfsUp = 0;
+  }
+  else
+  {
+    GramOfsX = 0;
+    GramOfsY = ofs;
+    GramOfsUp = ST7789_OFFSCREEN - ofs;
+  }
+}
+#endif
+
 //-----------------------------------------------------------------------------
 /* Pixel draw and read functions */
 
+#if ST7789_WRITEBITDEPTH == 12
+/* 12 bit write mode (it can be switched to 16 bit in runtime: st7789_SetWriteBitDepth) */
+static uint8_t WriteBitDepth = 12;
+#endif
+
 #if ST7789_WRITEBITDEPTH == ST7789_READBITDEPTH
 /* 16/16 and 24/24 bit, no need to change bitdepth data */
 #define SetWriteDir()
 #define SetReadDir()
 #else /* #if ST7789_WRITEBITDEPTH == ST7789_READBITDEPTH */
-uint8_t lastdir = 0;
+static uint8_t lastdir = 0;
 #if ST7789_WRITEBITDEPTH == 16
 /* 16/24 bit */
 #define SetWriteDir() {                                      \
@@ -231,7 +278,26 @@ uint8_t lastdir = 0;
     LCD_IO_WriteCmd8MultipleData8(ST7789_PIXFMT, "\55", 1);  \
     lastdir = 1;                                             \
   }                                                          }
-#endif /* #elif ILI9488_WRITEBITDEPTH == 24 */
+#elif ST7789_WRITEBITDEPTH == 12
+/* 12(16)/16 or 12(16)/24 bit */
+#if ST7789_READBITDEPTH == 16
+#define  ST7789_READPIXFMT  "\55"
+#elif ST7789_READBITDEPTH == 24
+#define  ST7789_READPIXFMT  "\66"
+#endif
+#define SetWriteDir() {                                      \
+  if(lastdir != 0)                                           \
+  {                                                          \
+    LCD_IO_WriteCmd8MultipleData8(ST7789_PIXFMT, ((WriteBitDepth == 12) ? "\53" : "\55"), 1); \
+    lastdir = 0;                                             \
+  }                                                          }
+#define SetReadDir() {                                       \
+  if(lastdir == 0)                                           \
+  {                                                          \
+    LCD_IO_WriteCmd8MultipleData8(ST7789_PIXFMT, ST7789_READPIXFMT, 1); \
+    lastdir = 1;                                             \
+  }                                                          }
+#endif /* #elif ILI9488_WRITEBITDEPTH == 12 */
 #endif /* #else ILI9488_WRITEBITDEPTH == ILI9488_READBITDEPTH */
 
 #if ST7789_WRITEBITDEPTH == 16
@@ -248,7 +314,20 @@ uint8_t lastdir = 0;
 #define  LCD_IO_DrawBitmap(pData, Size) { \
   SetWriteDir(); \
   LCD_IO_WriteCmd8MultipleData16to24(ST7789_RAMWR, pData, Size); }    /* Draw 24 bit Lcd bitmap from 16 bit bitmap data */
-#endif /* #elif ST7789_WRITEBITDEPTH == 24 */
+#elif ST7789_WRITEBITDEPTH == 12
+#define  LCD_IO_DrawFill(Color, Size) { \
+  SetWriteDir(); \
+  if(WriteBitDepth == 12) \
+    LCD_IO_WriteCmd8DataFill16to12(ST7789_RAMWR, Color, Size); \
+  else \
+    LCD_IO_WriteCmd8DataFill16(ST7789_RAMWR, Color, Size); }          /* Fill 12 (or 16) bit pixel(s) from 16 bit color code */
+#define  LCD_IO_DrawBitmap(pData, Size) { \
+  SetWriteDir(); \
+  if(WriteBitDepth == 12) \
+    LCD_IO_WriteCmd8MultipleData16to12(ST7789_RAMWR, pData, Size); \
+  else \
+    LCD_IO_WriteCmd8MultipleData16(ST7789_RAMWR, pData, Size); }      /* Draw 12 (or 16) bit Lcd bitmap from 16 bit bitmap data */
+#endif /* #elif ST7789_WRITEBITDEPTH == 12 */
 
 #if ST7789_READBITDEPTH == 16
 #define  LCD_IO_ReadBitmap(pData, Size) { \
@@ -292,7 +371,7 @@ void st7789_DisplayOff(void)
   */
 uint16_t st7789_GetLcdPixelWidth(void)
 {
-  return ST7789_SIZE_X;
+  return SizeX;
 }
 
 //-----------------------------------------------------------------------------
@@ -303,7 +382,7 @@ uint16_t st7789_GetLcdPixelWidth(void)
   */
 uint16_t st7789_GetLcdPixelHeight(void)
 {
-  return ST7789_SIZE_Y;
+  return SizeY;
 }
 
 //-----------------------------------------------------------------------------
@@ -320,57 +399,116 @@ uint32_t st7789_ReadID(void)
 }
 
 //-----------------------------------------------------------------------------
-void st7789_Init(void)
-{
-  if((Is_st7789_Initialized & ST7789_LCD_INITIALIZED) == 0)
-  {
-    Is_st7789_Initialized |= ST7789_LCD_INITIALIZED;
-    if((Is_st7789_Initialized & ST7789_IO_INITIALIZED) == 0)
-      LCD_IO_Init();
-    Is_st7789_Initialized |= ST7789_IO_INITIALIZED;
-  }
+/* Init sequence (see lcd_initseq.h) */
+#define INITFUNC_ORIENT       0
+#define INITFUNC_CLEAR        1
 
-  LCD_Delay(50);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_SWRESET, NULL, 0);
-  LCD_Delay(150);
+static const uint8_t st7789_InitSeq[] =
+{
+  LCD_INITSEQ_WAIT(50),
+  ST7789_SWRESET, LCD_INITSEQ_DELAY | 0, 150,
 
   /* color mode (16 or 24 bit) */
   #if ST7789_WRITEBITDEPTH == 16
-  LCD_IO_WriteCmd8MultipleData8(ST7789_PIXFMT, (uint8_t *)"\x55", 1);
+  ST7789_PIXFMT, 1, 0x55,
   #elif ST7789_WRITEBITDEPTH == 24
-  LCD_IO_WriteCmd8MultipleData8(ST7789_PIXFMT, (uint8_t *)"\x66", 1);
+  ST7789_PIXFMT, 1, 0x66,
+  #elif ST7789_WRITEBITDEPTH == 12
+  ST7789_PIXFMT, 1, 0x53,
   #endif
-  LCD_Delay(50);
-
-  LCD_IO_WriteCmd8MultipleData8(ST7789_FRMCTR2, (uint8_t *)"\x0C\x0C\x00\x33\x33", 5);
-  LCD_IO_WriteCmd8MultipleData8(0xB7, (uint8_t *)"\x35", 1);
-  LCD_IO_WriteCmd8MultipleData8(0xBB, (uint8_t *)"\x2B", 1);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_PWCTR1, (uint8_t *)"\x2C", 1);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_PWCTR3, (uint8_t *)"\x01\xFF", 2);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_PWCTR4, (uint8_t *)"\x11", 1);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_PWCTR5, (uint8_t *)"\x20", 1);
-  LCD_IO_WriteCmd8MultipleData8(0xC6, (uint8_t *)"\x0F", 1);
-  LCD_IO_WriteCmd8MultipleData8(0xD0, (uint8_t *)"\xA4\xA1", 2);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_GMCTRP1, (uint8_t *)"\xD0\x01\x08\x0F\x11\x2A\x36\x55\x44\x3A\x0B\x06\x11\x20", 14);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_GMCTRN1, (uint8_t *)"\xD0\x02\x07\x0A\x0B\x18\x34\x43\x4A\x2B\x1B\x1C\x22\x1F", 14);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_INVOFF, NULL, 0);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_SLPOUT, NULL, 0);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_NORON, NULL, 0);
-  LCD_IO_WriteCmd8MultipleData8(ST7789_DISPON, NULL, 0);
+  LCD_INITSEQ_WAIT(50),
+
+  ST7789_FRMCTR2, 5, 0x0C, 0x0C, 0x00, 0x33, 0x33,
+  0xB7, 1, 0x35,
+  0xBB, 1, 0x2B,
+  ST7789_PWCTR1, 1, 0x2C,
+  ST7789_PWCTR3, 2, 0x01, 0xFF,
+  ST7789_PWCTR4, 1, 0x11,
+  ST7789_PWCTR5, 1, 0x20,
+  0xC6, 1, 0x0F,
+  0xD0, 2, 0xA4, 0xA1,
+  ST7789_GMCTRP1, 14, 0xD0, 0x01, 0x08, 0x0F, 0x11, 0x2A, 0x36, 0x55, 0x44, 0x3A, 0x0B, 0x06, 0x11, 0x20,
+  ST7789_GMCTRN1, 14, 0xD0, 0x02, 0x07, 0x0A, 0x0B, 0x18, 0x34, 0x43, 0x4A, 0x2B, 0x1B, 0x1C, 0x22, 0x1F,
+  ST7789_INVOFF, 0,
+  ST7789_SLPOUT, 0,
+  ST7789_NORON, 0,
+  ST7789_DISPON, 0,
 
   // Vertical scroll zero
-  LCD_IO_WriteCmd8MultipleData8(ST7789_VSCRSADD, (uint8_t *)"\x00", 1);
-  LCD_Delay(50);
+  ST7789_VSCRSADD, LCD_INITSEQ_DELAY | 1, 0x00, 50,
 
-  LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
-  LCD_Delay(10);
+  LCD_INITSEQ_CALL(INITFUNC_ORIENT),     // MADCTL
+  LCD_INITSEQ_WAIT(10),
 
   #if ST7789_INITCLEAR == 1
-  st7789_FillRect(0, 0, ST7789_SIZE_X, ST7789_SIZE_Y, 0x0000);
-  LCD_Delay(10);
+  LCD_INITSEQ_CALL(INITFUNC_CLEAR),
+  LCD_INITSEQ_WAIT(10),
+  #endif
+
+  LCD_INITSEQ_WAIT(10),
+  LCD_INITSEQ_END
+};
+
+static LCD_InitSeqTypeDef InitSeq;
+
+/* Runtime values of the init sequence */
+static void st7789_InitFunc(uint8_t Func)
+{
+  if(Func == INITFUNC_ORIENT)
+  {
+    EntryRightThenUp = Orient->RightThenUp;
+    EntryRightThenDown = Orient->RightThenDown;
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
+    #if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+    st7789_GramOffset();
+    #endif
+  }
+  #if ST7789_INITCLEAR == 1
+  else if(Func == INITFUNC_CLEAR)
+  {
+    st7789_FillRect(0, 0, SizeX, SizeY, 0x0000);
+    #if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+    if(st7789_GetOffscreenLines())
+      st7789_FillRect(0, SizeY, SizeX, ST7789_OFFSCREEN, 0x0000);
+    #endif
+  }
   #endif
-  
-  LCD_Delay(10);
+}
+
+static void st7789_InitStart(void)
+{
+  if((Is_st7789_Initialized & ST7789_LCD_INITIALIZED) == 0)
+  {
+    Is_st7789_Initialized |= ST7789_LCD_INITIALIZED;
+    if((Is_st7789_Initialized & ST7789_IO_INITIALIZED) == 0 && !LCD_IO_PROBED)
+      LCD_IO_Init();
+    Is_st7789_Initialized |= ST7789_IO_INITIALIZED;
+  }
+  #if ST7789_WRITEBITDEPTH == 12
+  lastdir = 1;                          /* the init sequence sets the 12 bit mode, the actual write mode is set before the first drawing */
+  #endif
+  LCD_InitSeqStart(&InitSeq, st7789_InitSeq, st7789_InitFunc, LCD_INITSEQ_CMD8);
+}
+
+//-----------------------------------------------------------------------------
+void st7789_Init(void)
+{
+  st7789_InitStart();
+  LCD_InitSeqStep(&InitSeq, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Non blocking initialization (the first call starts it, call it while it returns 1)
+  * @param  None
+  * @retval 1: in progress, 0: ready
+  */
+uint32_t st7789_InitStep(void)
+{
+  if(InitSeq.pSeq == NULL)
+    st7789_InitStart();
+  return LCD_InitSeqStep(&InitSeq, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -395,9 +533,9 @@ void st7789_SetCursor(uint16_t Xpos, uint16_t Ypos)
   */
 void st7789_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 {
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   ST7789_SETCURSOR(Xpos, Ypos);
@@ -414,9 +552,9 @@ void st7789_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 uint16_t st7789_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
   uint16_t ret;
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   ST7789_SETCURSOR(Xpos, Ypos);
@@ -450,9 +588,9 @@ void st7789_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint1
   */
 void st7789_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   ST7789_SETWINDOW(Xpos, Xpos + Length - 1, Ypos, Ypos);
@@ -470,9 +608,9 @@ void st7789_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t L
   */
 void st7789_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   ST7789_SETWINDOW(Xpos, Xpos, Ypos, Ypos + Length - 1);
@@ -491,9 +629,9 @@ void st7789_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t L
   */
 void st7789_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode)
 {
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   ST7789_SETWINDOW(Xpos, Xpos + Xsize - 1, Ypos, Ypos + Ysize - 1);
@@ -519,13 +657,18 @@ void st7789_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   size = (size - index) / 2;
   pbmp += index;
 
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_UP)
+  if(LastEntry != EntryRightThenUp)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_UP;
+    LastEntry = EntryRightThenUp;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenUp, 1);
   }
-  transdata.d16[0] = __REVSH(ST7789_SIZE_Y - 1 - yEnd);
-  transdata.d16[1] = __REVSH(ST7789_SIZE_Y - 1 - yStart);
+  #if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+  transdata.d16[0] = __REVSH(ST7789_GRAMROW(ST7789_GRAM_HEIGHT + SizeY - 1 - yEnd, GramOfsUp));
+  transdata.d16[1] = __REVSH(ST7789_GRAMROW(ST7789_GRAM_HEIGHT + SizeY - 1 - yStart, GramOfsUp));
+  #else
+  transdata.d16[0] = __REVSH(SizeY - 1 - yEnd);
+  transdata.d16[1] = __REVSH(SizeY - 1 - yStart);
+  #endif
   LCD_IO_WriteCmd8MultipleData8(ST7789_PASET, &transdata, 4);
   LCD_IO_DrawBitmap(pbmp, size);
 }
@@ -543,9 +686,9 @@ void st7789_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp)
   */
 void st7789_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   st7789_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -565,9 +708,9 @@ void st7789_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void st7789_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
-  if(LastEntry != ST7789_MAD_DATA_RIGHT_THEN_DOWN)
+  if(LastEntry != EntryRightThenDown)
   {
-    LastEntry = ST7789_MAD_DATA_RIGHT_THEN_DOWN;
+    LastEntry = EntryRightThenDown;
     LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
   }
   st7789_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
@@ -585,59 +728,26 @@ void st7789_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
 void st7789_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
   static uint16_t scrparam[4] = {0, 0, 0, 0};
-  #if (ST7789_ORIENTATION == 0)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
-  {
-    scrparam[3] = __REVSH(TopFix);
-    scrparam[1] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7789_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ST7789_VSCRDEF, &scrparam[1], 6);
-  }
-  Scroll = (0 - Scroll) % __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ST7789_ORIENTATION == 1)
-  if((TopFix != __REVSH(scrparam[3])) || (BottonFix != __REVSH(scrparam[1])))
-  {
-    scrparam[3] = __REVSH(TopFix);
-    scrparam[1] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7789_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ST7789_VSCRDEF, &scrparam[1], 6);
-  }
-  Scroll %= __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ST7789_ORIENTATION == 2)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
-  {
-    scrparam[1] = __REVSH(TopFix);
-    scrparam[3] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7789_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ST7789_VSCRDEF, &scrparam[1], 6);
-  }
-  Scroll %= __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ST7789_ORIENTATION == 3)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
+  uint8_t top = Orient->ScrollTop;      /* the top fix area can be the physical bottom */
+  #if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+  /* the off-screen rows are at the physical bottom: in the bottom fix area if it is not empty, else in the scroll area */
+  if(top == 3 && TopFix)
+    TopFix += ST7789_OFFSCREEN;
+  else if(top == 1 && BottonFix)
+    BottonFix += ST7789_OFFSCREEN;
+  #endif
+  if((TopFix != __REVSH(scrparam[top])) || (BottonFix != __REVSH(scrparam[4 - top])) || (scrparam[2] == 0))
   {
-    scrparam[1] = __REVSH(TopFix);
-    scrparam[3] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7789_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
+    scrparam[top] = __REVSH(TopFix);
+    scrparam[4 - top] = __REVSH(BottonFix);
+    scrparam[2] = __REVSH(ST7789_GRAM_HEIGHT - TopFix - BottonFix);
     LCD_IO_WriteCmd8MultipleData8(ST7789_VSCRDEF, &scrparam[1], 6);
   }
-  Scroll = (0 - Scroll) % __REVSH(scrparam[2]);
+  Scroll = (Scroll * Orient->ScrollDir) % __REVSH(scrparam[2]);
   if(Scroll < 0)
     Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
   else
     Scroll = Scroll + __REVSH(scrparam[1]);
-  #endif
   if(Scroll != __REVSH(scrparam[0]))
   {
     scrparam[0] = __REVSH(Scroll);
@@ -665,3 +775,80 @@ void st7789_UserCommand(uint16_t Command, uint8_t* pData, uint32_t Size, uint8_t
   else if(Mode == 3)
     LCD_IO_ReadCmd8MultipleData16((uint8_t)Command, pData, Size, 1);
 }
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the display orientation (the content of the GRAM is not rotated)
+  * @param  Orientation : 0..3 (see ST7789_ORIENTATION)
+  * @retval None
+  */
+void st7789_SetOrientation(uint8_t Orientation)
+{
+  if(Orientation > 3)
+    return;
+  Orient = &OrientTab[Orientation];
+  SizeX = (Orientation & 1) ? ST7789_LCD_PIXEL_HEIGHT : ST7789_LCD_PIXEL_WIDTH;
+  SizeY = (Orientation & 1) ? ST7789_LCD_PIXEL_WIDTH : ST7789_LCD_PIXEL_HEIGHT;
+  EntryRightThenUp = Orient->RightThenUp;
+  EntryRightThenDown = Orient->RightThenDown;
+  #if ST7789_GRAM_HEIGHT > ST7789_LCD_PIXEL_HEIGHT
+  st7789_GramOffset();
+  #endif
+  if(Is_st7789_Initialized & ST7789_LCD_INITIALIZED)
+  {
+    LastEntry = EntryRightThenDown;
+    LCD_IO_WriteCmd8MultipleData8(ST7789_MADCTL, &EntryRightThenDown, 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Get the number of the off-screen GRAM rows (see ST7789_GRAM_HEIGHT)
+  * @param  None
+  * @retval rows after the visible area (0 = none, or landscape orientation)
+  */
+uint16_t st7789_GetOffscreenLines(void)
+{
+  if(Orient->RightThenDown & ST7789_MAD_VERTICAL)
+    return 0;
+  return ST7789_GRAM_HEIGHT - ST7789_LCD_PIXEL_HEIGHT;
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the first visible row (the visible rows: Ypos..Ypos+SizeY-1, modulo SizeY + off-screen rows)
+  * @param  Ypos : first visible row
+  * @retval None
+  * @note   It sets the scroll area to the full GRAM (no fix area)
+  */
+void st7789_SetVisibleY(uint16_t Ypos)
+{
+  if(st7789_GetOffscreenLines() == 0)
+    return;
+  /* MY = 1: the y rows are in reverse order in the GRAM */
+  if(EntryRightThenDown & ST7789_MAD_Y_DOWN)
+    st7789_Scroll(-(int16_t)Ypos * Orient->ScrollDir, 0, 0);
+  else
+    st7789_Scroll((int16_t)Ypos * Orient->ScrollDir, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+/**
+  * @brief  Set the write bitdepth in runtime (only if ST7789_WRITEBITDEPTH == 12)
+  * @param  BitDepth : 12 (RGB444) or 16 (RGB565)
+  * @retval the active write bitdepth
+  */
+uint8_t st7789_SetWriteBitDepth(uint8_t BitDepth)
+{
+  #if ST7789_WRITEBITDEPTH == 12
+  if((BitDepth == 12 || BitDepth == 16) && BitDepth != WriteBitDepth)
+  {
+    WriteBitDepth = BitDepth;
+    lastdir = 1;                        /* the COLMOD is sent before the next drawing */
+  }
+  return WriteBitDepth;
+  #else
+  (void)BitDepth;
+  return ST7789_WRITEBITDEPTH;
+  #endif
+}
@@ -13,11 +13,21 @@
 /* Color order (0 = RGB, 1 = BGR) */
 #define  ST7789_COLORMODE               0
 
-/* Draw and read bitdeph (16: RGB565, 24: RGB888) 
-   note: my SPI ST7789 LCD only readable if ST7789_READBITDEPTH 24 */
+/* Draw and read bitdeph (16: RGB565, 24: RGB888, write only 12: RGB444)
+   note: my SPI ST7789 LCD only readable if ST7789_READBITDEPTH 24
+   note: the 12 bit write mode needs the LCD_IO_DATA16TO12 io support (io_spi/lcd_io_spi_hal, io_host),
+         the write bitdepth can be switched between 12 and 16 in runtime (BSP_LCD_SetWriteBitDepth) */
 #define  ST7789_WRITEBITDEPTH           16
 #define  ST7789_READBITDEPTH            24
 
 // ILI9341 physic resolution (in 0 orientation)
 #define  ST7789_LCD_PIXEL_WIDTH         240
 #define  ST7789_LCD_PIXEL_HEIGHT        320
+
+/* GRAM height (the ST7789 GRAM is 240x320, the smaller panels show only a part of it, e.g. 240x240, 240x280)
+   - ST7789_LCD_PIXEL_HEIGHT: the GRAM rows after the panel are not used (default)
+   - 320: the rows after the panel are off-screen rows, they can be drawn and scrolled into the view in the
+          portrait orientations (see BSP_LCD_GetOffscreenLines, BSP_LCD_SetVisibleY), and the GRAM row offset
+          of the 'plug in top' orientations is also set with it
+   note: the panel must be connected to the first gate lines (GRAM rows 0..ST7789_LCD_PIXEL_HEIGHT-1) */
+#define  ST7789_GRAM_HEIGHT             ST7789_LCD_PIXEL_HEIGHT
@@ -0,0 +1,456 @@
+/*
+ * Text console with hardware scroll (on the BSP_LCD functions)
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+#include <string.h>
+#include "main.h"
+#include "stm32_adafruit_lcd.h"
+#include "lcd_console.h"
+
+//-----------------------------------------------------------------------------
+#define  ATTR(text, back)     ((text) | ((back) << 4))
+#define  ATTR_TEXT(a)         ((a) & 0x0F)
+#define  ATTR_BACK(a)         ((a) >> 4)
+#define  ATTR_DEFAULT         ATTR(LCD_CONSOLE_TEXTCOLOR, LCD_CONSOLE_BACKCOLOR)
+
+typedef struct
+{
+  uint8_t  ch;
+  uint8_t  attr;                        /* text color index | back color index << 4 */
+}cell_t;
+
+static struct
+{
+  sFONT    *font;
+  uint16_t top, bottom;                 /* status bar heights [pixel] */
+  uint16_t areay, areah;                /* text area position and height (rows * font height) [pixel] */
+  uint16_t rows, cols;                  /* text area size [character] */
+  uint16_t scroll;                      /* hardware scroll offset [pixel] (0 .. areah - 1, the content moves up) */
+  uint8_t  hw;                          /* 1: hardware scroll mode */
+  uint8_t  attr;                        /* actual colors */
+  uint32_t lineno;                      /* line number of the cursor line (from the init or clear) */
+  uint32_t topline;                     /* line number of the text area top row */
+  uint16_t cx;                          /* cursor column */
+  #if LCD_CONSOLE_ANSI == 1
+  uint8_t  esc;                         /* 0: normal, 1: ESC, 2: ESC[ */
+  uint8_t  bright;
+  uint8_t  parn;
+  uint16_t par[4];
+  #endif
+}con;
+
+static cell_t lines[LCD_CONSOLE_LINES][LCD_CONSOLE_COLUMNS];
+static char   status[2][LCD_CONSOLE_COLUMNS + 1];
+
+/* VGA palette */
+static const uint16_t palette[16] =
+{
+  LCD_COLOR(0, 0, 0),     LCD_COLOR(170, 0, 0),    LCD_COLOR(0, 170, 0),    LCD_COLOR(170, 170, 0),
+  LCD_COLOR(0, 0, 170),   LCD_COLOR(170, 0, 170),  LCD_COLOR(0, 170, 170),  LCD_COLOR(170, 170, 170),
+  LCD_COLOR(85, 85, 85),  LCD_COLOR(255, 85, 85),  LCD_COLOR(85, 255, 85),  LCD_COLOR(255, 255, 85),
+  LCD_COLOR(85, 85, 255), LCD_COLOR(255, 85, 255), LCD_COLOR(85, 255, 255), LCD_COLOR(255, 255, 255)
+};
+
+/* The saved BSP_LCD drawing properties */
+static sFONT    *savefont;
+static uint16_t savetext, saveback;
+
+//-----------------------------------------------------------------------------
+static void ConBegin(void)
+{
+  BSP_LCD_Lock();
+  savefont = BSP_LCD_GetFont();
+  savetext = BSP_LCD_GetTextColor();
+  saveback = BSP_LCD_GetBackColor();
+  BSP_LCD_SetFont(con.font);
+}
+
+//-----------------------------------------------------------------------------
+static void ConEnd(void)
+{
+  BSP_LCD_SetFont(savefont);
+  BSP_LCD_SetTextColor(savetext);
+  BSP_LCD_SetBackColor(saveback);
+  BSP_LCD_Unlock();
+}
+
+//-----------------------------------------------------------------------------
+/* Line buffer line of the line number */
+static inline cell_t * ConLine(uint32_t LineNo)
+{
+  return lines[LineNo % LCD_CONSOLE_LINES];
+}
+
+//-----------------------------------------------------------------------------
+/* Screen y position of the text area row (with the hardware scroll offset) */
+static uint16_t ConRowY(uint16_t Row)
+{
+  return con.areay + (Row * con.font->Height + con.scroll) % con.areah;
+}
+
+//-----------------------------------------------------------------------------
+static void ConFill(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color)
+{
+  if(Width == 0 || Height == 0)
+    return;
+  BSP_LCD_SetTextColor(Color);
+  BSP_LCD_FillRect(Xpos, Ypos, Width, Height);
+}
+
+//-----------------------------------------------------------------------------
+static void ConChar(uint16_t Xpos, uint16_t Ypos, uint8_t Ch, uint8_t Attr)
+{
+  BSP_LCD_SetTextColor(palette[ATTR_TEXT(Attr)]);
+  BSP_LCD_SetBackColor(palette[ATTR_BACK(Attr)]);
+  BSP_LCD_DisplayChar(Xpos, Ypos, Ch);
+}
+
+//-----------------------------------------------------------------------------
+/* Draw the cells From .. To - 1 of the text area row (the spaces are filled in one rectangle) */
+static void ConDrawCells(uint16_t Row, uint16_t From, uint16_t To)
+{
+  cell_t  *l = ConLine(con.topline + Row);
+  uint16_t y = ConRowY(Row), fw = con.font->Width, i;
+  while(From < To)
+  {
+    if(l[From].ch == ' ')
+    {
+      i = From;
+      while(i < To && l[i].ch == ' ' && ATTR_BACK(l[i].attr) == ATTR_BACK(l[From].attr))
+        i++;
+      ConFill(From * fw, y, (i - From) * fw, con.font->Height, palette[ATTR_BACK(l[From].attr)]);
+      From = i;
+    }
+    else
+    {
+      ConChar(From * fw, y, l[From].ch, l[From].attr);
+      From++;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void ConClearLine(uint32_t LineNo, uint16_t From)
+{
+  cell_t *l = ConLine(LineNo);
+  for(; From < LCD_CONSOLE_COLUMNS; From++)
+  {
+    l[From].ch = ' ';
+    l[From].attr = con.attr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void ConDrawStatus(uint32_t Bar)
+{
+  uint16_t y, h, i, fw = con.font->Width;
+  h = Bar ? con.bottom : con.top;
+  if(h == 0)
+    return;
+  y = Bar ? BSP_LCD_GetYSize() - h : 0;
+  ConFill(0, y, BSP_LCD_GetXSize(), h, LCD_CONSOLE_STATUSBACKCOLOR);
+  if(h < con.font->Height)
+    return;
+  y += (h - con.font->Height) / 2;
+  BSP_LCD_SetTextColor(LCD_CONSOLE_STATUSTEXTCOLOR);
+  BSP_LCD_SetBackColor(LCD_CONSOLE_STATUSBACKCOLOR);
+  for(i = 0; status[Bar][i] && (i + 1) * fw <= BSP_LCD_GetXSize(); i++)
+    BSP_LCD_DisplayChar(i * fw, y, status[Bar][i]);
+}
+
+//-----------------------------------------------------------------------------
+/* Text area geometry from the actual display size, and full redraw */
+static void ConLayout(void)
+{
+  uint16_t xs = BSP_LCD_GetXSize(), ys = BSP_LCD_GetYSize(), r;
+  uint32_t stored;
+
+  con.cols = xs / con.font->Width;
+  if(con.cols > LCD_CONSOLE_COLUMNS)
+    con.cols = LCD_CONSOLE_COLUMNS;
+  con.areay = con.top;
+  con.rows = (ys - con.top - con.bottom) / con.font->Height;
+  if(con.rows > LCD_CONSOLE_LINES)
+    con.rows = LCD_CONSOLE_LINES;
+  if(con.rows == 0)
+    con.rows = 1;
+  con.areah = con.rows * con.font->Height;
+
+  /* hardware scroll: the scroll axis is the panel vertical axis (portrait orientation),
+     the off-screen GRAM rows would be in the scroll area */
+  #if LCD_CONSOLE_HWSCROLL == 1
+  con.hw = (ys > xs) && (BSP_LCD_GetOffscreenLines() == 0);
+  #else
+  con.hw = 0;
+  #endif
+  con.scroll = 0;
+  if(con.hw)
+    BSP_LCD_Scroll(0, con.areay, ys - con.areay - con.areah); /* the remainder rows are in the bottom fix area */
+  else
+    BSP_LCD_Scroll(0, 0, 0);
+
+  /* the last lines of the line buffer are visible */
+  stored = con.lineno + 1;
+  if(stored > LCD_CONSOLE_LINES)
+    stored = LCD_CONSOLE_LINES;
+  con.topline = con.lineno + 1 - ((stored < con.rows) ? stored : con.rows);
+
+  for(r = 0; r < con.rows; r++)
+  {
+    if(con.topline + r <= con.lineno)
+      ConDrawCells(r, 0, con.cols);
+    else
+      ConFill(0, ConRowY(r), con.cols * con.font->Width, con.font->Height, palette[LCD_CONSOLE_BACKCOLOR]);
+  }
+  /* right side and the rows below the text area */
+  ConFill(con.cols * con.font->Width, con.areay, xs - con.cols * con.font->Width, con.areah, palette[LCD_CONSOLE_BACKCOLOR]);
+  ConFill(0, con.areay + con.areah, xs, ys - con.bottom - con.areay - con.areah, palette[LCD_CONSOLE_BACKCOLOR]);
+  ConDrawStatus(0);
+  ConDrawStatus(1);
+}
+
+//-----------------------------------------------------------------------------
+static void ConNewLine(void)
+{
+  uint16_t r;
+  con.lineno++;
+  ConClearLine(con.lineno, 0);
+  con.cx = 0;
+  if(con.lineno - con.topline < con.rows)
+  { /* there is free row */
+    ConDrawCells(con.lineno - con.topline, 0, con.cols);
+    return;
+  }
+
+  con.topline++;
+  if(con.hw)
+  { /* the new line is drawn into the row that scrolls out, then the scroll offset steps one line */
+    con.scroll = (con.scroll + con.font->Height) % con.areah;
+    ConDrawCells(con.rows - 1, 0, con.cols);
+    BSP_LCD_Scroll(-(int16_t)con.scroll, con.areay, BSP_LCD_GetYSize() - con.areay - con.areah);
+    return;
+  }
+
+  for(r = 0; r < con.rows; r++)
+    ConDrawCells(r, 0, con.cols);
+}
+
+//-----------------------------------------------------------------------------
+static void ConClear(void)
+{
+  con.lineno = 0;
+  con.topline = 0;
+  con.cx = 0;
+  ConClearLine(0, 0);
+  con.scroll = 0;
+  if(con.hw)
+    BSP_LCD_Scroll(0, con.areay, BSP_LCD_GetYSize() - con.areay - con.areah);
+  ConFill(0, con.areay, con.cols * con.font->Width, con.areah, palette[ATTR_BACK(con.attr)]);
+}
+
+#if LCD_CONSOLE_ANSI == 1
+//-----------------------------------------------------------------------------
+/* Select graphic rendition (ESC[...m) */
+static void ConSgr(uint16_t p)
+{
+  uint8_t t = ATTR_TEXT(con.attr), b = ATTR_BACK(con.attr);
+  if(p == 0)
+  {
+    con.bright = 0;
+    t = LCD_CONSOLE_TEXTCOLOR;
+    b = LCD_CONSOLE_BACKCOLOR;
+  }
+  else if(p == 1)
+  {
+    con.bright = 8;
+    t |= 8;
+  }
+  else if(p == 22)
+  {
+    con.bright = 0;
+    t &= 7;
+  }
+  else if(p >= 30 && p <= 37)
+    t = (p - 30) | con.bright;
+  else if(p == 39)
+    t = LCD_CONSOLE_TEXTCOLOR;
+  else if(p >= 40 && p <= 47)
+    b = p - 40;
+  else if(p == 49)
+    b = LCD_CONSOLE_BACKCOLOR;
+  else if(p >= 90 && p <= 97)
+    t = p - 90 + 8;
+  else if(p >= 100 && p <= 107)
+    b = p - 100 + 8;
+  con.attr = ATTR(t, b);
+}
+
+//-----------------------------------------------------------------------------
+/* Escape sequence character
+   - return: 1 = the character is processed, 0 = not escape sequence */
+static uint32_t ConEsc(char c)
+{
+  uint32_t i;
+  if(con.esc == 0)
+  {
+    if(c != 0x1B)
+      return 0;
+    con.esc = 1;
+  }
+  else if(con.esc == 1)
+  {
+    if(c == '[')
+    {
+      con.esc = 2;
+      con.parn = 0;
+      con.par[0] = 0;
+    }
+    else
+      con.esc = 0;                      /* not supported */
+  }
+  else if(c >= '0' && c <= '9')
+    con.par[con.parn] = con.par[con.parn] * 10 + (c - '0');
+  else if(c == ';')
+  {
+    if(con.parn < 3)
+      con.parn++;
+    con.par[con.parn] = 0;
+  }
+  else if(c >= 0x40 && c <= 0x7E)
+  { /* final character */
+    con.esc = 0;
+    if(c == 'm')
+      for(i = 0; i <= con.parn; i++)
+        ConSgr(con.par[i]);
+    else if(c == 'J' && con.par[0] == 2)
+      ConClear();
+    else if(c == 'K' && con.par[0] == 0 && con.cx < con.cols)
+    {
+      ConClearLine(con.lineno, con.cx);
+      ConDrawCells(con.lineno - con.topline, con.cx, con.cols);
+    }
+  }
+  return 1;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+static void ConPutc(char c)
+{
+  #if LCD_CONSOLE_ANSI == 1
+  if(ConEsc(c))
+    return;
+  #endif
+
+  if(c == '\n')
+    ConNewLine();
+  else if(c == '\r')
+    con.cx = 0;
+  else if(c == '\b')
+  {
+    if(con.cx)
+      con.cx--;
+  }
+  else if(c == '\t')
+    con.cx = (con.cx + 8) & ~7;
+  else if(c >= ' ' && c <= '~')
+  {
+    if(con.cx >= con.cols)
+      ConNewLine();
+    ConLine(con.lineno)[con.cx].ch = c;
+    ConLine(con.lineno)[con.cx].attr = con.attr;
+    ConChar(con.cx * con.font->Width, ConRowY(con.lineno - con.topline), c, con.attr);
+    con.cx++;
+  }
+}
+
+//=============================================================================
+/**
+  * @brief  Console initialization (the text area is cleared)
+  * @param  pFont : font (e.g. &Font12)
+  * @param  TopFix : top status bar height [pixel] (0 = no status bar)
+  * @param  BottomFix : bottom status bar height [pixel] (0 = no status bar)
+  * @retval None
+  */
+void LCD_ConsoleInit(sFONT *pFont, uint16_t TopFix, uint16_t BottomFix)
+{
+  memset(&con, 0, sizeof(con));
+  con.font = pFont;
+  con.top = TopFix;
+  con.bottom = BottomFix;
+  con.attr = ATTR_DEFAULT;
+  status[0][0] = 0;
+  status[1][0] = 0;
+  ConClearLine(0, 0);
+  ConBegin();
+  ConLayout();
+  ConEnd();
+}
+
+/**
+  * @brief  Write one character to the console
+  * @param  c : character
+  * @retval None
+  */
+void LCD_ConsolePutc(char c)
+{
+  ConBegin();
+  ConPutc(c);
+  ConEnd();
+}
+
+/**
+  * @brief  Write a string to the console
+  * @param  s : zero terminated string
+  * @retval None
+  */
+void LCD_ConsolePuts(const char *s)
+{
+  ConBegin();
+  while(*s)
+    ConPutc(*s++);
+  ConEnd();
+}
+
+/**
+  * @brief  Clear the text area (and the line buffer)
+  * @param  None
+  * @retval None
+  */
+void LCD_ConsoleClear(void)
+{
+  ConBegin();
+  ConClear();
+  ConEnd();
+}
+
+/**
+  * @brief  Print the text into the status bar
+  * @param  Bar : 0 = top, 1 = bottom
+  * @param  s : zero terminated string
+  * @retval None
+  */
+void LCD_ConsoleStatus(uint32_t Bar, const char *s)
+{
+  if(Bar > 1)
+    return;
+  strncpy(status[Bar], s, LCD_CONSOLE_COLUMNS);
+  status[Bar][LCD_CONSOLE_COLUMNS] = 0;
+  ConBegin();
+  ConDrawStatus(Bar);
+  ConEnd();
+}
+
+/**
+  * @brief  Redraw the console from the line buffer (e.g. after the BSP_LCD_SetOrientation)
+  * @param  None
+  * @retval None
+  */
+void LCD_ConsoleRedraw(void)
+{
+  ConBegin();
+  ConLayout();
+  ConEnd();
+}
@@ -0,0 +1,69 @@
+//=============================================================================
+/* Information section */
+
+/*
+ * Text console with hardware scroll (on the BSP_LCD functions)
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+/* How to use:
+   - add lcd_console.h and lcd_console.c to the project (after the BSP_LCD_Init)
+   - LCD_ConsoleInit(&Font12, TopFix, BottomFix) : the text area is between the top and bottom status bars [pixel]
+   - LCD_ConsolePutc(c), LCD_ConsolePuts(s) : write the text (e.g. from the printf _write function)
+     - control characters: '\n' new line, '\r' line start, '\b' backspace, '\t' tabulator (8 character)
+     - ANSI escape sequences (LCD_CONSOLE_ANSI = 1):
+       ESC[...m (0 reset, 1 bright, 30..37, 90..97 text color, 40..47, 100..107 back color, 39, 49 default color),
+       ESC[2J (clear the text area), ESC[K (clear to the end of line)
+   - LCD_ConsoleStatus(Bar, s) : print the text into the top (Bar = 0) or bottom (Bar = 1) status bar
+   - LCD_ConsoleRedraw() : redraw everything from the line buffer (e.g. after the BSP_LCD_SetOrientation)
+
+   How it works:
+   - a new line is drawn only into the row that scrolled out (it will be the bottom row of the text area), then the
+     vertical scroll start address is moved by one text line (BSP_LCD_Scroll), the other lines are not redrawn
+   - the scroll works in the vertical direction of the panel, so the hardware scroll is only used when the display
+     is in portrait orientation (BSP_LCD_GetYSize() > BSP_LCD_GetXSize()), in landscape the text area is redrawn
+     from the line buffer (slower, but the result is the same)
+   - the line buffer stores the last LCD_CONSOLE_LINES lines (character + color), this is redrawn after rotation
+   note: the console uses the BSP_LCD font and color settings, it restores them after each call
+   note: the status bars and the text area can not be drawn with other functions in the hardware scroll mode
+         (the text area rows are shifted in the GRAM)
+   note: LCD_MULTI = 1: only one display can have console */
+
+//=============================================================================
+/* Setting section (please set the necessary things in this section) */
+
+#ifndef __LCD_CONSOLE_H__
+#define __LCD_CONSOLE_H__
+
+/* Line buffer size (line number, it must be >= the number of the text area lines, e.g. 320 / 12 = 26) */
+#define LCD_CONSOLE_LINES     32
+
+/* Maximum characters in a line (e.g. 320 / 7 = 45 with Font12 in landscape orientation) */
+#define LCD_CONSOLE_COLUMNS   46
+
+/* ANSI escape sequence processing (0: off, 1: on) */
+#define LCD_CONSOLE_ANSI      1
+
+/* Default colors (palette index: 0 black, 1 red, 2 green, 3 yellow, 4 blue, 5 magenta, 6 cyan, 7 white, 8..15 bright) */
+#define LCD_CONSOLE_TEXTCOLOR 7
+#define LCD_CONSOLE_BACKCOLOR 0
+
+/* Status bar colors (RGB565) */
+#define LCD_CONSOLE_STATUSTEXTCOLOR LCD_COLOR_BLACK
+#define LCD_CONSOLE_STATUSBACKCOLOR LCD_COLOR_GRAY
+
+/* Hardware scroll (0: always redraw the text area, 1: hardware scroll in portrait orientation) */
+#define LCD_CONSOLE_HWSCROLL  1
+
+//=============================================================================
+/* Interface section */
+
+void     LCD_ConsoleInit(sFONT *pFont, uint16_t TopFix, uint16_t BottomFix);
+void     LCD_ConsolePutc(char c);
+void     LCD_ConsolePuts(const char *s);
+void     LCD_ConsoleClear(void);
+void     LCD_ConsoleStatus(uint32_t Bar, const char *s);
+void     LCD_ConsoleRedraw(void);
+
+#endif
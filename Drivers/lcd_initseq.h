@@ -0,0 +1,112 @@
+/*
+ * Table driven lcd initialization engine (for the lcd drivers)
+ * author: Roberto Benjami
+ * v.2026.10
+ *
+ * The lcd driver init sequence is a const byte table, every item:
+ *   - command (8 bit, or the low 8 bit of the 16 bit command if LCD_INITSEQ_CMD16 is in the start flags)
+ *   - parameter number (0..31) | flags
+ *   - parameters (one transaction with the command, big endian if 16 bit data register)
+ *   - delay [ms] (only with the LCD_INITSEQ_DELAY flag)
+ * Flags:
+ *   - LCD_INITSEQ_DELAY : delay byte after the parameters
+ *   - LCD_INITSEQ_NOCMD : no command (only delay)
+ *   - LCD_INITSEQ_FUNC  : calls the lcd driver function with the command byte (runtime values: orientation, clear)
+ * The table end: LCD_INITSEQ_END
+ *
+ * Run:
+ *   - blocking: LCD_InitSeqStart, LCD_InitSeqStep(&seq, 1) (the delays are LCD_Delay)
+ *   - non blocking: LCD_InitSeqStart, then call the LCD_InitSeqStep(&seq, 0) while it returns 1
+ *     (from the main loop or a timer, the delays are measured with HAL_GetTick, the function does not wait)
+ */
+
+#ifndef __LCD_INITSEQ_H
+#define __LCD_INITSEQ_H
+
+#define  LCD_INITSEQ_DELAY    0x80
+#define  LCD_INITSEQ_NOCMD    0x40
+#define  LCD_INITSEQ_FUNC     0x20
+#define  LCD_INITSEQ_PARNUM   0x1F
+
+/* Table items */
+#define  LCD_INITSEQ_WAIT(ms)   0x00, LCD_INITSEQ_NOCMD | LCD_INITSEQ_DELAY, ms
+#define  LCD_INITSEQ_CALL(f)    f, LCD_INITSEQ_FUNC
+#define  LCD_INITSEQ_END        0x00, 0xFF
+
+/* Start flags */
+#define  LCD_INITSEQ_CMD8     0
+#define  LCD_INITSEQ_CMD16    1
+
+typedef struct
+{
+  const uint8_t *pSeq;                  /* next item (NULL: finished) */
+  void     (*Func)(uint8_t);            /* lcd driver function for the LCD_INITSEQ_FUNC items */
+  uint32_t DelayStart;                  /* non blocking delay start time [HAL_GetTick] */
+  uint8_t  Delay;                       /* non blocking delay [ms] (0: no delay in progress) */
+  uint8_t  Flags;                       /* start flags */
+}LCD_InitSeqTypeDef;
+
+//-----------------------------------------------------------------------------
+static void LCD_InitSeqStart(LCD_InitSeqTypeDef *pSeq, const uint8_t *pTable, void (*Func)(uint8_t), uint8_t Flags)
+{
+  pSeq->pSeq = pTable;
+  pSeq->Func = Func;
+  pSeq->Delay = 0;
+  pSeq->Flags = Flags;
+}
+
+//-----------------------------------------------------------------------------
+/* Execute the init sequence items
+   - Blocking: 0 = returns at the delays, 1 = returns at the end of table
+   - return: 0 = finished, 1 = in progress */
+static uint32_t LCD_InitSeqStep(LCD_InitSeqTypeDef *pSeq, uint32_t Blocking)
+{
+  const uint8_t *p = pSeq->pSeq;
+  uint8_t n;
+
+  if(p == NULL)
+    return 0;
+
+  if(pSeq->Delay)
+  {
+    if(HAL_GetTick() - pSeq->DelayStart < pSeq->Delay)
+      return 1;
+    pSeq->Delay = 0;
+  }
+
+  while(p[1] != 0xFF)
+  {
+    n = p[1];
+    if(n & LCD_INITSEQ_FUNC)
+      pSeq->Func(p[0]);
+    else if(!(n & LCD_INITSEQ_NOCMD))
+    {
+      if(pSeq->Flags & LCD_INITSEQ_CMD16)
+        LCD_IO_WriteCmd16MultipleData8(p[0], &p[2], n & LCD_INITSEQ_PARNUM);
+      else
+        LCD_IO_WriteCmd8MultipleData8(p[0], &p[2], n & LCD_INITSEQ_PARNUM);
+    }
+    p += 2 + (n & LCD_INITSEQ_PARNUM);
+
+    if(n & LCD_INITSEQ_DELAY)
+    {
+      if(Blocking)
+        LCD_Delay(*p++);
+      else
+      {
+        pSeq->Delay = *p++;
+        pSeq->DelayStart = HAL_GetTick();
+        if(pSeq->Delay)
+        {
+          pSeq->pSeq = p;
+          return 1;
+        }
+      }
+    }
+  }
+
+  pSeq->pSeq = NULL;
+  return 0;
+}
+
+#endif /* __LCD_INITSEQ_H */
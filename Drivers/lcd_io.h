@@ -15,6 +15,19 @@ extern "C" {
 
 #include "lcd.h"
 
+//=============================================================================
+/* Setting section (please set the necessary things in this section) */
+
+/* LCD_IO_Transaction capture into RAM ring buffer (see lcd_io_trace.h)
+   - 0: disabled (default)
+   - 1: enabled (lcd_io_trace.h and lcd_io_trace.c must also be added to the project) */
+#define  LCD_IO_TRACE      0
+
+/* DMA write transaction end notification for the asynchronous image drawing (BSP_LCD_DrawRGB16ImageAsync)
+   - 0: disabled (default)
+   - 1: enabled (the DMA capable io drivers call the LCD_IO_DmaTxEnd at the end of each DMA write transaction) */
+#define  LCD_IO_ASYNC      0
+
 //=============================================================================
 /* Interface section */
 
@@ -41,12 +54,58 @@ extern "C" {
          With this switch, we can signal LCD_IO to do a color code transaction in reverse order,
          so it can also use DMA for bitmap drawing. */
 
+#define  LCD_IO_DATA16TO12 (1 << 10) /* at write */
+/* LCD_IO_DATA16TO12: the RGB565 source pixels are packed into RGB444 format (3 bytes / 2 pixels)
+   note: only the SPI HAL (io_spi/lcd_io_spi_hal) and the host (io_host) io drivers support it */
+
+/* Multi display mode (LCD_MULTI = 1 in the lcd.h), io driver side:
+   the io driver defines the LCD_IO_NAME before the lcd_io.h include, then its public functions get the
+   LCD_IO_NAME prefix (e.g. lcd_io_spi -> lcd_io_spi_Transaction) and it exports them in the LCD_IO_NAME##_drv table */
+#if LCD_MULTI == 1 && defined(LCD_IO_NAME)
+#define  LCD_IO_CAT_(a, b)     a##b
+#define  LCD_IO_CAT(a, b)      LCD_IO_CAT_(a, b)
+#define  LCD_Delay             LCD_IO_CAT(LCD_IO_NAME, _Delay)
+#define  LCD_IO_Init           LCD_IO_CAT(LCD_IO_NAME, _Init)
+#define  LCD_IO_Bl_OnOff       LCD_IO_CAT(LCD_IO_NAME, _Bl_OnOff)
+#define  LCD_IO_Transaction    LCD_IO_CAT(LCD_IO_NAME, _Transaction)
+#define  LCD_IO_DmaBusy        LCD_IO_CAT(LCD_IO_NAME, _DmaBusy)
+#define  LCD_IO_DRV            LCD_IO_CAT(LCD_IO_NAME, _drv)
+#endif
+
 /* Link function for LCD peripheral */
 void     LCD_Delay (uint32_t delay);
 void     LCD_IO_Init(void);
 void     LCD_IO_Bl_OnOff(uint8_t Bl);
 void     LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t DummySize, uint32_t Mode);
 
+/* Trace hook (the io drivers call it at the start of each LCD_IO_Transaction) */
+#if LCD_IO_TRACE == 1
+void     LCD_IO_TraceRecord(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t DummySize, uint32_t Mode);
+#define  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode)  LCD_IO_TraceRecord(Cmd, pData, Size, DummySize, Mode)
+#else
+#define  LCD_IO_TRACE_RECORD(Cmd, pData, Size, DummySize, Mode)
+#endif
+
+/* DMA write end hook (the io drivers call it from the DMA interrupt, after the transaction end) */
+#if LCD_IO_ASYNC == 1
+uint32_t LCD_IO_DmaBusy(void);
+void     LCD_IO_DmaTxEnd(void);
+#define  LCD_IO_DMATXEND()  LCD_IO_DmaTxEnd()
+#else
+#define  LCD_IO_DMATXEND()
+#endif
+
+/* Multi display mode (LCD_MULTI = 1 in the lcd.h), lcd driver side:
+   the io functions of the actual display (lcd_io: see BSP_LCD_SetContext) */
+#if LCD_MULTI == 1 && !defined(LCD_IO_NAME)
+extern   LCD_IO_DrvTypeDef *lcd_io;
+#define  LCD_Delay(d)          lcd_io->Delay(d)
+#define  LCD_IO_Init()         lcd_io->Init()
+#define  LCD_IO_Bl_OnOff(Bl)   lcd_io->Bl_OnOff(Bl)
+#define  LCD_IO_Transaction(Cmd, pData, Size, DummySize, Mode) \
+  lcd_io->Transaction(Cmd, pData, Size, DummySize, Mode)
+#endif
+
 /* 8 bit write commands */
 #define  LCD_IO_WriteCmd8DataFill16(Cmd, Data, Size) \
   LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)&Data, Size, 0, LCD_IO_CMD8 | LCD_IO_WRITE | LCD_IO_DATA16 | LCD_IO_FILL)
@@ -58,6 +117,10 @@ void     LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_
   LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)pData, Size, 0, LCD_IO_CMD8 | LCD_IO_WRITE | LCD_IO_DATA16 | LCD_IO_MULTIDATA)
 #define  LCD_IO_WriteCmd8MultipleData16to24(Cmd, pData, Size) \
   LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)pData, Size, 0, LCD_IO_CMD8 | LCD_IO_WRITE | LCD_IO_DATA16TO24 | LCD_IO_MULTIDATA)
+#define  LCD_IO_WriteCmd8DataFill16to12(Cmd, Data, Size) \
+  LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)&Data, Size, 0, LCD_IO_CMD8 | LCD_IO_WRITE | LCD_IO_DATA16TO12 | LCD_IO_FILL)
+#define  LCD_IO_WriteCmd8MultipleData16to12(Cmd, pData, Size) \
+  LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)pData, Size, 0, LCD_IO_CMD8 | LCD_IO_WRITE | LCD_IO_DATA16TO12 | LCD_IO_MULTIDATA)
 
 /* 16 bit write commands */
 #define  LCD_IO_WriteCmd16DataFill16(Cmd, Data, Size) \
@@ -70,6 +133,10 @@ void     LCD_IO_Transaction(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_
   LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)pData, Size, 0, LCD_IO_CMD16 | LCD_IO_WRITE | LCD_IO_DATA16 | LCD_IO_MULTIDATA)
 #define  LCD_IO_WriteCmd16MultipleData16to24(Cmd, pData, Size) \
   LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)pData, Size, 0, LCD_IO_CMD16 | LCD_IO_WRITE | LCD_IO_DATA16TO24 | LCD_IO_MULTIDATA)
+#define  LCD_IO_WriteCmd16DataFill16to12(Cmd, Data, Size) \
+  LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)&Data, Size, 0, LCD_IO_CMD16 | LCD_IO_WRITE | LCD_IO_DATA16TO12 | LCD_IO_FILL)
+#define  LCD_IO_WriteCmd16MultipleData16to12(Cmd, pData, Size) \
+  LCD_IO_Transaction((uint16_t)Cmd, (uint8_t *)pData, Size, 0, LCD_IO_CMD16 | LCD_IO_WRITE | LCD_IO_DATA16TO12 | LCD_IO_MULTIDATA)
 
 /* 8 bit read commands */
 #define  LCD_IO_ReadCmd8MultipleData8(Cmd, pData, Size, DummySize) \
@@ -0,0 +1,61 @@
+/*
+ * RGB565 -> RGB444 (12 bit write mode) pixel packing (for the io drivers and the host emulator)
+ * author: Roberto Benjami
+ * v.2026.10
+ *
+ * Bus format: 3 bytes / 2 pixels (R1G1 B1R2 G2B2), an odd last pixel: 2 bytes
+ * The io_spi/lcd_io_spi_hal.c sends the LCD_IO_DATA16TO12 transactions with these functions, the
+ * io_host/lcd_io_host.c emulator packs the pixels with the same functions (and chunks), so the host
+ * test checks the same code that runs on the hardware
+ */
+
+#ifndef __LCD_IO_RGB12_H
+#define __LCD_IO_RGB12_H
+
+#define  RGB565TO444(c16)     (((c16 & 0xF000) >> 4) | ((c16 & 0x0780) >> 3) | ((c16 & 0x001E) >> 1))
+
+//-----------------------------------------------------------------------------
+/* Fill 12bit bitmap from 16bit color (3 bytes / 2 pixels)
+   - color : 16 bit (RGB565) color
+   - tg    : 12 bit (RGB444) color target bitmap pointer
+   - Size  : number of pixel (even) */
+static inline void FillConvert16to12(uint16_t color, uint8_t * tg, uint32_t Size)
+{
+  uint16_t c12 = RGB565TO444(color);
+  uint8_t  b0 = c12 >> 4, b1 = (c12 << 4) | (c12 >> 8), b2 = c12;
+  Size >>= 1;
+  while(Size--)
+  {
+    *tg++ = b0;
+    *tg++ = b1;
+    *tg++ = b2;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* Convert from 16bit bitmap to 12bit bitmap (3 bytes / 2 pixels, the odd last pixel: 2 bytes)
+   - src   : 16 bit (RGB565) color source bitmap pointer
+   - tg    : 12 bit (RGB444) color target bitmap pointer
+   - Size  : number of pixel */
+static inline void BitmapConvert16to12(uint16_t * src, uint8_t * tg, uint32_t Size)
+{
+  uint16_t c1, c2;
+  while(Size >= 2)
+  {
+    c1 = RGB565TO444(src[0]);
+    c2 = RGB565TO444(src[1]);
+    *tg++ = c1 >> 4;
+    *tg++ = (c1 << 4) | (c2 >> 8);
+    *tg++ = c2;
+    src += 2;
+    Size -= 2;
+  }
+  if(Size)
+  {
+    c1 = RGB565TO444(*src);
+    *tg++ = c1 >> 4;
+    *tg = c1 << 4;
+  }
+}
+
+#endif /* __LCD_IO_RGB12_H */
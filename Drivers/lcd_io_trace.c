@@ -0,0 +1,176 @@
+/*
+ * LCD_IO_Transaction trace capture
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "lcd_io_trace.h"
+
+#if LCD_IO_TRACE == 1
+
+//-----------------------------------------------------------------------------
+#if LCD_IO_TRACE_TIMER == 1 && defined(__CORTEX_M) && (__CORTEX_M >= 3)
+#define  TraceTimerInit()     {CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; DWT->CYCCNT = 0; DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;}
+#define  TraceTime()          DWT->CYCCNT
+#define  TraceTimerFreq()     SystemCoreClock
+#else
+/* LCD_IO_TRACE_TIMER = 0, or Cortex-M0 / M0+ (no DWT cycle counter) */
+#define  TraceTimerInit()
+#define  TraceTime()          HAL_GetTick()
+#define  TraceTimerFreq()     1000
+#endif
+
+#define  FNV_OFFSET           0x811C9DC5
+#define  FNV_PRIME            0x01000193
+
+/* Record header (the size is LCD_IO_TRACE_RECSIZE, there is no padding) */
+typedef struct
+{
+  uint32_t time;
+  uint32_t size;
+  uint32_t hash;
+  uint16_t cmd;
+  uint16_t mode;
+  uint16_t dummysize;
+  uint16_t paylen;
+}trace_rec_t;
+
+static uint8_t  tracebuf[LCD_IO_TRACE_BUFSIZE];
+
+static volatile struct
+{
+  uint32_t on;                          /* 0: capture stopped, 1: capture running */
+  uint32_t head;                        /* write position */
+  uint32_t tail;                        /* oldest record position */
+  uint32_t used;                        /* bytes used in the buffer */
+  uint32_t lost;                        /* number of overwritten records */
+}trace = {0, 0, 0, 0, 0};
+
+//-----------------------------------------------------------------------------
+static void TraceBufWrite(uint8_t *p, uint32_t n)
+{
+  uint32_t h = trace.head;
+  trace.used += n;
+  while(n--)
+  {
+    tracebuf[h++] = *p++;
+    if(h >= LCD_IO_TRACE_BUFSIZE)
+      h = 0;
+  }
+  trace.head = h;
+}
+
+//-----------------------------------------------------------------------------
+/* Drop the oldest record */
+static void TraceBufDrop(void)
+{
+  uint32_t p, len;
+  p = trace.tail + LCD_IO_TRACE_RECSIZE - 2;   /* paylen position */
+  len = tracebuf[p % LCD_IO_TRACE_BUFSIZE] | (tracebuf[(p + 1) % LCD_IO_TRACE_BUFSIZE] << 8);
+  len += LCD_IO_TRACE_RECSIZE;
+  trace.tail = (trace.tail + len) % LCD_IO_TRACE_BUFSIZE;
+  trace.used -= len;
+  trace.lost++;
+}
+
+//-----------------------------------------------------------------------------
+/* Called from the io driver LCD_IO_Transaction (in the LcdTransStart protected section) */
+void LCD_IO_TraceRecord(uint16_t Cmd, uint8_t *pData, uint32_t Size, uint32_t DummySize, uint32_t Mode)
+{
+  trace_rec_t r;
+  uint32_t datalen = 0;
+
+  if(!trace.on)
+    return;
+
+  r.time = TraceTime();
+  r.size = Size;
+  r.hash = 0;
+  r.cmd = Cmd;
+  r.mode = Mode;
+  r.dummysize = DummySize;
+
+  /* written data length in memory (the 16to24 source data is also 16bit) */
+  if(Mode & LCD_IO_WRITE)
+  {
+    if(Mode & LCD_IO_FILL)
+      datalen = (Mode & LCD_IO_DATA8) ? 1 : 2;
+    else if(Mode & LCD_IO_DATA8)
+      datalen = Size;
+    else
+      datalen = Size << 1;
+  }
+
+  r.paylen = (datalen > LCD_IO_TRACE_PAYLOAD) ? LCD_IO_TRACE_PAYLOAD : datalen;
+
+  #if LCD_IO_TRACE_HASH == 1
+  if(datalen)
+  {
+    uint32_t i;
+    r.hash = FNV_OFFSET;
+    for(i = 0; i < datalen; i++)
+      r.hash = (r.hash ^ pData[i]) * FNV_PRIME;
+  }
+  #endif
+
+  while(trace.used + LCD_IO_TRACE_RECSIZE + r.paylen > LCD_IO_TRACE_BUFSIZE)
+    TraceBufDrop();
+
+  TraceBufWrite((uint8_t *)&r, LCD_IO_TRACE_RECSIZE);
+  if(r.paylen)
+    TraceBufWrite(pData, r.paylen);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_TraceStart(void)
+{
+  trace.on = 0;
+  trace.head = 0;
+  trace.tail = 0;
+  trace.used = 0;
+  trace.lost = 0;
+  TraceTimerInit();
+  trace.on = 1;
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_TraceStop(void)
+{
+  trace.on = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Stream the trace (header + records, oldest first)
+   note: the capture is paused while the dump is in progress */
+void LCD_IO_TraceDump(void (*out)(uint8_t *pData, uint32_t Size))
+{
+  uint8_t  head[LCD_IO_TRACE_HEADSIZE];
+  uint32_t on, d, n;
+
+  on = trace.on;
+  trace.on = 0;
+
+  memcpy(&head[0], "LCDTRACE", 8);
+  d = TraceTimerFreq();
+  memcpy(&head[8], &d, 4);
+  d = trace.lost;
+  memcpy(&head[12], &d, 4);
+  out(head, LCD_IO_TRACE_HEADSIZE);
+
+  n = trace.used;
+  if(trace.tail + n > LCD_IO_TRACE_BUFSIZE)
+  { /* the records wrap around the end of buffer */
+    d = LCD_IO_TRACE_BUFSIZE - trace.tail;
+    out(&tracebuf[trace.tail], d);
+    out(&tracebuf[0], n - d);
+  }
+  else if(n)
+    out(&tracebuf[trace.tail], n);
+
+  trace.on = on;
+}
+
+#endif /* #if LCD_IO_TRACE == 1 */
@@ -0,0 +1,69 @@
+//=============================================================================
+/* Information section */
+
+/*
+ * LCD_IO_Transaction trace capture
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+/* How to use:
+   - set the LCD_IO_TRACE to 1 in the lcd_io.h file
+   - add lcd_io_trace.h and lcd_io_trace.c to the project
+   - LCD_IO_TraceStart() : clear the buffer and start the capture
+   - LCD_IO_TraceStop()  : stop the capture
+   - LCD_IO_TraceDump(out) : stream the trace file (header + records, oldest first) with the out function
+     (e.g. a function that sends the data on the UART or writes it to the sd card)
+   - offline processing: Tools/LcdTraceReplay/lcdtrace_replay.c (see there)
+
+   Trace file format (all numbers are little endian):
+   - header (16 bytes):
+     - char[8]  : "LCDTRACE"
+     - uint32_t : timestamp frequency [Hz]
+     - uint32_t : number of records lost (overwritten by newer records)
+   - records (LCD_IO_TRACE_RECSIZE bytes + payload):
+     - uint32_t : timestamp (at the start of transaction)
+     - uint32_t : Size (pixel or byte number, see the LCD_IO_Transaction)
+     - uint32_t : FNV-1a hash of the full written data (0 if LCD_IO_TRACE_HASH == 0 or read transaction)
+     - uint16_t : Cmd
+     - uint16_t : Mode (LCD_IO_... bits)
+     - uint16_t : DummySize
+     - uint16_t : payload length (bytes)
+     - uint8_t[]: payload (the first max LCD_IO_TRACE_PAYLOAD bytes of written data) */
+
+//=============================================================================
+/* Setting section (please set the necessary things in this section) */
+
+#ifndef __LCD_IO_TRACE_H__
+#define __LCD_IO_TRACE_H__
+
+/* Trace ring buffer size [byte]
+   note: if the buffer is full, the oldest records are overwritten */
+#define LCD_IO_TRACE_BUFSIZE  8192
+
+/* Maximum payload bytes stored per record
+   note: the window and register settings (CASET, PASET, MADCTL ...) fit in it,
+         the large bitmaps are only stored with their hash */
+#define LCD_IO_TRACE_PAYLOAD  32
+
+/* Data hash calculation (this slows down the bitmap drawing during capture)
+   - 0: disabled
+   - 1: enabled */
+#define LCD_IO_TRACE_HASH     1
+
+/* Timestamp source
+   - 0: HAL_GetTick (1ms resolution)
+   - 1: DWT cycle counter (Cortex-M3, M4, M7, M33, M55, M85, on Cortex-M0 / M0+ the HAL_GetTick is used) */
+#define LCD_IO_TRACE_TIMER    1
+
+//=============================================================================
+/* Interface section */
+
+#define LCD_IO_TRACE_HEADSIZE 16
+#define LCD_IO_TRACE_RECSIZE  20
+
+void     LCD_IO_TraceStart(void);
+void     LCD_IO_TraceStop(void);
+void     LCD_IO_TraceDump(void (*out)(uint8_t *pData, uint32_t Size));
+
+#endif
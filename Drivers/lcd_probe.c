@@ -0,0 +1,114 @@
+/*
+ * LCD controller auto detection
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+#include "main.h"
+#include "lcd.h"
+#include "lcd_io.h"
+#include "lcd_probe.h"
+
+#if LCD_AUTODETECT == 1
+
+#if LCD_MULTI == 1
+#error "The LCD_AUTODETECT = 1 is not supported in multi display mode (LCD_MULTI = 1)"
+#endif
+
+//-----------------------------------------------------------------------------
+/* ID read modes */
+#define  PROBE_CMD8           (LCD_IO_CMD8 | LCD_IO_READ | LCD_IO_DATA8)
+#define  PROBE_CMD16          (LCD_IO_CMD16 | LCD_IO_READ | LCD_IO_DATA16)
+
+/* Probe table item (ID read command and the expected ID of one lcd driver) */
+typedef struct
+{
+  LCD_DrvTypeDef *drv;
+  uint32_t id;                          /* expected ID (8 bit data: the bytes in big endian order) */
+  uint32_t idmask;                      /* compared ID bits */
+  uint16_t mode;                        /* PROBE_CMD8 or PROBE_CMD16 */
+  uint8_t  cmd;                         /* ID read command */
+  uint8_t  size;                        /* ID data number (8 bit: 1..4, 16 bit: 1..2) */
+  uint8_t  dummy;                       /* dummy bytes before the ID */
+}probe_t;
+
+extern LCD_DrvTypeDef ili9341_drv, st7789_drv, st7735_drv, ili9486_drv, ili9488_drv;
+extern LCD_DrvTypeDef ili9325_drv, ili9328_drv, st7781_drv, hx8347g_drv;
+
+/* Order: the MIPI-DCS controllers first (with unique 16..24 bit ID), then the indexed register controllers */
+static const probe_t probetab[] =
+{
+  #if LCD_PROBE_ILI9341 == 1
+  {&ili9341_drv, 0x009341, 0xFFFFFF, PROBE_CMD8,  0xD3, 3, 1},  /* RDID4 */
+  #endif
+  #if LCD_PROBE_ST7789 == 1
+  {&st7789_drv,  0x008552, 0x00FFFF, PROBE_CMD8,  0x04, 3, 1},  /* RDDID (85h 85h 52h) */
+  #endif
+  #if LCD_PROBE_ST7735 == 1
+  {&st7735_drv,  0x7C89F0, 0xFFFFFF, PROBE_CMD8,  0x04, 3, 1},  /* RDDID */
+  #endif
+  #if LCD_PROBE_ILI9486 == 1
+  {&ili9486_drv, 0x009486, 0xFFFFFF, PROBE_CMD8,  0xD3, 3, 1},  /* RDID4 */
+  #endif
+  #if LCD_PROBE_ILI9488 == 1
+  {&ili9488_drv, 0x009488, 0xFFFFFF, PROBE_CMD8,  0xD3, 3, 1},  /* RDID4 */
+  #endif
+  #if LCD_PROBE_ILI9325 == 1
+  {&ili9325_drv, 0x9325,   0xFFFF,   PROBE_CMD16, 0x00, 1, 2},  /* R00 */
+  #endif
+  #if LCD_PROBE_ILI9328 == 1
+  {&ili9328_drv, 0x9328,   0xFFFF,   PROBE_CMD16, 0x00, 1, 2},  /* R00 */
+  #endif
+  #if LCD_PROBE_ST7781 == 1
+  {&st7781_drv,  0x7783,   0xFFFF,   PROBE_CMD16, 0x00, 1, 2},  /* R00 */
+  #endif
+  #if LCD_PROBE_HX8347G == 1
+  {&hx8347g_drv, 0x75,     0xFF,     PROBE_CMD8,  0x00, 1, 1},  /* R00 */
+  #endif
+};
+
+#define  PROBETAB_NUM         (sizeof(probetab) / sizeof(probe_t))
+
+extern LCD_DrvTypeDef LCD_PROBE_DEFAULT;
+
+/* The lcd driver pointer of the upper layer (in this mode the lcd drivers do not set it) */
+LCD_DrvTypeDef  *lcd_drv = NULL;
+
+/* The io driver is initialized by the LCD_Probe (the lcd driver Init does not initialize it again) */
+uint8_t         lcd_io_probed = 0;
+
+//-----------------------------------------------------------------------------
+uint32_t LCD_Probe(void)
+{
+  uint32_t i, j, id;
+  union
+  {
+    uint8_t  d8[4];
+    uint16_t d16[2];
+  }rd;
+
+  lcd_drv = &LCD_PROBE_DEFAULT;
+  LCD_IO_Init();
+  lcd_io_probed = 1;
+
+  for(i = 0; i < PROBETAB_NUM; i++)
+  {
+    rd.d16[0] = 0; rd.d16[1] = 0;
+    LCD_IO_Transaction(probetab[i].cmd, rd.d8, probetab[i].size, probetab[i].dummy, probetab[i].mode);
+    id = 0;
+    if(probetab[i].mode == PROBE_CMD8)
+      for(j = 0; j < probetab[i].size; j++)
+        id = (id << 8) | rd.d8[j];
+    else
+      for(j = 0; j < probetab[i].size; j++)
+        id = (id << 16) | rd.d16[j];
+    if(id && (id & probetab[i].idmask) == probetab[i].id)
+    {
+      lcd_drv = probetab[i].drv;
+      return id;
+    }
+  }
+  return 0;
+}
+
+#endif /* #if LCD_AUTODETECT == 1 */
@@ -0,0 +1,49 @@
+//=============================================================================
+/* Information section */
+
+/*
+ * LCD controller auto detection
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+/* How to use:
+   - set the LCD_AUTODETECT to 1 in the lcd.h file
+   - add lcd_probe.h, lcd_probe.c and the lcd drivers of the possible displays to the project
+     (e.g. lcd/ili9341.c and lcd/st7789.c, all displays are connected to the same io driver)
+   - enable these lcd drivers in the setting section (LCD_PROBE_...)
+   - the BSP_LCD_Init calls the LCD_Probe: it initializes the io driver once, then reads the controller ID
+     with the ID read command of the enabled lcd drivers (in the order of the probe table),
+     and the first matching lcd driver will be the lcd_drv
+   - if no ID matches (e.g. the SPI io driver is in transmit only mode), the lcd_drv will be the LCD_PROBE_DEFAULT
+   note: the probe only reads the ID registers, the display initialization is done by the selected lcd driver Init
+         (it does not initialize the io driver and does not reset the display again, see LCD_IO_PROBED in the lcd.h) */
+
+//=============================================================================
+/* Setting section (please set the necessary things in this section) */
+
+#ifndef __LCD_PROBE_H__
+#define __LCD_PROBE_H__
+
+/* Probed lcd drivers (0: disabled, 1: enabled, the lcd driver .c file must be in the project if enabled) */
+#define LCD_PROBE_ILI9341     1
+#define LCD_PROBE_ST7789      1
+#define LCD_PROBE_ST7735      0
+#define LCD_PROBE_ILI9486     0
+#define LCD_PROBE_ILI9488     0
+#define LCD_PROBE_ILI9325     0
+#define LCD_PROBE_ILI9328     0
+#define LCD_PROBE_ST7781      0
+#define LCD_PROBE_HX8347G     0
+
+/* Lcd driver if the ID does not match (one of the enabled lcd drivers) */
+#define LCD_PROBE_DEFAULT     ili9341_drv
+
+//=============================================================================
+/* Interface section */
+
+/* Select the lcd driver (lcd_drv) from the controller ID
+   return: the read controller ID (0: no ID matched, the lcd driver is the LCD_PROBE_DEFAULT) */
+uint32_t LCD_Probe(void);
+
+#endif
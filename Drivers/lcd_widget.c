@@ -0,0 +1,710 @@
+/*
+ * Retained mode widget tree with dirty rectangle redraw (on the BSP_LCD functions)
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+#include <string.h>
+#include "main.h"
+#include "stm32_adafruit_lcd.h"
+#include "lcd_widget.h"
+
+#if LCD_CLIP == 0 && LCD_WIDGET_BANDSIZE == 0
+#error "The lcd_widget.c direct mode needs the clip rectangle (LCD_CLIP = 1 in the stm32_adafruit_lcd.h)"
+#endif
+
+#if LCD_WIDGET_BANDBUFS < 1 || LCD_WIDGET_BANDBUFS > 2
+#error "LCD_WIDGET_BANDBUFS: 1 or 2"
+#endif
+
+#if LCD_WIDGET_MAXTOUCH > 255
+#error "LCD_WIDGET_MAXTOUCH max 255"
+#endif
+
+//-----------------------------------------------------------------------------
+static LCD_WidgetTypeDef *root = NULL;
+
+/* Dirty set */
+static LCD_RectTypeDef dirty[LCD_WIDGET_DIRTYRECTS];
+static uint32_t        dirtynum = 0;
+
+/* Band compositor */
+#if LCD_WIDGET_BANDSIZE > 0
+static uint16_t        bandbuf[LCD_WIDGET_BANDBUFS][LCD_WIDGET_BANDSIZE];
+static volatile uint8_t bandbusy[LCD_WIDGET_BANDBUFS]; /* 1: the band is sending */
+static LCD_BandTypeDef band;
+#define PAINTABLE(w)          ((w)->Paint && !(w)->Render) /* the widgets with Render function are in the band */
+
+/* Waiting for a band buffer (freertos: the BandDone gives the semaphore, no freertos: busy wait) */
+#ifdef  osCMSIS
+#if osCMSIS < 0x20000
+/* Freertos 1 */
+static osSemaphoreId bandsem = NULL;
+osSemaphoreDef(LcdWidgetBand);
+#define BandSemNew()          do{if(!bandsem){bandsem = osSemaphoreCreate(osSemaphore(LcdWidgetBand), 1); osSemaphoreWait(bandsem, 0);}}while(0)
+#define BandSemSet()          osSemaphoreRelease(bandsem)
+#define BandSemWait()         osSemaphoreWait(bandsem, osWaitForever)
+#else
+/* Freertos 2 */
+static osSemaphoreId_t bandsem = NULL;
+#define BandSemNew()          do{if(!bandsem) bandsem = osSemaphoreNew(1, 0, NULL);}while(0)
+#define BandSemSet()          osSemaphoreRelease(bandsem)
+#define BandSemWait()         osSemaphoreAcquire(bandsem, osWaitForever)
+#endif
+#define BandQueueWait()       osDelay(1)  /* the async queue is full */
+#else
+#define BandSemNew()          do{}while(0)
+#define BandSemSet()          do{}while(0)
+#define BandSemWait()         do{}while(0)
+#define BandQueueWait()       do{}while(0)
+#endif
+#else
+#define PAINTABLE(w)          ((w)->Paint)
+#endif
+
+/* Hit index */
+static struct
+{
+  uint8_t           valid;              /* 0: rebuild at the next event */
+  uint16_t          cols, rows;         /* grid size (0: no grid, check every touchable widget) */
+  uint16_t          num;                /* number of the touchable widgets */
+  LCD_WidgetTypeDef *w[LCD_WIDGET_MAXTOUCH]; /* touchable widgets in paint order (the last is on top) */
+  LCD_RectTypeDef   r[LCD_WIDGET_MAXTOUCH];  /* visible part of the widgets (clipped to the parents) */
+  uint16_t          start[LCD_WIDGET_HITCELLS + 1]; /* first reference of the cells in the refs */
+  uint8_t           refs[LCD_WIDGET_HITREFS]; /* widget indexes, in descending order (top first) */
+  LCD_WidgetTypeDef *capture;           /* the widget that has the touch */
+  LCD_RectTypeDef   caprect;            /* visible part of the capture widget */
+}hit;
+
+#define INRECT(r, px, py)     (((px) >= (r)->Xpos) && ((px) < (r)->Xpos + (r)->Width) && ((py) >= (r)->Ypos) && ((py) < (r)->Ypos + (r)->Height))
+#define AREA(r)               ((uint32_t)(r)->Width * (r)->Height)
+
+//-----------------------------------------------------------------------------
+/* Intersection of two rectangles (return: 0 = empty) */
+static uint32_t RectIntersect(LCD_RectTypeDef *pDst, const LCD_RectTypeDef *pA, const LCD_RectTypeDef *pB)
+{
+  uint32_t x0, y0, x1, y1;
+  x0 = pA->Xpos > pB->Xpos ? pA->Xpos : pB->Xpos;
+  y0 = pA->Ypos > pB->Ypos ? pA->Ypos : pB->Ypos;
+  x1 = (uint32_t)pA->Xpos + pA->Width < (uint32_t)pB->Xpos + pB->Width ? (uint32_t)pA->Xpos + pA->Width : (uint32_t)pB->Xpos + pB->Width;
+  y1 = (uint32_t)pA->Ypos + pA->Height < (uint32_t)pB->Ypos + pB->Height ? (uint32_t)pA->Ypos + pA->Height : (uint32_t)pB->Ypos + pB->Height;
+  if(x0 >= x1 || y0 >= y1)
+    return 0;
+  pDst->Xpos = x0;
+  pDst->Ypos = y0;
+  pDst->Width = x1 - x0;
+  pDst->Height = y1 - y0;
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Bounding rectangle of two rectangles */
+static void RectUnion(LCD_RectTypeDef *pDst, const LCD_RectTypeDef *pA, const LCD_RectTypeDef *pB)
+{
+  uint32_t x0, y0, x1, y1;
+  x0 = pA->Xpos < pB->Xpos ? pA->Xpos : pB->Xpos;
+  y0 = pA->Ypos < pB->Ypos ? pA->Ypos : pB->Ypos;
+  x1 = (uint32_t)pA->Xpos + pA->Width > (uint32_t)pB->Xpos + pB->Width ? (uint32_t)pA->Xpos + pA->Width : (uint32_t)pB->Xpos + pB->Width;
+  y1 = (uint32_t)pA->Ypos + pA->Height > (uint32_t)pB->Ypos + pB->Height ? (uint32_t)pA->Ypos + pA->Height : (uint32_t)pB->Ypos + pB->Height;
+  pDst->Xpos = x0;
+  pDst->Ypos = y0;
+  pDst->Width = x1 - x0;
+  pDst->Height = y1 - y0;
+}
+
+//=============================================================================
+/* Dirty set */
+
+//-----------------------------------------------------------------------------
+/* Add a rectangle to the dirty set (merge with the dirty rectangles) */
+static void DirtyAdd(LCD_RectTypeDef r)
+{
+  LCD_RectTypeDef u, t;
+  uint32_t i, best, grow, bestgrow;
+  while(1)
+  {
+    i = 0;
+    while(i < dirtynum)
+    {
+      RectUnion(&u, &r, &dirty[i]);
+      if(AREA(&u) <= AREA(&r) + AREA(&dirty[i]) || RectIntersect(&t, &r, &dirty[i]))
+      { /* adjacent or overlapping: merge, then check the others again with the larger rectangle */
+        r = u;
+        dirty[i] = dirty[--dirtynum];
+        i = 0;
+      }
+      else
+        i++;
+    }
+    if(dirtynum < LCD_WIDGET_DIRTYRECTS)
+      break;
+
+    /* the set is full: merge with the rectangle of the least area growth (then it can overlap the others) */
+    best = 0;
+    bestgrow = 0xFFFFFFFF;
+    for(i = 0; i < dirtynum; i++)
+    {
+      RectUnion(&u, &r, &dirty[i]);
+      grow = AREA(&u) - AREA(&r) - AREA(&dirty[i]);
+      if(grow < bestgrow)
+      {
+        bestgrow = grow;
+        best = i;
+      }
+    }
+    RectUnion(&r, &r, &dirty[best]);
+    dirty[best] = dirty[--dirtynum];
+  }
+  dirty[dirtynum++] = r;
+}
+
+//-----------------------------------------------------------------------------
+void LCD_WidgetInvalidate(const LCD_RectTypeDef *pRect)
+{
+  LCD_RectTypeDef r;
+  if(!root)
+    return;
+  if(!pRect)
+    pRect = &root->Rect;
+  if(RectIntersect(&r, pRect, &root->Rect))
+    DirtyAdd(r);
+}
+
+//=============================================================================
+/* Widget tree */
+
+//-----------------------------------------------------------------------------
+void LCD_WidgetInit(LCD_WidgetTypeDef *pRoot)
+{
+  root = pRoot;
+  root->pParent = NULL;
+  root->pNext = NULL;
+  dirtynum = 0;
+  hit.valid = 0;
+  hit.capture = NULL;
+  #if LCD_WIDGET_BANDSIZE > 0
+  BandSemNew();
+  #endif
+  LCD_WidgetInvalidate(NULL);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_WidgetAdd(LCD_WidgetTypeDef *pParent, LCD_WidgetTypeDef *pWidget)
+{
+  LCD_WidgetTypeDef **pp = &pParent->pChild;
+  while(*pp)
+    pp = &(*pp)->pNext;
+  *pp = pWidget;
+  pWidget->pParent = pParent;
+  pWidget->pNext = NULL;
+  hit.valid = 0;
+  LCD_WidgetInvalidate(&pWidget->Rect);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_WidgetRemove(LCD_WidgetTypeDef *pWidget)
+{
+  LCD_WidgetTypeDef **pp;
+  if(!pWidget->pParent)
+    return;
+  pp = &pWidget->pParent->pChild;
+  while(*pp && *pp != pWidget)
+    pp = &(*pp)->pNext;
+  if(*pp)
+    *pp = pWidget->pNext;
+  pWidget->pParent = NULL;
+  pWidget->pNext = NULL;
+  hit.valid = 0;
+  hit.capture = NULL;
+  LCD_WidgetInvalidate(&pWidget->Rect);
+}
+
+//-----------------------------------------------------------------------------
+/* Paint the widget and its children inside the clip rectangle */
+#if LCD_CLIP == 1
+static void PaintTree(LCD_WidgetTypeDef *pWidget, const LCD_RectTypeDef *pClip)
+{
+  LCD_RectTypeDef r;
+  LCD_WidgetTypeDef *c;
+  if(!RectIntersect(&r, &pWidget->Rect, pClip))
+    return;
+  if(PAINTABLE(pWidget))
+  {
+    BSP_LCD_SetClipRect(r.Xpos, r.Ypos, r.Width, r.Height);
+    pWidget->Paint(pWidget, &r);
+  }
+  for(c = pWidget->pChild; c; c = c->pNext)
+    PaintTree(c, &r);
+}
+#endif
+
+#if LCD_WIDGET_BANDSIZE > 0
+//-----------------------------------------------------------------------------
+/* Render the widget and its children into the band inside the clip rectangle */
+static void RenderTree(LCD_WidgetTypeDef *pWidget, const LCD_RectTypeDef *pClip)
+{
+  LCD_RectTypeDef r;
+  LCD_WidgetTypeDef *c;
+  if(!RectIntersect(&r, &pWidget->Rect, pClip))
+    return;
+  if(pWidget->Render)
+  {
+    band.Clip = r;
+    pWidget->Render(pWidget, &band);
+  }
+  for(c = pWidget->pChild; c; c = c->pNext)
+    RenderTree(c, &r);
+}
+
+//-----------------------------------------------------------------------------
+/* The band is sent (called from the DMA interrupt or the drawing task with LCD_IO_ASYNC = 1) */
+static void BandDone(uint16_t *pData, void *pUser)
+{
+  uint32_t i;
+  (void)pUser;
+  for(i = 0; i < LCD_WIDGET_BANDBUFS; i++)
+    if(pData == bandbuf[i])
+      bandbusy[i] = 0;
+  BandSemSet();
+}
+
+//-----------------------------------------------------------------------------
+/* Render and send the dirty rectangle in bands */
+static void BandPaint(const LCD_RectTypeDef *pDirty)
+{
+  static uint32_t bi = 0;               /* actual band buffer */
+  uint32_t x, y, xe, ye, w, h;
+  w = pDirty->Width < LCD_WIDGET_BANDSIZE ? pDirty->Width : LCD_WIDGET_BANDSIZE;
+  h = LCD_WIDGET_BANDSIZE / w;
+  xe = pDirty->Xpos + pDirty->Width;
+  ye = pDirty->Ypos + pDirty->Height;
+  for(y = pDirty->Ypos; y < ye; y += h)
+    for(x = pDirty->Xpos; x < xe; x += w)
+    {
+      band.Rect.Xpos = x;
+      band.Rect.Ypos = y;
+      band.Rect.Width = xe - x < w ? xe - x : w;
+      band.Rect.Height = ye - y < h ? ye - y : h;
+      while(bandbusy[bi])               /* the buffer is still sending */
+        BandSemWait();
+      band.pBuf = bandbuf[bi];
+      RenderTree(root, &band.Rect);
+      bandbusy[bi] = 1;
+      while(BSP_LCD_DrawRGB16ImageAsync(band.Rect.Xpos, band.Rect.Ypos, band.Rect.Width, band.Rect.Height,
+                                        band.pBuf, BandDone, NULL) != LCD_OK) /* the async queue is full */
+        BandQueueWait();
+      bi = (bi + 1) % LCD_WIDGET_BANDBUFS;
+    }
+}
+#endif /* #if LCD_WIDGET_BANDSIZE > 0 */
+
+//-----------------------------------------------------------------------------
+uint32_t LCD_WidgetPaint(void)
+{
+  LCD_RectTypeDef d[LCD_WIDGET_DIRTYRECTS];
+  uint32_t i, n, area = 0;
+  if(!root || !dirtynum)
+    return 0;
+  n = dirtynum;                         /* the invalidations from the paint functions go to the next paint pass */
+  memcpy(d, dirty, n * sizeof(LCD_RectTypeDef));
+  dirtynum = 0;
+  for(i = 0; i < n; i++)
+    area += AREA(&d[i]);
+
+  #if LCD_WIDGET_BANDSIZE > 0
+  /* band mode (without the draw lock, the async drawing task also uses it) */
+  for(i = 0; i < n; i++)
+    BandPaint(&d[i]);
+  for(i = 0; i < LCD_WIDGET_BANDBUFS; i++)
+    while(bandbusy[i])                  /* every band is sent */
+      BandSemWait();
+  #endif
+
+  #if LCD_CLIP == 1
+  /* direct mode (band mode: the widgets without Render function) */
+  BSP_LCD_Lock();
+  for(i = 0; i < n; i++)
+    PaintTree(root, &d[i]);
+  BSP_LCD_ResetClipRect();
+  BSP_LCD_Unlock();
+  #endif
+  return area;
+}
+
+//=============================================================================
+/* Drawing into the band (also used by the text widget in direct mode) */
+
+//-----------------------------------------------------------------------------
+void LCD_BandFillRect(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color)
+{
+  LCD_RectTypeDef r = {Xpos, Ypos, Width, Height};
+  uint16_t *p;
+  uint32_t x, y;
+  if(!RectIntersect(&r, &r, &pBand->Clip))
+    return;
+  for(y = 0; y < r.Height; y++)
+  {
+    p = &pBand->pBuf[(r.Ypos + y - pBand->Rect.Ypos) * pBand->Rect.Width + r.Xpos - pBand->Rect.Xpos];
+    for(x = 0; x < r.Width; x++)
+      *p++ = Color;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LCD_BandDrawRGB16Image(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, const uint16_t *pData)
+{
+  LCD_RectTypeDef r = {Xpos, Ypos, Xsize, Ysize};
+  uint32_t y;
+  if(!RectIntersect(&r, &r, &pBand->Clip))
+    return;
+  pData += (r.Ypos - Ypos) * Xsize + r.Xpos - Xpos;
+  for(y = 0; y < r.Height; y++)
+  {
+    memcpy(&pBand->pBuf[(r.Ypos + y - pBand->Rect.Ypos) * pBand->Rect.Width + r.Xpos - pBand->Rect.Xpos],
+           pData, r.Width * sizeof(uint16_t));
+    pData += Xsize;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LCD_BandDrawMultilayerChar(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, const uint8_t *Chars, const uint16_t *Colors, sFONT *pFont)
+{
+  LCD_RectTypeDef r = {Xpos, Ypos, pFont->Width, pFont->Height};
+  const uint8_t *pl;
+  uint16_t *p;
+  uint32_t x, y, li, bpl, ocs, set;
+  uint16_t c = 0;
+  if(!RectIntersect(&r, &r, &pBand->Clip))
+    return;
+  bpl = (pFont->Width + 7) / 8;         /* bytes per line */
+  ocs = pFont->Height * bpl;            /* one character size */
+  for(y = r.Ypos - Ypos; y < (uint32_t)(r.Ypos - Ypos + r.Height); y++)
+  {
+    p = &pBand->pBuf[(Ypos + y - pBand->Rect.Ypos) * pBand->Rect.Width + r.Xpos - pBand->Rect.Xpos];
+    for(x = r.Xpos - Xpos; x < (uint32_t)(r.Xpos - Xpos + r.Width); x++)
+    {
+      set = 0;
+      for(li = 0; li < MAX_CHAR_LAYER && Chars[li] >= ' '; li++)
+      { /* the last layer is on top */
+        pl = &pFont->table[(Chars[li] - ' ') * ocs + y * bpl];
+        if(pl[x >> 3] & (0x80 >> (x & 7)))
+        {
+          c = Colors[li];
+          set = 1;
+        }
+      }
+      if(set)
+        *p = c;
+      p++;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LCD_BandDrawString(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, const uint8_t *Text, sFONT *pFont, uint16_t Color)
+{
+  uint8_t ch[2] = {0, 0};
+  while(*Text)
+  {
+    ch[0] = *Text++;
+    LCD_BandDrawMultilayerChar(pBand, Xpos, Ypos, ch, &Color, pFont);
+    Xpos += pFont->Width;
+  }
+}
+
+//=============================================================================
+/* Text slot widget */
+
+//-----------------------------------------------------------------------------
+/* Render the text cells into the band */
+static void TextRender(LCD_WidgetTypeDef *pWidget, LCD_BandTypeDef *pBand)
+{
+  LCD_TextWidgetTypeDef *t = (LCD_TextWidgetTypeDef *)pWidget;
+  LCD_BandFillRect(pBand, pBand->Clip.Xpos, pBand->Clip.Ypos, pBand->Clip.Width, pBand->Clip.Height, t->BackColor);
+  LCD_BandDrawString(pBand, t->w.Rect.Xpos, t->w.Rect.Ypos, (uint8_t *)t->Text, t->pFont, t->TextColor);
+}
+
+#if LCD_WIDGET_BANDSIZE == 0
+//-----------------------------------------------------------------------------
+/* Direct mode: the clip area is rendered into RAM and sent in one window (or in more parts) */
+static void TextPaint(LCD_WidgetTypeDef *pWidget, const LCD_RectTypeDef *pClip)
+{
+  static uint16_t textbuf[LCD_WIDGET_TEXTBUF];
+  LCD_BandTypeDef b;
+  uint32_t x, y, xe, ye, w, h;
+  w = pClip->Width < LCD_WIDGET_TEXTBUF ? pClip->Width : LCD_WIDGET_TEXTBUF;
+  h = LCD_WIDGET_TEXTBUF / w;
+  xe = pClip->Xpos + pClip->Width;
+  ye = pClip->Ypos + pClip->Height;
+  b.pBuf = textbuf;
+  for(y = pClip->Ypos; y < ye; y += h)
+    for(x = pClip->Xpos; x < xe; x += w)
+    {
+      b.Rect.Xpos = x;
+      b.Rect.Ypos = y;
+      b.Rect.Width = xe - x < w ? xe - x : w;
+      b.Rect.Height = ye - y < h ? ye - y : h;
+      b.Clip = b.Rect;
+      TextRender(pWidget, &b);
+      BSP_LCD_DrawRGB16Image(b.Rect.Xpos, b.Rect.Ypos, b.Rect.Width, b.Rect.Height, textbuf);
+    }
+}
+#else
+#define TextPaint             NULL      /* band mode: the Render is used */
+#endif
+
+//-----------------------------------------------------------------------------
+/* Rectangle of the cells */
+static void TextCells(LCD_TextWidgetTypeDef *pText, uint32_t First, uint32_t Num, LCD_RectTypeDef *pRect)
+{
+  pRect->Xpos = pText->w.Rect.Xpos + First * pText->pFont->Width;
+  pRect->Ypos = pText->w.Rect.Ypos;
+  pRect->Width = Num * pText->pFont->Width;
+  pRect->Height = pText->pFont->Height;
+}
+
+//-----------------------------------------------------------------------------
+void LCD_TextInit(LCD_TextWidgetTypeDef *pText, uint16_t Xpos, uint16_t Ypos, uint32_t Len, sFONT *pFont, uint16_t TextColor, uint16_t BackColor)
+{
+  memset(pText, 0, sizeof(LCD_TextWidgetTypeDef));
+  if(Len > LCD_WIDGET_TEXTLEN)
+    Len = LCD_WIDGET_TEXTLEN;
+  pText->Len = Len;
+  pText->pFont = pFont;
+  pText->TextColor = TextColor;
+  pText->BackColor = BackColor;
+  memset(pText->Text, ' ', Len);
+  pText->w.Paint = TextPaint;
+  pText->w.Render = TextRender;
+  pText->w.Rect.Xpos = Xpos;
+  pText->w.Rect.Ypos = Ypos;
+  TextCells(pText, 0, Len, &pText->w.Rect);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_TextSet(LCD_TextWidgetTypeDef *pText, const char *s)
+{
+  LCD_RectTypeDef r;
+  uint32_t i, first = 0, run = 0;
+  char c;
+  for(i = 0; i < pText->Len; i++)
+  {
+    c = ' ';                            /* the cells after the text are cleared */
+    if(*s)
+    {
+      c = *s++;
+      if(c < ' ')
+        c = ' ';
+    }
+    if(c != pText->Text[i])
+    { /* changed cell */
+      pText->Text[i] = c;
+      if(!run)
+        first = i;
+      run++;
+    }
+    else if(run)
+    { /* end of the changed cells */
+      TextCells(pText, first, run, &r);
+      LCD_WidgetInvalidate(&r);
+      run = 0;
+    }
+  }
+  if(run)
+  {
+    TextCells(pText, first, run, &r);
+    LCD_WidgetInvalidate(&r);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LCD_TextSetStyle(LCD_TextWidgetTypeDef *pText, sFONT *pFont, uint16_t TextColor, uint16_t BackColor)
+{
+  if(pFont == pText->pFont && TextColor == pText->TextColor && BackColor == pText->BackColor)
+    return;
+  LCD_WidgetInvalidate(&pText->w.Rect); /* the old cells (the font size can change) */
+  pText->pFont = pFont;
+  pText->TextColor = TextColor;
+  pText->BackColor = BackColor;
+  TextCells(pText, 0, pText->Len, &pText->w.Rect);
+  LCD_WidgetInvalidate(&pText->w.Rect);
+}
+
+//=============================================================================
+/* Hit index */
+
+//-----------------------------------------------------------------------------
+/* Collect the touchable widgets in paint order */
+static void HitCollect(LCD_WidgetTypeDef *pWidget, const LCD_RectTypeDef *pClip)
+{
+  LCD_RectTypeDef r;
+  LCD_WidgetTypeDef *c;
+  if(!RectIntersect(&r, &pWidget->Rect, pClip))
+    return;
+  if(pWidget->Event && hit.num < LCD_WIDGET_MAXTOUCH)
+  {
+    hit.w[hit.num] = pWidget;
+    hit.r[hit.num] = r;
+    hit.num++;
+  }
+  for(c = pWidget->pChild; c; c = c->pNext)
+    HitCollect(c, &r);
+}
+
+//-----------------------------------------------------------------------------
+/* Build the hit index from the widget tree */
+static void HitBuild(void)
+{
+  uint32_t c, r, i, n, cells, c0, c1, r0, r1;
+  LCD_RectTypeDef *pr;
+  hit.valid = 1;
+  hit.num = 0;
+  hit.cols = 0;
+  HitCollect(root, &root->Rect);
+
+  /* the capture widget is still in the tree ? */
+  for(i = 0; i < hit.num && hit.w[i] != hit.capture; i++);
+  if(i < hit.num)
+    hit.caprect = hit.r[i];
+  else
+    hit.capture = NULL;
+
+  hit.cols = ((uint32_t)root->Rect.Xpos + root->Rect.Width + LCD_WIDGET_HITCELL - 1) / LCD_WIDGET_HITCELL;
+  hit.rows = ((uint32_t)root->Rect.Ypos + root->Rect.Height + LCD_WIDGET_HITCELL - 1) / LCD_WIDGET_HITCELL;
+  cells = hit.cols * hit.rows;
+  if(cells > LCD_WIDGET_HITCELLS)
+  {
+    hit.cols = 0;
+    return;
+  }
+
+  /* number of the references in the cells */
+  memset(hit.start, 0, (cells + 1) * sizeof(hit.start[0]));
+  for(i = 0; i < hit.num; i++)
+  {
+    pr = &hit.r[i];
+    c1 = (pr->Xpos + pr->Width - 1) / LCD_WIDGET_HITCELL;
+    r1 = (pr->Ypos + pr->Height - 1) / LCD_WIDGET_HITCELL;
+    for(r = pr->Ypos / LCD_WIDGET_HITCELL; r <= r1; r++)
+      for(c = pr->Xpos / LCD_WIDGET_HITCELL; c <= c1; c++)
+        hit.start[r * hit.cols + c + 1]++;
+  }
+  for(i = 0; i < cells; i++)
+    hit.start[i + 1] += hit.start[i];
+  if(hit.start[cells] > LCD_WIDGET_HITREFS)
+  {
+    hit.cols = 0;
+    return;
+  }
+
+  /* references (from the top widget, the start is shifted back meanwhile) */
+  for(i = hit.num; i-- > 0;)
+  {
+    pr = &hit.r[i];
+    c0 = pr->Xpos / LCD_WIDGET_HITCELL;
+    r0 = pr->Ypos / LCD_WIDGET_HITCELL;
+    c1 = (pr->Xpos + pr->Width - 1) / LCD_WIDGET_HITCELL;
+    r1 = (pr->Ypos + pr->Height - 1) / LCD_WIDGET_HITCELL;
+    for(r = r0; r <= r1; r++)
+      for(c = c0; c <= c1; c++)
+      {
+        n = r * hit.cols + c;
+        hit.refs[hit.start[n]++] = i;
+      }
+  }
+  for(i = cells; i > 0; i--)
+    hit.start[i] = hit.start[i - 1];
+  hit.start[0] = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* The index of the top touchable widget at the position (-1: none) */
+static int32_t HitFind(uint16_t X, uint16_t Y)
+{
+  uint32_t i, n;
+  if(!hit.valid)
+    HitBuild();
+  if(hit.cols)
+  { /* only the widgets of one cell */
+    if(X >= hit.cols * LCD_WIDGET_HITCELL || Y >= hit.rows * LCD_WIDGET_HITCELL)
+      return -1;
+    n = (Y / LCD_WIDGET_HITCELL) * hit.cols + X / LCD_WIDGET_HITCELL;
+    for(i = hit.start[n]; i < hit.start[n + 1]; i++)
+      if(INRECT(&hit.r[hit.refs[i]], X, Y))
+        return hit.refs[i];
+  }
+  else
+  { /* no grid: every touchable widget from the top */
+    for(i = hit.num; i-- > 0;)
+      if(INRECT(&hit.r[i], X, Y))
+        return i;
+  }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+LCD_WidgetTypeDef * LCD_WidgetHitTest(uint16_t X, uint16_t Y)
+{
+  int32_t i;
+  if(!root)
+    return NULL;
+  i = HitFind(X, Y);
+  return i < 0 ? NULL : hit.w[i];
+}
+
+//-----------------------------------------------------------------------------
+/* Capture the widget at the position (return: the widget or NULL) */
+static LCD_WidgetTypeDef * HitCapture(uint16_t X, uint16_t Y)
+{
+  int32_t i = HitFind(X, Y);
+  if(i < 0)
+    hit.capture = NULL;
+  else
+  {
+    hit.capture = hit.w[i];
+    hit.caprect = hit.r[i];
+  }
+  return hit.capture;
+}
+
+//-----------------------------------------------------------------------------
+void LCD_WidgetEvent(LCD_WidgetEventTypeDef *pEvent)
+{
+  LCD_WidgetTypeDef *w;
+  uint32_t i1, i2;
+  if(!root)
+    return;
+  if(!hit.valid)
+    HitBuild();
+
+  if(pEvent->Type == LCD_WIDGET_TOUCH_DOWN)
+  {
+    w = HitCapture(pEvent->X, pEvent->Y);
+    if(w)
+      w->Event(w, pEvent);
+  }
+  else if(pEvent->Type == LCD_WIDGET_TOUCH_UP)
+  {
+    w = hit.capture ? hit.capture : LCD_WidgetHitTest(pEvent->X, pEvent->Y);
+    hit.capture = NULL;
+    if(w)
+      w->Event(w, pEvent);
+  }
+  else if(pEvent->Type == LCD_WIDGET_TOUCH_MOVE)
+  {
+    w = hit.capture;
+    if(!w)
+    { /* the touch is not on a widget: the entered widget gets it */
+      w = HitCapture(pEvent->X, pEvent->Y);
+      if(!w)
+        return;
+    }
+    i1 = INRECT(&hit.caprect, pEvent->X, pEvent->Y); /* in widget ? */
+    i2 = INRECT(&hit.caprect, pEvent->PrevX, pEvent->PrevY); /* prev in widget ? */
+    if(i1 && !i2)
+      pEvent->Type = LCD_WIDGET_TOUCH_ENTER;  /* now entered */
+    else if(!i1 && i2)
+      pEvent->Type = LCD_WIDGET_TOUCH_LEAVE;  /* now leaved */
+    w->Event(w, pEvent);
+  }
+}
@@ -0,0 +1,166 @@
+//=============================================================================
+/* Information section */
+
+/*
+ * Retained mode widget tree with dirty rectangle redraw (on the BSP_LCD functions)
+ * author: Roberto Benjami
+ * v.2026.10
+ */
+
+/* How to use:
+   - add lcd_widget.h and lcd_widget.c to the project, the default is the band mode (it does not need the clip
+     rectangle if every widget has Render function), the direct mode needs LCD_CLIP = 1 in the stm32_adafruit_lcd.h
+   - widget: LCD_WidgetTypeDef (or a structure that begins with it, e.g. a button with its own state)
+     - Rect: position and size on the screen (absolute coordinates)
+     - Paint(pWidget, pClip): draws the widget from its state, the BSP_LCD drawing is clipped to the pClip rectangle,
+       so it can draw the whole widget (or only the pClip part for the speed), NULL: transparent container
+     - Render(pWidget, pBand): draws the widget into the RAM band (LCD_WIDGET_BANDSIZE > 0) with the LCD_Band...
+       functions, they are clipped to the pBand->Clip rectangle, NULL: transparent container
+     - Event(pWidget, pEvent): touch events, NULL: the widget is not touchable (the touch goes to the widget below)
+   - LCD_WidgetInit(&Root): the root widget is the screen (e.g. background painter with the screen size)
+   - LCD_WidgetAdd(&Parent, &Widget): the child is painted after the parent and the previous children (it is on top),
+     the child is clipped to the parent rectangle
+   - the state change of a widget does not draw: LCD_WidgetInvalidate(&Widget.Rect) (or only the changed part)
+   - LCD_WidgetPaint(): the paint pass (e.g. in the main loop), it redraws only the invalidated rectangles
+   - LCD_WidgetEvent(&Event): the touch event goes to the widget at the touch position
+   - text slot widget (e.g. numeric readouts): LCD_TextInit(&Text, x, y, Len, &Font, TextColor, BackColor),
+     LCD_WidgetAdd(&Parent, &Text.w), then LCD_TextSet(&Text, "12.5 V") at every change
+
+   How it works:
+   - the invalidated rectangles are collected in the dirty set (LCD_WIDGET_DIRTYRECTS), a new rectangle is merged
+     with a dirty rectangle if they overlap or their bounding rectangle is not larger than the two areas together
+     (adjacent rectangles), if the set is full, the pair with the least area growth is merged, so the dirty
+     rectangles never overlap
+   - direct mode (LCD_WIDGET_BANDSIZE = 0): the paint pass sets the clip rectangle to every dirty rectangle and
+     paints the widgets that intersect it (parent first, then the children in order), so only the pixels of the dirty
+     rectangles cross the display bus, but the overlapped widgets send their pixels more times (and it can flicker)
+   - band mode (LCD_WIDGET_BANDSIZE > 0): the dirty rectangles are cut into bands (as many full rows as fit in the
+     band buffer), the widgets that intersect the band are rendered back to front into the RAM band, then the band
+     is sent once (BSP_LCD_DrawRGB16ImageAsync, with 2 band buffers the next band is rendered while the DMA sends the
+     previous one, with freertos the paint task sleeps on a semaphore while the band buffer is sending), so every
+     dirty pixel crosses the display bus exactly once; the widgets without Render function are painted directly
+     after the bands (with Paint, it needs LCD_CLIP = 1)
+     note: the root widget must render every pixel (e.g. background), the band buffer is not cleared
+   - text slot widget: the text is stored in Len character cells (padded with spaces), LCD_TextSet compares the new
+     text with the previous one and invalidates only the changed cells (the adjacent changed cells in one rectangle,
+     the leftover cells of a shorter text are cleared), so a readout that changes one digit sends one glyph cell,
+     the changed cells are rendered into RAM and sent in one window (direct mode: LCD_WIDGET_TEXTBUF)
+   - hit index: uniform grid on the screen, each cell stores the touchable widgets that overlap it (top first), a
+     touch checks only the widgets of one cell; the widget touched down captures the touch (move, enter, leave, up)
+     until the release, a touch pressed outside the widgets is captured by the first widget it enters
+   note: the hit index is rebuilt at the next event after LCD_WidgetInit, LCD_WidgetAdd, LCD_WidgetRemove
+   note: the widget Rect must not change while it is in the tree (remove, change, add)
+   note: LCD_MULTI = 1: only one display can have widgets */
+
+//=============================================================================
+/* Setting section (please set the necessary things in this section) */
+
+#ifndef __LCD_WIDGET_H__
+#define __LCD_WIDGET_H__
+
+/* Dirty set size (rectangle number) */
+#define LCD_WIDGET_DIRTYRECTS 8
+
+/* Hit index
+   - LCD_WIDGET_HITCELL: cell size [pixel] (e.g. the typical button size)
+   - LCD_WIDGET_HITCELLS: maximum number of the cells (e.g. 480 * 320 / 32 / 32 = 150)
+   - LCD_WIDGET_HITREFS: maximum number of the widget references in the cells (a widget is in every cell it overlaps)
+   - LCD_WIDGET_MAXTOUCH: maximum number of the touchable widgets (max 255)
+   note: if the index does not fit, the touch is resolved by checking every touchable widget */
+#define LCD_WIDGET_HITCELL    32
+#define LCD_WIDGET_HITCELLS   256
+#define LCD_WIDGET_HITREFS    512
+#define LCD_WIDGET_MAXTOUCH   64
+
+/* Band compositor
+   - LCD_WIDGET_BANDSIZE: band buffer size [pixel]
+     0: direct mode (the widgets are painted with the BSP_LCD functions, no band buffer, LCD_CLIP = 1 needed)
+     other: band mode (at least the screen width, e.g. 320 * 8, default)
+   - LCD_WIDGET_BANDBUFS: band buffer number
+     1: render, then send (the memory need: LCD_WIDGET_BANDSIZE * 2 byte, default)
+     2: the next band is rendered during the previous band is sending (with DMA and LCD_IO_ASYNC = 1) */
+#define LCD_WIDGET_BANDSIZE   (320 * 8)
+#define LCD_WIDGET_BANDBUFS   1
+
+/* Text slot widget
+   - LCD_WIDGET_TEXTLEN: maximum number of the character cells
+   - LCD_WIDGET_TEXTBUF: pixel buffer of the text widgets in direct mode [pixel] (e.g. 8 Font24 cells: 8 * 17 * 24,
+     if the changed cells are larger, they are sent in more parts) */
+#define LCD_WIDGET_TEXTLEN    24
+#define LCD_WIDGET_TEXTBUF    1024
+
+//=============================================================================
+/* Interface section */
+
+typedef struct
+{
+  uint16_t Xpos;
+  uint16_t Ypos;
+  uint16_t Width;
+  uint16_t Height;
+}LCD_RectTypeDef;
+
+/* Touch event types */
+enum {LCD_WIDGET_EVENT_NONE, LCD_WIDGET_TOUCH_DOWN, LCD_WIDGET_TOUCH_UP, LCD_WIDGET_TOUCH_MOVE,
+      LCD_WIDGET_TOUCH_ENTER, LCD_WIDGET_TOUCH_LEAVE};
+
+typedef struct
+{
+  uint32_t Type;                        /* LCD_WIDGET_TOUCH_DOWN, UP, MOVE (ENTER, LEAVE: the LCD_WidgetEvent makes them) */
+  uint16_t X, Y;                        /* touch position */
+  uint16_t PrevX, PrevY;                /* previous touch position (MOVE) */
+}LCD_WidgetEventTypeDef;
+
+/* RAM band (band mode) */
+typedef struct
+{
+  uint16_t          *pBuf;              /* pixels of the band rectangle (right then down, Rect.Width pixel rows) */
+  LCD_RectTypeDef   Rect;               /* band rectangle on the screen */
+  LCD_RectTypeDef   Clip;               /* the widget can draw only here (band, widget and parents intersection) */
+}LCD_BandTypeDef;
+
+typedef struct LCD_WidgetTypeDef LCD_WidgetTypeDef;
+struct LCD_WidgetTypeDef
+{
+  LCD_RectTypeDef   Rect;               /* position and size on the screen */
+  void              (*Paint)(LCD_WidgetTypeDef *pWidget, const LCD_RectTypeDef *pClip);
+  void              (*Render)(LCD_WidgetTypeDef *pWidget, LCD_BandTypeDef *pBand);
+  void              (*Event)(LCD_WidgetTypeDef *pWidget, LCD_WidgetEventTypeDef *pEvent);
+  LCD_WidgetTypeDef *pParent;           /* the tree links (LCD_WidgetAdd sets them) */
+  LCD_WidgetTypeDef *pChild;            /* first child (the last child is on top) */
+  LCD_WidgetTypeDef *pNext;             /* next sibling */
+};
+
+void     LCD_WidgetInit(LCD_WidgetTypeDef *pRoot);
+void     LCD_WidgetAdd(LCD_WidgetTypeDef *pParent, LCD_WidgetTypeDef *pWidget);
+void     LCD_WidgetRemove(LCD_WidgetTypeDef *pWidget);
+void     LCD_WidgetInvalidate(const LCD_RectTypeDef *pRect);  /* NULL: the whole screen */
+uint32_t LCD_WidgetPaint(void);                               /* return: the painted area [pixel] */
+void     LCD_WidgetEvent(LCD_WidgetEventTypeDef *pEvent);
+LCD_WidgetTypeDef * LCD_WidgetHitTest(uint16_t X, uint16_t Y);
+
+/* Drawing into the band (clipped to the pBand->Clip, for the Render functions)
+   - LCD_BandDrawMultilayerChar: the character layers (as BSP_LCD_DisplayStringOnMultilayerChar), the pixels
+     without layer are transparent
+   - LCD_BandDrawString: text with transparent background */
+void     LCD_BandFillRect(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color);
+void     LCD_BandDrawRGB16Image(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, const uint16_t *pData);
+void     LCD_BandDrawMultilayerChar(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, const uint8_t *Chars, const uint16_t *Colors, sFONT *pFont);
+void     LCD_BandDrawString(LCD_BandTypeDef *pBand, uint16_t Xpos, uint16_t Ypos, const uint8_t *Text, sFONT *pFont, uint16_t Color);
+
+/* Text slot widget */
+typedef struct
+{
+  LCD_WidgetTypeDef w;                  /* Rect: Len cells (LCD_TextInit sets it) */
+  sFONT             *pFont;
+  uint16_t          TextColor;
+  uint16_t          BackColor;
+  uint8_t           Len;                /* number of the cells */
+  char              Text[LCD_WIDGET_TEXTLEN + 1]; /* the displayed text (padded with spaces) */
+}LCD_TextWidgetTypeDef;
+
+void     LCD_TextInit(LCD_TextWidgetTypeDef *pText, uint16_t Xpos, uint16_t Ypos, uint32_t Len, sFONT *pFont, uint16_t TextColor, uint16_t BackColor);
+void     LCD_TextSet(LCD_TextWidgetTypeDef *pText, const char *s);
+void     LCD_TextSetStyle(LCD_TextWidgetTypeDef *pText, sFONT *pFont, uint16_t TextColor, uint16_t BackColor);
+
+#endif
@@ -15,6 +15,17 @@
  * - Modify : DrawChar function character size limit removed, and smaller bitmap array is sufficient for operation
  * - Add : BSP_LCD_DisplayMultilayerChar function (mainly for drawing icons and buttons)
  * - Add : BSP_LCD_DisplayStringOnMultilayerChar function (mainly for drawing texticons and textbuttons)
+ * - Add : BSP_LCD_Lock, BSP_LCD_Unlock, draw session lock in the drawing functions (LCD_DRAW_LOCK)
+ * - Add : BSP_LCD_DrawRGB16ImageAsync (LCD_IO_ASYNC)
+ * - Add : BSP_LCD_SetOrientation
+ * - Add : BSP_LCD_SetContext, BSP_LCD_GetContext (LCD_MULTI)
+ * - Modify : BSP_LCD_Init (lcd driver auto detection, LCD_AUTODETECT)
+ * - Add : BSP_LCD_InitStep (non blocking initialization)
+ * - Add : BSP_LCD_TeOn, BSP_LCD_TeOff, BSP_LCD_TeIrq, BSP_LCD_PresentFrame, BSP_LCD_TeStatGet, BSP_LCD_TeStatReset (LCD_TE)
+ * - Add : BSP_LCD_GetOffscreenLines, BSP_LCD_SetVisibleY (off-screen GRAM rows)
+ * - Add : BSP_LCD_SetWriteBitDepth (runtime 12/16 bit write mode)
+ * - Add : BSP_LCD_CopyRect (screen to screen copy with small buffer)
+ * - Add : BSP_LCD_SetClipRect, BSP_LCD_ResetClipRect (clip rectangle, LCD_CLIP)
  * */
 
 /**
@@ -89,8 +100,12 @@ EndDependencies */
 /* Includes ------------------------------------------------------------------*/
 #include <string.h>
 #include "lcd.h"
+#include "lcd_io.h"
 #include "stm32_adafruit_lcd.h"
 #include "Fonts/fonts.h"
+#if LCD_AUTODETECT == 1
+#include "lcd_probe.h"
+#endif
 
 /* @defgroup STM32_ADAFRUIT_LCD_Private_Defines */
 #define POLY_X(Z)             ((int32_t)((Points + (Z))->X))
@@ -104,17 +119,102 @@ EndDependencies */
 #define SWAP16(a, b) {uint16_t t = a; a = b; b = t;}
 
 /* @defgroup STM32_ADAFRUIT_LCD_Private_Variables */ 
+#if LCD_MULTI == 0
 LCD_DrawPropTypeDef DrawProp;
 
 extern LCD_DrvTypeDef  *lcd_drv;
+#elif LCD_MULTI == 1
+/* Actual display (the lcd drivers call the io driver with the lcd_io pointer, see lcd_io.h) */
+static LCD_CtxTypeDef  *LcdCtx = NULL;
+LCD_IO_DrvTypeDef      *lcd_io = NULL;
+#define  DrawProp      (LcdCtx->DrawProp)
+#define  lcd_drv       (LcdCtx->pDrv)
+#if LCD_IO_ASYNC == 1
+#error "The BSP_LCD_DrawRGB16ImageAsync (LCD_IO_ASYNC = 1) is not supported in multi display mode (LCD_MULTI = 1)"
+#endif
+#endif
 
 /* Font bitmap buffer */
 static uint16_t fontbitmapbuf[FONTBITMAPBUFSIZE] = {0};
 
+/* Rectangle copy buffer */
+static uint16_t copyrectbuf[COPYRECTBUFSIZE];
+
+/* Clip rectangle */
+#if LCD_CLIP == 1
+/* Cut the rectangle to the clip rectangle (return: 0 = the rectangle is not visible) */
+static uint32_t ClipRect(uint16_t *pXpos, uint16_t *pYpos, uint16_t *pWidth, uint16_t *pHeight)
+{
+  uint32_t x0 = *pXpos, y0 = *pYpos, x1 = x0 + *pWidth, y1 = y0 + *pHeight;
+  if(!DrawProp.ClipOn)
+    return 1;
+  if(x0 < DrawProp.ClipX0)
+    x0 = DrawProp.ClipX0;
+  if(y0 < DrawProp.ClipY0)
+    y0 = DrawProp.ClipY0;
+  if(x1 > DrawProp.ClipX1)
+    x1 = DrawProp.ClipX1;
+  if(y1 > DrawProp.ClipY1)
+    y1 = DrawProp.ClipY1;
+  if(x0 >= x1 || y0 >= y1)
+    return 0;
+  *pXpos = x0;
+  *pYpos = y0;
+  *pWidth = x1 - x0;
+  *pHeight = y1 - y0;
+  return 1;
+}
+#define  CLIPRECT(x, y, w, h) ClipRect(&x, &y, &w, &h)
+#else
+#define  CLIPRECT(x, y, w, h) 1
+#endif
+
+/* Draw session lock */
+#if LCD_DRAW_LOCK == 1 || LCD_IO_ASYNC == 1 || LCD_TE == 1
+#include "main.h"
+#endif
+
+#if (LCD_DRAW_LOCK == 1 || LCD_IO_ASYNC == 1) && defined(osCMSIS)
+/* LCD_IO_ASYNC = 1: the LcdAsync task draws beside the other tasks, so the lock is needed without LCD_DRAW_LOCK too */
+#if osCMSIS < 0x20000
+/* Freertos 1 (the recursive mutex has priority inheritance) */
+osMutexId LcdDrawMutexHandle = NULL;
+osMutexDef(LcdDrawMutex);
+#define LcdDrawMutexNew()     do{if(!LcdDrawMutexHandle) LcdDrawMutexHandle = osRecursiveMutexCreate(osMutex(LcdDrawMutex));}while(0)
+#define LcdDrawLock()         do{if(LcdDrawMutexHandle) osRecursiveMutexWait(LcdDrawMutexHandle, osWaitForever);}while(0)
+#define LcdDrawUnlock()       do{if(LcdDrawMutexHandle) osRecursiveMutexRelease(LcdDrawMutexHandle);}while(0)
+#else
+/* Freertos 2 */
+osMutexId_t LcdDrawMutexId = NULL;
+const osMutexAttr_t LcdDrawMutexAttr = {.name = "LcdDraw", .attr_bits = osMutexRecursive | osMutexPrioInherit};
+#define LcdDrawMutexNew()     do{if(!LcdDrawMutexId) LcdDrawMutexId = osMutexNew(&LcdDrawMutexAttr);}while(0)
+#define LcdDrawLock()         do{if(LcdDrawMutexId) osMutexAcquire(LcdDrawMutexId, osWaitForever);}while(0)
+#define LcdDrawUnlock()       do{if(LcdDrawMutexId) osMutexRelease(LcdDrawMutexId);}while(0)
+#endif
+#elif LCD_IO_ASYNC == 1 && !defined(osCMSIS)
+/* no freertos: the DMA interrupt starts the next queued async image with the lcd driver, so the drawing
+   functions wait until the async queue is empty (the interrupt can not overwrite the lcd driver state) */
+static void AsyncWait(void);
+#define LcdDrawMutexNew()     do{}while(0)
+#define LcdDrawLock()         AsyncWait()
+#define LcdDrawUnlock()       do{}while(0)
+#else
+/* no lock */
+#define LcdDrawMutexNew()     do{}while(0)
+#define LcdDrawLock()         do{}while(0)
+#define LcdDrawUnlock()       do{}while(0)
+#endif
+
 /* @defgroup STM32_ADAFRUIT_LCD_Private_FunctionPrototypes */ 
 static void DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *c);
 static void SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
-  
+static void AsyncInit(void);
+static void InitBegin(void);
+static void InitEnd(void);
+
+/* BSP_LCD_InitStep state (0: not started, 1: in progress) */
+static uint8_t InitStepState = 0;
+
 /**
   * @brief  Initializes the LCD.
   * @param  None
@@ -124,24 +224,136 @@ uint8_t BSP_LCD_Init(void)
 { 
   uint8_t ret = LCD_ERROR;
 
+  #if LCD_MULTI == 1
+  if(LcdCtx == NULL)
+    return ret;
+  #endif
+
+  InitBegin();
+
   /* LCD Init */   
   lcd_drv->Init();
   
+  InitEnd();
+  ret = LCD_OK;
+  
+  return ret;
+}
+
+/**
+  * @brief  Non blocking LCD initialization (call it from the main loop or a timer while it returns LCD_BUSY)
+  * @param  None
+  * @retval LCD state (LCD_BUSY: in progress, LCD_OK: ready)
+  * @note   The delays of the lcd driver init sequence do not block, only the LCD_IO_Init hardware reset.
+  *         If the lcd driver does not have the InitStep function, it is initialized with the blocking Init.
+  */
+uint8_t BSP_LCD_InitStep(void)
+{
+  #if LCD_MULTI == 1
+  if(LcdCtx == NULL)
+    return LCD_ERROR;
+  #endif
+
+  if(InitStepState == 0)
+  {
+    InitBegin();
+    InitStepState = 1;
+  }
+  else
+    LcdDrawLock();
+
+  if(lcd_drv->InitStep == NULL)
+    lcd_drv->Init();
+  else if(lcd_drv->InitStep())
+  {
+    LcdDrawUnlock();
+    return LCD_BUSY;
+  }
+
+  InitStepState = 0;
+  InitEnd();
+  return LCD_OK;
+}
+
+/* Common part of the BSP_LCD_Init and BSP_LCD_InitStep before the lcd driver init (it locks the draw session) */
+static void InitBegin(void)
+{
+  /* Draw session lock */
+  LcdDrawMutexNew();
+  LcdDrawLock();
+
+  /* Asynchronous image drawing */
+  AsyncInit();
+
+  /* LCD driver select from the controller ID (only at the first call) */
+  #if LCD_AUTODETECT == 1
+  if(lcd_drv == NULL)
+    LCD_Probe();
+  #endif
+}
+
+/* Common part of the BSP_LCD_Init and BSP_LCD_InitStep after the lcd driver init (it unlocks the draw session) */
+static void InitEnd(void)
+{
   /* Default value for draw propriety */
   DrawProp.BackColor = LCD_DEFAULT_BACKCOLOR;
   DrawProp.TextColor = LCD_DEFAULT_TEXTCOLOR;
   DrawProp.pFont     = &LCD_DEFAULT_FONT;
+  #if LCD_CLIP == 1
+  DrawProp.ClipOn    = 0;
+  #endif
   
   /* Clear the LCD screen */
   #if LCD_INIT_CLEAR == 1
   BSP_LCD_Clear(LCD_DEFAULT_BACKCOLOR);
   #endif
   
-  ret = LCD_OK;
-  
-  return ret;
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Begin a draw session (the drawing functions of the other tasks wait until BSP_LCD_Unlock)
+  * @param  None
+  * @retval None
+  */
+void BSP_LCD_Lock(void)
+{
+  LcdDrawLock();
+}
+
+/**
+  * @brief  End a draw session
+  * @param  None
+  * @retval None
+  */
+void BSP_LCD_Unlock(void)
+{
+  LcdDrawUnlock();
 }
 
+#if LCD_MULTI == 1
+/**
+  * @brief  Select the display for the BSP_LCD functions (only LCD_MULTI = 1)
+  * @param  pCtx: display context (lcd driver, io driver, draw properties)
+  * @retval None
+  */
+void BSP_LCD_SetContext(LCD_CtxTypeDef *pCtx)
+{
+  LcdCtx = pCtx;
+  lcd_io = pCtx->pIo;
+}
+
+/**
+  * @brief  Get the selected display (only LCD_MULTI = 1)
+  * @param  None
+  * @retval Display context
+  */
+LCD_CtxTypeDef *BSP_LCD_GetContext(void)
+{
+  return LcdCtx;
+}
+#endif
+
 /**
   * @brief  Gets the LCD X size.
   * @param  None    
@@ -229,7 +441,11 @@ sFONT *BSP_LCD_GetFont(void)
   */
 void BSP_LCD_Clear(uint16_t Color)
 {
-  lcd_drv->FillRect(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize(), Color);
+  uint16_t x = 0, y = 0, w = BSP_LCD_GetXSize(), h = BSP_LCD_GetYSize();
+  LcdDrawLock();
+  if(CLIPRECT(x, y, w, h))
+    lcd_drv->FillRect(x, y, w, h, Color);
+  LcdDrawUnlock();
 }
 
 /**
@@ -244,6 +460,7 @@ void BSP_LCD_Clear(uint16_t Color)
 void BSP_LCD_ClearStringLine(uint16_t Line)
 { 
   uint32_t color_backup = DrawProp.TextColor; 
+  LcdDrawLock();
   DrawProp.TextColor = DrawProp.BackColor;;
     
   /* Draw a rectangle with background color */
@@ -251,6 +468,7 @@ void BSP_LCD_ClearStringLine(uint16_t Line)
   
   DrawProp.TextColor = color_backup;
   BSP_LCD_SetTextColor(DrawProp.TextColor);
+  LcdDrawUnlock();
 }
 
 /**
@@ -263,8 +481,10 @@ void BSP_LCD_ClearStringLine(uint16_t Line)
   */
 void BSP_LCD_DisplayChar(uint16_t Xpos, uint16_t Ypos, uint8_t Ascii)
 {
+  LcdDrawLock();
   DrawChar(Xpos, Ypos, &DrawProp.pFont->table[(Ascii-' ') *\
                         DrawProp.pFont->Height * ((DrawProp.pFont->Width + 7) / 8)]);
+  LcdDrawUnlock();
 }
 
 /**
@@ -302,12 +522,13 @@ void BSP_LCD_DisplayStringOnMultilayerChar(uint16_t Xpos, uint16_t Ypos, uint8_t
 
   if((FONTBITMAPBUFSIZE) < sf->Width)
     return;
+  LcdDrawLock();
   bmsy = (FONTBITMAPBUFSIZE) / sf->Width; /* fontbitmap buf y size */
   ocs = sf->Height * ((sf->Width + 7) / 8);
   onocs = DrawProp.pFont->Height * ((DrawProp.pFont->Width + 7) / 8);
   onchlsize = ((DrawProp.pFont->Width + 7) / 8);
 
-  onwidth = strlen((char *)onChars) * DrawProp.pFont->Width;
+  onwidth = onChars ? strlen((char *)onChars) * DrawProp.pFont->Width : 0;
   if(onX >= sf->Width)
     onX = sf->Width;
   if(onwidth >= sf->Width - onX)
@@ -385,6 +606,7 @@ void BSP_LCD_DisplayStringOnMultilayerChar(uint16_t Xpos, uint16_t Ypos, uint8_t
   {
     BSP_LCD_DrawRGB16Image(Xpos, Ypos + y - ay, sf->Width, ay, fontbitmapbuf);
   }
+  LcdDrawUnlock();
 }
 
 /**
@@ -405,6 +627,7 @@ void BSP_LCD_DisplayStringAt(uint16_t Xpos, uint16_t Ypos, uint8_t *Text, Line_M
   uint32_t size = 0, xsize = 0; 
   uint8_t  *ptr = Text;
   
+  LcdDrawLock();
   /* Get the text size */
   while (*ptr++) size ++ ;
   
@@ -446,6 +669,7 @@ void BSP_LCD_DisplayStringAt(uint16_t Xpos, uint16_t Ypos, uint8_t *Text, Line_M
     Text++;
     i++;
   }
+  LcdDrawUnlock();
 }
 
 /**
@@ -462,7 +686,9 @@ void BSP_LCD_DisplayStringAt(uint16_t Xpos, uint16_t Ypos, uint8_t *Text, Line_M
   */
 void BSP_LCD_DisplayStringAtLine(uint16_t Line, uint8_t *ptr)
 {
+  LcdDrawLock();
   BSP_LCD_DisplayStringAt(0, LINE(Line), ptr, LEFT_MODE);
+  LcdDrawUnlock();
 }
 
 /**
@@ -474,7 +700,13 @@ void BSP_LCD_DisplayStringAtLine(uint16_t Line, uint8_t *ptr)
   */
 void BSP_LCD_DrawPixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGB_Code)
 {
+  #if LCD_CLIP == 1
+  if(DrawProp.ClipOn && (Xpos < DrawProp.ClipX0 || Xpos >= DrawProp.ClipX1 || Ypos < DrawProp.ClipY0 || Ypos >= DrawProp.ClipY1))
+    return;
+  #endif
+  LcdDrawLock();
   lcd_drv->WritePixel(Xpos, Ypos, RGB_Code);
+  LcdDrawUnlock();
 }
   
 /**
@@ -486,7 +718,13 @@ void BSP_LCD_DrawPixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGB_Code)
   */
 void BSP_LCD_DrawHLine(uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  lcd_drv->DrawHLine(DrawProp.TextColor, Xpos, Ypos, Length);
+  #if LCD_CLIP == 1
+  uint16_t h = 1;
+  #endif
+  LcdDrawLock();
+  if(CLIPRECT(Xpos, Ypos, Length, h))
+    lcd_drv->DrawHLine(DrawProp.TextColor, Xpos, Ypos, Length);
+  LcdDrawUnlock();
 }
 
 /**
@@ -498,7 +736,13 @@ void BSP_LCD_DrawHLine(uint16_t Xpos, uint16_t Ypos, uint16_t Length)
   */
 void BSP_LCD_DrawVLine(uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  lcd_drv->DrawVLine(DrawProp.TextColor, Xpos, Ypos, Length);
+  #if LCD_CLIP == 1
+  uint16_t w = 1;
+  #endif
+  LcdDrawLock();
+  if(CLIPRECT(Xpos, Ypos, w, Length))
+    lcd_drv->DrawVLine(DrawProp.TextColor, Xpos, Ypos, Length);
+  LcdDrawUnlock();
 }
 
 /**
@@ -515,6 +759,7 @@ void BSP_LCD_DrawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
   yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0, 
   curpixel = 0;
   
+  LcdDrawLock();
   deltax = ABS(x2 - x1);        /* The difference between the x's */
   deltay = ABS(y2 - y1);        /* The difference between the y's */
   x = x1;                       /* Start x off at the first pixel */
@@ -574,6 +819,7 @@ void BSP_LCD_DrawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
     x += xinc2;                               /* Change the x as appropriate */
     y += yinc2;                               /* Change the y as appropriate */
   }
+  LcdDrawUnlock();
 }
 
 /**
@@ -586,6 +832,7 @@ void BSP_LCD_DrawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
   */
 void BSP_LCD_DrawRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
 {
+  LcdDrawLock();
   /* Draw horizontal lines */
   BSP_LCD_DrawHLine(Xpos, Ypos, Width);
   BSP_LCD_DrawHLine(Xpos, (Ypos + Height - 1), Width);
@@ -593,6 +840,7 @@ void BSP_LCD_DrawRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Hei
   /* Draw vertical lines */
   BSP_LCD_DrawVLine(Xpos, Ypos, Height);
   BSP_LCD_DrawVLine((Xpos + Width - 1), Ypos, Height);
+  LcdDrawUnlock();
 }
                             
 /**
@@ -608,6 +856,7 @@ void BSP_LCD_DrawCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius)
   uint32_t  CurX;   /* Current X Value */
   uint32_t  CurY;   /* Current Y Value */ 
   
+  LcdDrawLock();
   D = 3 - (Radius << 1);
   CurX = 0;
   CurY = Radius;
@@ -634,6 +883,7 @@ void BSP_LCD_DrawCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius)
     }
     CurX++;
   } 
+  LcdDrawUnlock();
 }
 
 /**
@@ -651,6 +901,7 @@ void BSP_LCD_DrawPolygon(pPoint Points, uint16_t PointCount)
     return;
   }
 
+  LcdDrawLock();
   BSP_LCD_DrawLine(Points->X, Points->Y, (Points+PointCount-1)->X, (Points+PointCount-1)->Y);
   
   while(--PointCount)
@@ -660,6 +911,7 @@ void BSP_LCD_DrawPolygon(pPoint Points, uint16_t PointCount)
     Points++;
     BSP_LCD_DrawLine(X, Y, Points->X, Points->Y);
   }
+  LcdDrawUnlock();
 }
 
 /**
@@ -675,6 +927,7 @@ void BSP_LCD_DrawEllipse(uint16_t Xpos, uint16_t Ypos, uint16_t XRadius, uint16_
   int x = 0, y = -YRadius, err = 2-2*XRadius, e2;
   float K = 0, rad1 = 0, rad2 = 0;
   
+  LcdDrawLock();
   rad1 = XRadius;
   rad2 = YRadius;
   
@@ -694,6 +947,7 @@ void BSP_LCD_DrawEllipse(uint16_t Xpos, uint16_t Ypos, uint16_t XRadius, uint16_
     if (e2 > y) err += ++y*2+1;     
   }
   while (y <= 0);
+  LcdDrawUnlock();
 }
 
 /**
@@ -708,15 +962,26 @@ void BSP_LCD_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pBmp)
   uint32_t height = 0;
   uint32_t width  = 0;
   
+  LcdDrawLock();
   /* Read bitmap width */
   width = pBmp[18] + (pBmp[19] << 8) + (pBmp[20] << 16)  + (pBmp[21] << 24);
 
   /* Read bitmap height */
   height = pBmp[22] + (pBmp[23] << 8) + (pBmp[24] << 16)  + (pBmp[25] << 24);
+
+  #if LCD_CLIP == 1
+  if(DrawProp.ClipOn && (Xpos >= DrawProp.ClipX1 || Ypos >= DrawProp.ClipY1 ||
+     Xpos + width <= DrawProp.ClipX0 || Ypos + height <= DrawProp.ClipY0))
+  { /* not visible */
+    LcdDrawUnlock();
+    return;
+  }
+  #endif
   
   SetDisplayWindow(Xpos, Ypos, width, height);
   
   lcd_drv->DrawBitmap(Xpos, Ypos, pBmp);
+  LcdDrawUnlock();
 }
 
 /**
@@ -729,7 +994,10 @@ void BSP_LCD_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pBmp)
   */
 void BSP_LCD_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
 {
-  lcd_drv->FillRect(Xpos, Ypos, Width, Height, DrawProp.TextColor);
+  LcdDrawLock();
+  if(CLIPRECT(Xpos, Ypos, Width, Height))
+    lcd_drv->FillRect(Xpos, Ypos, Width, Height, DrawProp.TextColor);
+  LcdDrawUnlock();
 }
 
 /**
@@ -745,6 +1013,7 @@ void BSP_LCD_FillCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius)
   uint32_t  CurX;    /* Current X Value */
   uint32_t  CurY;    /* Current Y Value */ 
   
+  LcdDrawLock();
   D = 3 - (Radius << 1);
 
   CurX = 0;
@@ -778,6 +1047,7 @@ void BSP_LCD_FillCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius)
   }
 
   BSP_LCD_DrawCircle(Xpos, Ypos, Radius);
+  LcdDrawUnlock();
 }
 
 /**
@@ -822,6 +1092,7 @@ void BSP_LCD_FillPolygon(pPoint Points, uint16_t PointCount)
     return;
   }
   
+  LcdDrawLock();
   X_center = (IMAGE_LEFT + IMAGE_RIGHT)/2;
   Y_center = (IMAGE_BOTTOM + IMAGE_TOP)/2;
   
@@ -844,6 +1115,7 @@ void BSP_LCD_FillPolygon(pPoint Points, uint16_t PointCount)
   BSP_LCD_FillTriangle(X_first, Y_first, X2, Y2, X_center, Y_center);
   BSP_LCD_FillTriangle(X_first, Y_first, X_center, Y_center, X2, Y2);
   BSP_LCD_FillTriangle(X_center, Y_center, X2, Y2, X_first, Y_first);
+  LcdDrawUnlock();
 }
 
 /**
@@ -859,6 +1131,7 @@ void BSP_LCD_FillEllipse(uint16_t Xpos, uint16_t Ypos, uint16_t XRadius, uint16_
   int x = 0, y = -YRadius, err = 2-2*XRadius, e2;
   float K = 0, rad1 = 0, rad2 = 0;
   
+  LcdDrawLock();
   rad1 = XRadius;
   rad2 = YRadius;
   
@@ -878,6 +1151,7 @@ void BSP_LCD_FillEllipse(uint16_t Xpos, uint16_t Ypos, uint16_t XRadius, uint16_
     if (e2 > y) err += ++y*2+1;
   }
   while (y <= 0);
+  LcdDrawUnlock();
 }
 
 /**
@@ -887,7 +1161,9 @@ void BSP_LCD_FillEllipse(uint16_t Xpos, uint16_t Ypos, uint16_t XRadius, uint16_
   */
 void BSP_LCD_DisplayOn(void)
 {
+  LcdDrawLock();
   lcd_drv->DisplayOn();
+  LcdDrawUnlock();
 }
 
 /**
@@ -897,7 +1173,9 @@ void BSP_LCD_DisplayOn(void)
   */
 void BSP_LCD_DisplayOff(void)
 {
+  LcdDrawLock();
   lcd_drv->DisplayOff();
+  LcdDrawUnlock();
 }
 
 /*******************************************************************************
@@ -975,6 +1253,7 @@ void BSP_LCD_FillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, ui
 {
   int16_t a, b, y, last;
 
+  LcdDrawLock();
   // Sort coordinates by Y order (y3 >= y2 >= y1)
   if (y1 > y2)
   {
@@ -995,6 +1274,7 @@ void BSP_LCD_FillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, ui
     if(x3 < a)      a = x3;
     else if(x3 > b) b = x3;
     BSP_LCD_DrawHLine(a, y1, b - a + 1);
+    LcdDrawUnlock();
     return;
   }
 
@@ -1049,6 +1329,7 @@ void BSP_LCD_FillTriangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, ui
     if(a > b) SWAP16(a, b);
     BSP_LCD_DrawHLine(a, y, b - a + 1);
   }
+  LcdDrawUnlock();
 }
 
 /**
@@ -1072,7 +1353,11 @@ static void SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint1
   */
 uint32_t BSP_LCD_ReadID(void)
 {
-  return lcd_drv->ReadID();
+  uint32_t ret;
+  LcdDrawLock();
+  ret = lcd_drv->ReadID();
+  LcdDrawUnlock();
+  return ret;
 }
 
 /**
@@ -1083,7 +1368,11 @@ uint32_t BSP_LCD_ReadID(void)
   */
 uint16_t BSP_LCD_ReadPixel(uint16_t Xpos, uint16_t Ypos)
 {
-  return lcd_drv->ReadPixel(Xpos, Ypos);
+  uint16_t ret;
+  LcdDrawLock();
+  ret = lcd_drv->ReadPixel(Xpos, Ypos);
+  LcdDrawUnlock();
+  return ret;
 }
 
 /**
@@ -1097,8 +1386,275 @@ uint16_t BSP_LCD_ReadPixel(uint16_t Xpos, uint16_t Ypos)
   */
 void BSP_LCD_DrawRGB16Image(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
+  #if LCD_CLIP == 1
+  uint16_t x = Xpos, y = Ypos, w = Xsize, h = Ysize;
+  LcdDrawLock();
+  if(CLIPRECT(x, y, w, h))
+  {
+    pData += (y - Ypos) * Xsize + (x - Xpos);
+    if(w == Xsize)                      /* full rows: one transaction */
+      lcd_drv->DrawRGBImage(x, y, w, h, pData);
+    else
+      while(h--)
+      { /* cut rows: row by row */
+        lcd_drv->DrawRGBImage(x, y++, w, 1, pData);
+        pData += Xsize;
+      }
+  }
+  LcdDrawUnlock();
+  #else
+  LcdDrawLock();
   lcd_drv->DrawRGBImage(Xpos, Ypos, Xsize, Ysize, pData);
+  LcdDrawUnlock();
+  #endif
+}
+
+/* Asynchronous image drawing --------------------------------------------------
+   - the requests are drawn in order, the oldest request is in drawing
+   - no freertos: the next request is started by the DMA end interrupt (LCD_IO_DmaTxEnd), therefore the other
+     drawing functions wait until the queue is empty (AsyncWait), so the interrupt never uses the lcd driver
+     while a drawing function is in progress
+   - freertos: the requests are drawn by the LcdAsync task (with the draw session lock) */
+#if LCD_IO_ASYNC == 1
+
+typedef struct
+{
+  uint16_t Xpos, Ypos, Xsize, Ysize;
+  uint16_t *pData;
+  void     (*Callback)(uint16_t *pData, void *pUser);
+  void     *pUser;
+}LCD_AsyncReqTypeDef;
+
+static struct
+{
+  LCD_AsyncReqTypeDef req[LCD_ASYNC_QUEUE + 1];
+  volatile uint32_t head;               /* next free request */
+  volatile uint32_t tail;               /* oldest request (in drawing) */
+  volatile uint32_t busy;               /* 1: the queue processing is in progress (no freertos) */
+  volatile uint32_t dma;                /* 1: the oldest request waits for the DMA end */
+}lcdasync;
+
+/* io drivers without DMA */
+__weak uint32_t LCD_IO_DmaBusy(void)
+{
+  return 0;
+}
+
+#ifdef  osCMSIS
+#if osCMSIS < 0x20000
+/* Freertos 1 */
+void LcdAsyncTask(void const * argument);
+osThreadId LcdAsyncTaskHandle = NULL;
+osThreadDef(LcdAsync, LcdAsyncTask, LCD_ASYNC_PRIORITY, 0, LCD_ASYNC_STACK);
+osSemaphoreId LcdAsyncWakeHandle, LcdAsyncDmaHandle;
+osSemaphoreDef(LcdAsyncWake);
+osSemaphoreDef(LcdAsyncDma);
+#define AsyncTaskNew()        {LcdAsyncWakeHandle = osSemaphoreCreate(osSemaphore(LcdAsyncWake), 1); osSemaphoreWait(LcdAsyncWakeHandle, 0); \
+                               LcdAsyncDmaHandle = osSemaphoreCreate(osSemaphore(LcdAsyncDma), 1); osSemaphoreWait(LcdAsyncDmaHandle, 0); \
+                               LcdAsyncTaskHandle = osThreadCreate(osThread(LcdAsync), NULL);}
+#define AsyncTaskExist()      (LcdAsyncTaskHandle != NULL)
+#define AsyncWakeSet          osSemaphoreRelease(LcdAsyncWakeHandle)
+#define AsyncWakeWait         osSemaphoreWait(LcdAsyncWakeHandle, osWaitForever)
+#define AsyncDmaSet           osSemaphoreRelease(LcdAsyncDmaHandle)
+#define AsyncDmaWait          osSemaphoreWait(LcdAsyncDmaHandle, osWaitForever)
+#else
+/* Freertos 2 */
+void LcdAsyncTask(void * argument);
+osThreadId_t LcdAsyncTaskHandle = NULL;
+const osThreadAttr_t LcdAsyncAttr = {.name = "LcdAsync", .stack_size = LCD_ASYNC_STACK, .priority = (osPriority_t) LCD_ASYNC_PRIORITY,};
+osSemaphoreId_t LcdAsyncWakeId, LcdAsyncDmaId;
+#define AsyncTaskNew()        {LcdAsyncWakeId = osSemaphoreNew(1, 0, 0); LcdAsyncDmaId = osSemaphoreNew(1, 0, 0); \
+                               LcdAsyncTaskHandle = osThreadNew(LcdAsyncTask, NULL, &LcdAsyncAttr);}
+#define AsyncTaskExist()      (LcdAsyncTaskHandle != NULL)
+#define AsyncWakeSet          osSemaphoreRelease(LcdAsyncWakeId)
+#define AsyncWakeWait         osSemaphoreAcquire(LcdAsyncWakeId, osWaitForever)
+#define AsyncDmaSet           osSemaphoreRelease(LcdAsyncDmaId)
+#define AsyncDmaWait          osSemaphoreAcquire(LcdAsyncDmaId, osWaitForever)
+#endif
+#endif /* #ifdef osCMSIS */
+
+//-----------------------------------------------------------------------------
+/* The oldest request is finished: free the queue place and call the callback
+   return: 1 = there is a next request */
+static uint32_t AsyncDone(void)
+{
+  LCD_AsyncReqTypeDef r = lcdasync.req[lcdasync.tail];
+  uint32_t primask, next;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  lcdasync.tail = (lcdasync.tail + 1) % (LCD_ASYNC_QUEUE + 1);
+  next = (lcdasync.tail != lcdasync.head);
+  if(!next)
+    lcdasync.busy = 0;
+  __set_PRIMASK(primask);
+
+  if(r.Callback)
+    r.Callback(r.pData, r.pUser);
+  return next;
+}
+
+//-----------------------------------------------------------------------------
+/* Draw the oldest request
+   return: 0 = the drawing is finished, 1 = the DMA is in progress (the LCD_IO_DmaTxEnd signals the end) */
+static uint32_t AsyncDraw(void)
+{
+  LCD_AsyncReqTypeDef *r = &lcdasync.req[lcdasync.tail];
+  uint32_t primask, ret;
+
+  lcd_drv->DrawRGBImage(r->Xpos, r->Ypos, r->Xsize, r->Ysize, r->pData);
+
+  /* the DMA may end before this point (then the LCD_IO_DmaTxEnd did nothing) */
+  primask = __get_PRIMASK();
+  __disable_irq();
+  ret = LCD_IO_DmaBusy();
+  lcdasync.dma = ret;
+  __set_PRIMASK(primask);
+  return ret;
+}
+
+#ifndef osCMSIS
+//-----------------------------------------------------------------------------
+/* No freertos: draw the requests while they are finished without DMA */
+static void AsyncRun(void)
+{
+  while(!AsyncDraw())
+  {
+    if(!AsyncDone())
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* Called by the io driver from the DMA interrupt */
+void LCD_IO_DmaTxEnd(void)
+{
+  if(lcdasync.dma)
+  {
+    lcdasync.dma = 0;
+    if(AsyncDone())
+      AsyncRun();
+  }
+}
+
+static void AsyncInit(void)
+{
+}
+
+//-----------------------------------------------------------------------------
+/* The drawing functions wait until the queued images are drawn (LcdDrawLock) */
+static void AsyncWait(void)
+{
+  while(lcdasync.busy);
+}
+
+#else  /* #ifndef osCMSIS */
+//-----------------------------------------------------------------------------
+/* Called by the io driver from the DMA interrupt */
+void LCD_IO_DmaTxEnd(void)
+{
+  if(lcdasync.dma)
+  {
+    lcdasync.dma = 0;
+    AsyncDmaSet;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* Freertos: the requests are drawn in this task */
+#if osCMSIS < 0x20000
+void LcdAsyncTask(void const * argument)
+#else
+void LcdAsyncTask(void * argument)
+#endif
+{
+  while(1)
+  {
+    AsyncWakeWait;
+    while(lcdasync.tail != lcdasync.head)
+    {
+      BSP_LCD_Lock();
+      if(AsyncDraw())
+        AsyncDmaWait;
+      BSP_LCD_Unlock();
+      AsyncDone();
+    }
+  }
+}
+
+static void AsyncInit(void)
+{
+  if(!AsyncTaskExist())
+    AsyncTaskNew();
+}
+#endif /* #else osCMSIS */
+
+/**
+  * @brief  Draw RGB565 image without waiting (draw direction: right then down)
+  * @param  Xpos: LCD X position
+  * @param  Ypos: LCD Y position
+  * @param  Width: image width
+  * @param  Height: image height
+  * @param  *pData: image data pointer (it must not be modified until the callback)
+  * @param  Callback: called when the pData buffer is free (can be NULL)
+  * @param  pUser: user pointer for the callback
+  * @retval LCD_OK: the image is queued, LCD_ERROR: the queue is full
+  */
+uint8_t BSP_LCD_DrawRGB16ImageAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData,
+                                    void (*Callback)(uint16_t *pData, void *pUser), void *pUser)
+{
+  LCD_AsyncReqTypeDef *r;
+  uint32_t primask, h, start = 0;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  h = (lcdasync.head + 1) % (LCD_ASYNC_QUEUE + 1);
+  if(h == lcdasync.tail)
+  { /* the queue is full */
+    __set_PRIMASK(primask);
+    return LCD_ERROR;
+  }
+  r = &lcdasync.req[lcdasync.head];
+  r->Xpos = Xpos;
+  r->Ypos = Ypos;
+  r->Xsize = Xsize;
+  r->Ysize = Ysize;
+  r->pData = pData;
+  r->Callback = Callback;
+  r->pUser = pUser;
+  lcdasync.head = h;
+  if(!lcdasync.busy)
+  {
+    lcdasync.busy = 1;
+    start = 1;
+  }
+  __set_PRIMASK(primask);
+
+  #ifndef osCMSIS
+  if(start)
+    AsyncRun();
+  #else
+  (void)start;
+  AsyncWakeSet;
+  #endif
+  return LCD_OK;
+}
+
+#else  /* #if LCD_IO_ASYNC == 1 */
+/* LCD_IO_ASYNC = 0: the image is drawn immediately, then the callback is called */
+static void AsyncInit(void)
+{
+}
+
+uint8_t BSP_LCD_DrawRGB16ImageAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData,
+                                    void (*Callback)(uint16_t *pData, void *pUser), void *pUser)
+{
+  BSP_LCD_DrawRGB16Image(Xpos, Ypos, Xsize, Ysize, pData);
+  if(Callback)
+    Callback(pData, pUser);
+  return LCD_OK;
 }
+#endif /* #else LCD_IO_ASYNC == 1 */
 
 /**
   * @brief  Read RGB565 image (draw direction: right then down)
@@ -1111,7 +1667,79 @@ void BSP_LCD_DrawRGB16Image(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16
   */
 void BSP_LCD_ReadRGB16Image(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData)
 {
+  LcdDrawLock();
   lcd_drv->ReadRGBImage(Xpos, Ypos, Xsize, Ysize, pData);
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Copy a rectangle area of the screen to other position (the areas can overlap)
+  * @param  SrcX: source X position
+  * @param  SrcY: source Y position
+  * @param  DstX: destination X position
+  * @param  DstY: destination Y position
+  * @param  Width: area width
+  * @param  Height: area height
+  * @retval None
+  */
+void BSP_LCD_CopyRect(uint16_t SrcX, uint16_t SrcY, uint16_t DstX, uint16_t DstY, uint16_t Width, uint16_t Height)
+{
+  uint16_t bw, bh, x, y, w, h;
+  if((Width == 0) || (Height == 0) || ((SrcX == DstX) && (SrcY == DstY)))
+    return;
+
+  /* block size: more full rows, or one part of a row when the row does not fit in the buffer */
+  if(Width <= COPYRECTBUFSIZE)
+  {
+    bw = Width;
+    bh = COPYRECTBUFSIZE / Width;
+  }
+  else
+  {
+    bw = COPYRECTBUFSIZE;
+    bh = 1;
+  }
+
+  /* every block is read before it is written, the order of the blocks guarantees that the
+     destination only overwrites source pixels that are already copied:
+     - down (DstY > SrcY): from the bottom, up: from the top
+     - same rows, right (DstX > SrcX): from the right, left: from the left */
+  LcdDrawLock();
+  for(y = 0; y < Height; y += h)
+  {
+    h = (Height - y < bh) ? Height - y : bh;
+    for(x = 0; x < Width; x += w)
+    {
+      w = (Width - x < bw) ? Width - x : bw;
+      if(DstY > SrcY)
+      {
+        if(DstX > SrcX)
+        {
+          lcd_drv->ReadRGBImage(SrcX + Width - x - w, SrcY + Height - y - h, w, h, copyrectbuf);
+          lcd_drv->DrawRGBImage(DstX + Width - x - w, DstY + Height - y - h, w, h, copyrectbuf);
+        }
+        else
+        {
+          lcd_drv->ReadRGBImage(SrcX + x, SrcY + Height - y - h, w, h, copyrectbuf);
+          lcd_drv->DrawRGBImage(DstX + x, DstY + Height - y - h, w, h, copyrectbuf);
+        }
+      }
+      else
+      {
+        if(DstX > SrcX)
+        {
+          lcd_drv->ReadRGBImage(SrcX + Width - x - w, SrcY + y, w, h, copyrectbuf);
+          lcd_drv->DrawRGBImage(DstX + Width - x - w, DstY + y, w, h, copyrectbuf);
+        }
+        else
+        {
+          lcd_drv->ReadRGBImage(SrcX + x, SrcY + y, w, h, copyrectbuf);
+          lcd_drv->DrawRGBImage(DstX + x, DstY + y, w, h, copyrectbuf);
+        }
+      }
+    }
+  }
+  LcdDrawUnlock();
 }
 
 /**
@@ -1123,8 +1751,253 @@ void BSP_LCD_ReadRGB16Image(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16
   */
 void BSP_LCD_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
 {
+  LcdDrawLock();
   lcd_drv->Scroll(Scroll, TopFix, BottonFix);
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Set the display orientation
+  * @param  Orientation : 0..3 (see the xxx_ORIENTATION setting in the lcd driver header)
+  * @retval None
+  */
+void BSP_LCD_SetOrientation(uint8_t Orientation)
+{
+  if(lcd_drv->SetOrientation == NULL)
+    return;
+  LcdDrawLock();
+  lcd_drv->SetOrientation(Orientation);
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Get the number of the off-screen GRAM rows
+  * @param  None
+  * @retval the rows after the visible area (0: the lcd driver or the orientation does not support it)
+  */
+uint16_t BSP_LCD_GetOffscreenLines(void)
+{
+  if(lcd_drv->GetOffscreenLines == NULL)
+    return 0;
+  return lcd_drv->GetOffscreenLines();
+}
+
+/**
+  * @brief  Set the first visible row (the off-screen rows are scrolled into the view)
+  * @param  Ypos : first visible row (0 .. BSP_LCD_GetYSize() + BSP_LCD_GetOffscreenLines() - 1)
+  * @retval None
+  */
+void BSP_LCD_SetVisibleY(uint16_t Ypos)
+{
+  if(lcd_drv->SetVisibleY == NULL)
+    return;
+  LcdDrawLock();
+  lcd_drv->SetVisibleY(Ypos);
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Set the pixel write bitdepth (e.g. ST7789_WRITEBITDEPTH 12: 12 or 16)
+  * @param  BitDepth : 12 (RGB444, 1.5 byte / pixel), 16 (RGB565, 2 byte / pixel), 0: only query
+  * @retval the active write bitdepth (0: the lcd driver does not have this function)
+  */
+uint8_t BSP_LCD_SetWriteBitDepth(uint8_t BitDepth)
+{
+  uint8_t bd;
+  if(lcd_drv->SetWriteBitDepth == NULL)
+    return 0;
+  LcdDrawLock();
+  bd = lcd_drv->SetWriteBitDepth(BitDepth);
+  LcdDrawUnlock();
+  return bd;
+}
+
+#if LCD_CLIP == 1
+/**
+  * @brief  Set the clip rectangle (the drawing functions draw only inside it)
+  * @param  Xpos, Ypos : top left corner
+  * @param  Width, Height : size (0: nothing is drawn)
+  * @retval None
+  */
+void BSP_LCD_SetClipRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+  LcdDrawLock();
+  DrawProp.ClipX0 = Xpos;
+  DrawProp.ClipY0 = Ypos;
+  DrawProp.ClipX1 = (Xpos + Width > 0xFFFF) ? 0xFFFF : Xpos + Width;
+  DrawProp.ClipY1 = (Ypos + Height > 0xFFFF) ? 0xFFFF : Ypos + Height;
+  DrawProp.ClipOn = 1;
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Disable the clip rectangle
+  * @param  None
+  * @retval None
+  */
+void BSP_LCD_ResetClipRect(void)
+{
+  LcdDrawLock();
+  DrawProp.ClipOn = 0;
+  LcdDrawUnlock();
+}
+#endif /* #if LCD_CLIP == 1 */
+
+#if LCD_TE == 1
+/* MIPI-DCS tearing effect commands */
+#define LCD_CMD_TEOFF         0x34
+#define LCD_CMD_TEON          0x35
+#define LCD_CMD_STE           0x44
+
+/* The refresh period is measured from this number of TE periods (power of 2) */
+#define LCD_TE_AVG            16
+
+static volatile uint32_t TeCount = 0;   /* TE signal counter */
+static volatile uint32_t TeTime;        /* time of the last TE signal */
+static volatile uint32_t TePeriod = 0;  /* refresh period (0: not yet measured) */
+static uint32_t TeAvgTime;              /* time of the refresh period measure start */
+static uint32_t TeLastFrame = 0;        /* TeCount of the last presented frame (0: no presented frame) */
+static uint16_t TeScanline = 0;         /* the scan line at the TE signal */
+static LCD_TeStatTypeDef TeStat;
+
+/**
+  * @brief  Enable the TE output of the display
+  * @param  Scanline : the TE signal starts at this line (0: vertical blanking)
+  * @retval None
+  */
+void BSP_LCD_TeOn(uint16_t Scanline)
+{
+  uint8_t d[2];
+  LcdDrawLock();
+  lcd_drv->UserCommand(LCD_CMD_TEON, (uint8_t *)"\x00", 1, 0);
+  if(Scanline)
+  {
+    d[0] = Scanline >> 8;
+    d[1] = Scanline;
+    lcd_drv->UserCommand(LCD_CMD_STE, d, 2, 0);
+  }
+  TeScanline = Scanline;
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  Disable the TE output of the display
+  * @param  None
+  * @retval None
+  */
+void BSP_LCD_TeOff(void)
+{
+  LcdDrawLock();
+  lcd_drv->UserCommand(LCD_CMD_TEOFF, NULL, 0, 0);
+  LcdDrawUnlock();
+}
+
+/**
+  * @brief  TE signal (call it from the TE pin rising edge interrupt)
+  * @param  None
+  * @retval None
+  */
+void BSP_LCD_TeIrq(void)
+{
+  uint32_t t = LCD_TE_GETTIME();
+  if((TeCount & (LCD_TE_AVG - 1)) == 0)
+  {
+    if(TeCount)
+      TePeriod = (t - TeAvgTime) / LCD_TE_AVG;
+    TeAvgTime = t;
+  }
+  TeTime = t;
+  TeCount++;
+}
+
+/**
+  * @brief  Draw a frame synchronized to the TE signal
+  * @param  Ypos, Height : the area of the frame
+  * @param  BandHeight : band height (the DrawBand callback draws one band)
+  * @param  DrawBand : band drawing function
+  * @retval LCD_OK or LCD_TIMEOUT
+  */
+uint8_t BSP_LCD_PresentFrame(uint16_t Ypos, uint16_t Height, uint16_t BandHeight, void (*DrawBand)(uint16_t Ypos, uint16_t Height))
+{
+  uint32_t c, t, t0, p, y, h;
+  int32_t  lines = BSP_LCD_GetYSize();
+  uint8_t  missed = 0;
+
+  if(BandHeight == 0 || BandHeight > Height)
+    BandHeight = Height;
+
+  /* The last TE signal is used if it has not been used yet and it came less than a half period ago,
+     else waiting for the next */
+  c = TeCount;
+  t = LCD_TE_GETTIME();
+  if(TeLastFrame == 0 || c == TeLastFrame || TePeriod == 0 || t - TeTime >= TePeriod / 2)
+  {
+    while(TeCount == c)
+    {
+      if(LCD_TE_GETTIME() - t >= (uint32_t)LCD_TE_TIMEOUT * (LCD_TE_TIMEFREQ / 1000))
+      {
+        TeStat.Timeouts++;
+        return LCD_TIMEOUT;
+      }
+    }
+  }
+  do
+  {
+    c = TeCount;
+    t0 = TeTime;
+  }while(c != TeCount);
+  p = TePeriod;
+  if(TeLastFrame && c - TeLastFrame > 1)
+    TeStat.Skipped += c - TeLastFrame - 1;
+  TeLastFrame = c;
+
+  LcdDrawLock();
+  for(y = Ypos; y < Ypos + Height; y += h)
+  {
+    h = Ypos + Height - y;
+    if(h > BandHeight)
+      h = BandHeight;
+
+    /* Waiting for the scan line to pass the bottom of the band */
+    if(p)
+      while((int32_t)(LCD_TE_GETTIME() - t0) < (int32_t)(((int64_t)y + h - TeScanline) * p / lines));
+
+    DrawBand(y, h);
+
+    /* Deadline: the scan line of the next refresh reaches the top of the band */
+    if(p && (int32_t)(LCD_TE_GETTIME() - t0) > (int32_t)p + (int32_t)(((int64_t)y - TeScanline) * p / lines))
+      missed = 1;
+  }
+  LcdDrawUnlock();
+
+  TeStat.Frames++;
+  TeStat.Missed += missed;
+  TeStat.FrameTime = LCD_TE_GETTIME() - t0;
+  return LCD_OK;
+}
+
+/**
+  * @brief  Frame presentation statistics
+  * @param  pStat : statistics
+  * @retval None
+  */
+void BSP_LCD_TeStatGet(LCD_TeStatTypeDef *pStat)
+{
+  *pStat = TeStat;
+  pStat->Period = TePeriod;
+}
+
+/**
+  * @brief  Clear the frame presentation statistics
+  * @param  None
+  * @retval None
+  */
+void BSP_LCD_TeStatReset(void)
+{
+  memset(&TeStat, 0, sizeof(TeStat));
+  TeLastFrame = 0;
 }
+#endif /* #if LCD_TE == 1 */
 
 /**
   * @brief  User direct Lcd write and read
@@ -1135,19 +2008,27 @@ void BSP_LCD_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix)
   */
 void BSP_LCD_DataWrite8(uint16_t Cmd, uint8_t *ptr, uint32_t Size)
 {
+  LcdDrawLock();
   lcd_drv->UserCommand(Cmd, ptr, Size, 0);
+  LcdDrawUnlock();
 }
 void BSP_LCD_DataWrite16(uint16_t Cmd, uint16_t *ptr, uint32_t Size)
 {
+  LcdDrawLock();
   lcd_drv->UserCommand(Cmd, (uint8_t *)ptr, Size, 1);
+  LcdDrawUnlock();
 }
 void BSP_LCD_DataRead8(uint16_t Cmd, uint8_t *ptr, uint32_t Size)
 {
+  LcdDrawLock();
   lcd_drv->UserCommand(Cmd, ptr, Size, 2);
+  LcdDrawUnlock();
 }
 void BSP_LCD_DataRead16(uint16_t Cmd, uint16_t *ptr, uint32_t Size)
 {
+  LcdDrawLock();
   lcd_drv->UserCommand(Cmd, (uint8_t *)ptr, Size, 2);
+  LcdDrawUnlock();
 }
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
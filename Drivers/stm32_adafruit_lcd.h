@@ -9,6 +9,16 @@
  - 2022.11 Modify ReadID return type: uint16_t to uint32_t
  - 2023.03 Add BSP_LCD_DisplayMultilayerChar function (mainly for drawing icons and buttons)
  - 2023.03 Add BSP_LCD_DisplayStringOnMultilayerChar function (mainly for drawing texticons and textbuttons)
+ - 2026.10 Add LCD_DRAW_LOCK, BSP_LCD_Lock, BSP_LCD_Unlock (multi task drawing with freertos)
+ - 2026.10 Add BSP_LCD_DrawRGB16ImageAsync (non blocking image drawing with completion callback)
+ - 2026.10 Add BSP_LCD_SetOrientation (runtime display rotation)
+ - 2026.10 Add LCD_CtxTypeDef, BSP_LCD_SetContext, BSP_LCD_GetContext (more displays, LCD_MULTI in the lcd.h)
+ - 2026.10 Add BSP_LCD_InitStep, LCD_BUSY (non blocking initialization)
+ - 2026.10 Add LCD_TE, BSP_LCD_TeOn, BSP_LCD_TeOff, BSP_LCD_TeIrq, BSP_LCD_PresentFrame (tearing effect synchronized drawing)
+ - 2026.10 Add BSP_LCD_GetOffscreenLines, BSP_LCD_SetVisibleY (off-screen GRAM rows, e.g. 240x240 panel with ST7789)
+ - 2026.10 Add BSP_LCD_SetWriteBitDepth (12 bit RGB444 write mode, e.g. ST7789_WRITEBITDEPTH 12)
+ - 2026.10 Add BSP_LCD_CopyRect (screen to screen copy, e.g. window moving, horizontal scroll)
+ - 2026.10 Modify LCD_COLOR, LCD_COLOR16, RC: the color codes are converted to the LCD_PIXFMT format (lcd.h)
 */
 
 /**
@@ -68,6 +78,9 @@
 /* Font bitmap buffer size (even for the largest font size, at least one line should fit in it) */
 #define FONTBITMAPBUFSIZE     24 * 16
 
+/* BSP_LCD_CopyRect buffer size [pixel] (the area is copied in blocks of this size, e.g. 2 rows: 2 * 320) */
+#define COPYRECTBUFSIZE       2 * 320
+
 /* BSP_LCD_DisplayMultilayerChar max layer */
 #define MAX_CHAR_LAYER        12
 
@@ -78,6 +91,41 @@
 /* LCD clear with LCD_DEFAULT_BACKCOLOR in the BSP_LCD_Init (0:diasble, 1:enable) */
 #define LCD_INIT_CLEAR        0
 
+/* Draw session lock (only with freertos, if more tasks draw to the display)
+   - 0: no lock (one task draws, or the application serializes the drawing)
+   - 1: every BSP_LCD drawing function is atomic (window setting + data transactions are not interleaved)
+        the lock is a recursive mutex with priority inheritance, created in the BSP_LCD_Init
+        more drawing functions and the draw properties can be locked together with BSP_LCD_Lock / BSP_LCD_Unlock
+   note: with LCD_IO_ASYNC = 1 the lock is always on (the LcdAsync task draws beside the application tasks) */
+#define LCD_DRAW_LOCK         0
+
+/* BSP_LCD_DrawRGB16ImageAsync request queue length (only with LCD_IO_ASYNC = 1 in the lcd_io.h) */
+#define LCD_ASYNC_QUEUE       4
+
+/* BSP_LCD_DrawRGB16ImageAsync drawing task stack size (freertos 1: word, freertos 2: byte) and priority (only freertos) */
+#define LCD_ASYNC_STACK       256
+#define LCD_ASYNC_PRIORITY    osPriorityAboveNormal
+
+/* Tearing effect synchronized frame presentation (BSP_LCD_PresentFrame)
+   - 0: disabled (default)
+   - 1: enabled (the interrupt of the display TE pin must call the BSP_LCD_TeIrq, e.g. from the HAL_GPIO_EXTI_Callback,
+        on the host: LCD_IO_HostTeConfig(16, BSP_LCD_TeIrq))
+   note: only the MIPI-DCS controllers have TE command (ILI9341, ST7789, ST7735, ILI9486, ILI9488) */
+#define LCD_TE                0
+
+/* Time source of the frame presentation (default: 1ms HAL tick, the DWT cycle counter gives more precise band timing,
+   e.g. DWT->CYCCNT and SystemCoreClock) */
+#define LCD_TE_GETTIME()      HAL_GetTick()
+#define LCD_TE_TIMEFREQ       1000
+
+/* TE signal wait timeout [ms] */
+#define LCD_TE_TIMEOUT        100
+
+/* Clip rectangle (BSP_LCD_SetClipRect)
+   - 0: disabled (default, no overhead in the drawing functions)
+   - 1: enabled (the drawing functions draw only the pixels inside the clip rectangle, e.g. for the lcd_widget.c) */
+#define LCD_CLIP              0
+
 /* some colors */
 #define LCD_COLOR_BLACK       LCD_COLOR(0, 0, 0)
 #define LCD_COLOR_GRAY        LCD_COLOR(192, 192, 192)
@@ -100,8 +148,39 @@ typedef struct
   uint32_t TextColor;
   uint32_t BackColor;
   sFONT    *pFont; 
+  #if LCD_CLIP == 1
+  uint8_t  ClipOn;                      /* 0: no clip, 1: the clip rectangle is active */
+  uint16_t ClipX0, ClipY0;              /* clip rectangle top left corner */
+  uint16_t ClipX1, ClipY1;              /* clip rectangle bottom right corner + 1 */
+  #endif
 }LCD_DrawPropTypeDef;
 
+/** 
+  * @brief  Display context structures definition (only LCD_MULTI = 1 in the lcd.h)
+  * @note   the io runtime state (DMA status, handles, semaphores) and the pins are not in the context, they are
+  *         static in the io driver source file, so two displays on the same io driver type (e.g. two SPI ports)
+  *         need two copies of the io driver file (with different LCD_IO_NAME and pin settings)
+  */ 
+typedef struct
+{
+  LCD_DrvTypeDef      *pDrv;            /* lcd driver (e.g. &ili9341_drv) */
+  LCD_IO_DrvTypeDef   *pIo;             /* io driver (e.g. &lcd_io_spi_drv, one display per io driver file) */
+  LCD_DrawPropTypeDef DrawProp;         /* text color, back color, font (BSP_LCD_Init sets the default) */
+}LCD_CtxTypeDef;
+
+/** 
+  * @brief  Frame presentation statistics (only LCD_TE = 1)
+  */ 
+typedef struct
+{
+  uint32_t Frames;                      /* presented frames */
+  uint32_t Missed;                      /* frames with a band that was finished after its deadline (tearing is possible) */
+  uint32_t Skipped;                     /* display refreshes without new frame (the frame rate was lower than the refresh rate) */
+  uint32_t Timeouts;                    /* no TE signal in LCD_TE_TIMEOUT time */
+  uint32_t Period;                      /* measured refresh period (LCD_TE_TIMEFREQ unit, 0: not yet measured) */
+  uint32_t FrameTime;                   /* last frame drawing time from the TE signal (LCD_TE_TIMEFREQ unit) */
+}LCD_TeStatTypeDef;
+
 /** 
   * @brief  Point structures definition
   */ 
@@ -129,23 +208,39 @@ typedef enum
 #define LCD_OK         0x00
 #define LCD_ERROR      0x01
 #define LCD_TIMEOUT    0x02
+#define LCD_BUSY       0x03
 
-#if LCD_REVERSE16 == 1
-#define  RC(a)   ((((a) & 0xFF) << 8) | (((a) & 0xFF00) >> 8))
-#else
-#define  RC(a)   a
-#endif
+/* RGB565 color code -> LCD_PIXFMT color code (old name, see LCD_PIXFMT16 in the lcd.h) */
+#define  RC(a)   LCD_PIXFMT16(a)
 
 /** 
-  * @brief  LCD color  
+  * @brief  LCD color (in the LCD_PIXFMT format)
   */
-#define LCD_COLOR(r, g, b)      (RC((r & 0xF8) << 8 | (g & 0xFC) << 3 | (b & 0xF8) >> 3))
-#define LCD_COLOR16(rgb16)      (RC(rgb16))
+#define LCD_COLOR(r, g, b)      (LCD_PIXFMT16((r & 0xF8) << 8 | (g & 0xFC) << 3 | (b & 0xF8) >> 3))
+#define LCD_COLOR16(rgb16)      (LCD_PIXFMT16(rgb16))
 
 /** @defgroup STM32_ADAFRUIT_LCD_Exported_Functions
   * @{
   */   
 uint8_t  BSP_LCD_Init(void);
+
+/* Non blocking initialization, e.g.: while(BSP_LCD_InitStep() == LCD_BUSY) { other tasks ... }
+   note: with LCD_MULTI = 1 initialize the displays one after the other */
+uint8_t  BSP_LCD_InitStep(void);
+
+/* Draw session (LCD_DRAW_LOCK = 1 or LCD_IO_ASYNC = 1 with freertos, it can be nested), e.g.:
+   BSP_LCD_Lock(); BSP_LCD_SetTextColor(c); BSP_LCD_DrawRect(x, y, w, h); BSP_LCD_Unlock(); */
+void     BSP_LCD_Lock(void);
+void     BSP_LCD_Unlock(void);
+
+/* Multi display mode (LCD_MULTI = 1 in the lcd.h): the BSP_LCD functions draw to the selected display, e.g.:
+   extern LCD_DrvTypeDef ili9341_drv, st7735_drv; extern LCD_IO_DrvTypeDef lcd_io_spi_drv, lcd_io_spi2_drv;
+   LCD_CtxTypeDef lcd1 = {&ili9341_drv, &lcd_io_spi_drv}, lcd2 = {&st7735_drv, &lcd_io_spi2_drv};
+   BSP_LCD_SetContext(&lcd1); BSP_LCD_Init(); BSP_LCD_SetContext(&lcd2); BSP_LCD_Init(); ...
+   note: the DMA transactions of the displays can run at the same time (e.g. LCD_DMA_ENDWAIT = 0 in the io drivers),
+         with LCD_DRAW_LOCK = 1 the BSP_LCD_SetContext and the drawing must be in one BSP_LCD_Lock session */
+void     BSP_LCD_SetContext(LCD_CtxTypeDef *pCtx);
+LCD_CtxTypeDef *BSP_LCD_GetContext(void);
 uint16_t BSP_LCD_GetXSize(void);
 uint16_t BSP_LCD_GetYSize(void);
  
@@ -186,8 +281,69 @@ uint32_t BSP_LCD_ReadID(void);
 uint16_t BSP_LCD_ReadPixel(uint16_t Xpos, uint16_t Ypos);
 void     BSP_LCD_DrawRGB16Image(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
 void     BSP_LCD_ReadRGB16Image(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+
+/* Screen to screen copy (e.g. window moving, horizontal scroll), the source and destination areas can overlap
+   - the area is copied in COPYRECTBUFSIZE pixel blocks (read, then write), it does not need a full area buffer
+   note: the lcd driver must support the reading (ReadRGBImage), in 12 bit write mode the colors are truncated */
+void     BSP_LCD_CopyRect(uint16_t SrcX, uint16_t SrcY, uint16_t DstX, uint16_t DstY, uint16_t Width, uint16_t Height);
+
+/* Non blocking image drawing (LCD_IO_ASYNC = 1 in the lcd_io.h)
+   - the image is queued and drawn in the background, pData must not be modified until the Callback is called
+   - Callback(pData, pUser): called when the pData buffer is free (from DMA interrupt or freertos drawing task context)
+   - no freertos: the next queued image is started from the DMA interrupt, so the other BSP_LCD drawing functions
+     wait until all queued images are drawn, do not call them from the Callback
+   - freertos: the images are drawn by the LcdAsync task in a draw session (BSP_LCD_Lock, the draw lock is on
+     with LCD_IO_ASYNC = 1 independently of the LCD_DRAW_LOCK setting)
+   - return: LCD_OK or LCD_ERROR (the queue is full) */
+uint8_t  BSP_LCD_DrawRGB16ImageAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData,
+                                     void (*Callback)(uint16_t *pData, void *pUser), void *pUser);
 void     BSP_LCD_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
 
+/* Display rotation in runtime (Orientation: 0..3, see the xxx_ORIENTATION setting in the lcd driver header)
+   note: the screen content is not rotated, it must be redrawn, BSP_LCD_GetXSize and BSP_LCD_GetYSize follow the new orientation */
+void     BSP_LCD_SetOrientation(uint8_t Orientation);
+
+/* Off-screen GRAM rows (when the GRAM is higher than the panel, see ST7789_GRAM_HEIGHT, ST7735_GRAM_HEIGHT)
+   - the rows YSize .. YSize + OffscreenLines - 1 are not visible, they can be drawn with the BSP_LCD functions
+   - BSP_LCD_SetVisibleY: the visible rows are Ypos .. Ypos + YSize - 1 (modulo YSize + OffscreenLines), the new
+     content prepared in the off-screen rows appears in one step (VSCRSADD, the scroll fix areas are cleared)
+   note: only in the portrait orientations, a drawing window must not cross the row YSize (the visible and
+         off-screen rows are not continuous in the GRAM in every orientation) */
+uint16_t BSP_LCD_GetOffscreenLines(void);
+void     BSP_LCD_SetVisibleY(uint16_t Ypos);
+
+/* Pixel write bitdepth in runtime (only the lcd drivers compiled with 12 bit write mode, e.g. ST7789_WRITEBITDEPTH 12)
+   - 12: RGB444 (the RGB565 colors are truncated, 25% less bus bytes), 16: RGB565, 0: only query
+   - return: the active write bitdepth (0: the lcd driver does not have this function)
+   note: the drawing functions use RGB565 colors in both modes, the readed pixels contain the truncated colors */
+uint8_t  BSP_LCD_SetWriteBitDepth(uint8_t BitDepth);
+
+/* Clip rectangle (LCD_CLIP = 1)
+   - BSP_LCD_SetClipRect: the drawing functions draw only the pixels inside the rectangle (pixel, line, rectangle,
+     shapes, text, RGB16 image), the image rows are cut, so only the visible pixels are sent to the display
+   - BSP_LCD_ResetClipRect: no clip
+   note: BSP_LCD_DrawBitmap is drawn entirely if it is partially visible, BSP_LCD_CopyRect and
+         BSP_LCD_DrawRGB16ImageAsync are not clipped */
+void     BSP_LCD_SetClipRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+void     BSP_LCD_ResetClipRect(void);
+
+/* Tearing effect synchronized frame presentation (LCD_TE = 1)
+   - BSP_LCD_TeOn: enables the TE output of the display (Scanline: 0 = vertical blanking, other: STE scanline)
+   - BSP_LCD_TeIrq: it must be called from the TE pin rising edge interrupt
+   - BSP_LCD_PresentFrame: waits for the TE signal, then draws the Ypos..Ypos+Height-1 area in BandHeight high bands
+     with the DrawBand(Ypos, Height) callback, every band is drawn after the display scan line has passed it, so the
+     writes chase the scan line and the next refresh shows the full new frame (the band must be drawn until the scan
+     line reaches it again, if not, the Missed counter is incremented)
+     return: LCD_OK or LCD_TIMEOUT (no TE signal)
+   note: the display refresh must run from the top (Ypos = 0) to the bottom (the default orientation of the
+         ILI9341, ST7789), the DrawBand must finish the drawing before it returns (blocking BSP_LCD functions) */
+void     BSP_LCD_TeOn(uint16_t Scanline);
+void     BSP_LCD_TeOff(void);
+void     BSP_LCD_TeIrq(void);
+uint8_t  BSP_LCD_PresentFrame(uint16_t Ypos, uint16_t Height, uint16_t BandHeight, void (*DrawBand)(uint16_t Ypos, uint16_t Height));
+void     BSP_LCD_TeStatGet(LCD_TeStatTypeDef *pStat);
+void     BSP_LCD_TeStatReset(void);
+
 /* User direct Lcd data write and read */
 void     BSP_LCD_DataWrite8(uint16_t Cmd, uint8_t *ptr, uint32_t Size);
 void     BSP_LCD_DataWrite16(uint16_t Cmd, uint16_t *ptr, uint32_t Size);
@@ -9,8 +9,56 @@ uint16_t TsXBoundary, TsYBoundary;
 #define MAXCINT1245           262144
 #define MAXCINT36             1073741824
 
+/* double -> Q16 with rounding (least squares calibration) */
+#define Q16(v)                ((int32_t)((v) * 65536 + ((v) < 0 ? -0.5 : 0.5)))
+
 ts_cindex cindex = TS_CINDEX;
 
+/* Q16 affine matrix from the cindex (display x = (m[0] * tx + m[1] * ty + m[2]) >> 16, y: m[3..5])
+   it is calculated when the cindex changes, so the coordinate calculation does not need division */
+static int32_t tsmat[6];
+
+#if TS_EVENT_QUEUE > 0
+#define ABS(X)                ((X) > 0 ? (X) : -(X))
+#define LIMIT16(X)            ((X) > 32767 ? 32767 : (X) < -32767 ? -32767 : (X))
+
+/* free places needed for the events: the last place is reserved for the release, the move and drag events
+   leave one more place for the flick (so every queued press gets its release) */
+#define TS_EVENT_RESERVE      1
+
+/* sampler state flags */
+#define TS_EVF_LONGPRESS      1
+#define TS_EVF_DRAG           2
+#define TS_EVF_NOPRESS        4         /* the press did not fit: the events of this touch are dropped */
+
+/* event ring buffer (one writer: BSP_TS_Sample, one reader: BSP_TS_GetEvent) */
+static volatile TS_EventTypeDef ts_events[TS_EVENT_QUEUE];
+static volatile uint32_t ts_evhead = 0, ts_evtail = 0, ts_evlost = 0;
+
+/* sampler state */
+static struct
+{
+  uint8_t  touch;                       /* debounced touch state */
+  uint8_t  cnt;                         /* debounce counter */
+  uint8_t  flags;                       /* TS_EVF_... */
+  uint16_t x, y;                        /* last position */
+  uint16_t px, py;                      /* press position */
+  uint32_t t, pt;                       /* last sample time, press time */
+  int32_t  vx, vy;                      /* velocity [pixel / s] */
+}tse;
+#endif
+
+//-----------------------------------------------------------------------------
+/* cindex -> Q16 matrix (the only division: once per cindex change) */
+static void TsMatrixCalc(void)
+{
+  uint32_t i;
+  for(i = 0; i < 6; i++)
+    tsmat[i] = cindex[0] ? (int32_t)(((long long int)cindex[i + 1] << 16) / cindex[0]) : 0;
+  tsmat[2] += 0x8000;                   /* rounding */
+  tsmat[5] += 0x8000;
+}
+
 //-----------------------------------------------------------------------------
 void BSP_TS_CalibCalc(ts_three_points * tp, ts_three_points * dp, ts_cindex * ci)
 {
@@ -81,6 +129,64 @@ void BSP_TS_CalibCalc(ts_three_points * tp, ts_three_points * dp, ts_cindex * ci
   (*ci)[4] = (int32_t)i4;
   (*ci)[5] = (int32_t)i5;
   (*ci)[6] = (int32_t)i6;
+  if(ci == &cindex)
+    TsMatrixCalc();
+}
+
+//-----------------------------------------------------------------------------
+void BSP_TS_CalibCalcN(ts_point * tp, ts_point * dp, uint32_t n, ts_cindex * ci)
+{
+  double sxx = 0, sxy = 0, syy = 0, sx = 0, sy = 0, det, mx, my, tx, ty;
+  double xx = 0, xy = 0, yx = 0, yy = 0, a, b, c, d;
+  uint32_t i;
+
+  if(ci == NULL)
+    ci = &cindex;
+  if(n < 3)
+    return;
+
+  /* centered touch coordinates (better numerical condition) */
+  for(i = 0; i < n; i++)
+  {
+    sx += tp[i].x;
+    sy += tp[i].y;
+  }
+  mx = sx / n;
+  my = sy / n;
+  sx = sy = 0;
+  for(i = 0; i < n; i++)
+  {
+    tx = tp[i].x - mx;
+    ty = tp[i].y - my;
+    sxx += tx * tx;
+    sxy += tx * ty;
+    syy += ty * ty;
+    xx += tx * dp[i].x;                 /* touch x * display x */
+    yx += ty * dp[i].x;
+    xy += tx * dp[i].y;
+    yy += ty * dp[i].y;
+    sx += dp[i].x;                      /* display x, y sums */
+    sy += dp[i].y;
+  }
+
+  /* normal equations (the offset is separated by the centering) */
+  det = sxx * syy - sxy * sxy;
+  if(det == 0)
+    return;
+  a = (xx * syy - yx * sxy) / det;
+  b = (yx * sxx - xx * sxy) / det;
+  c = (xy * syy - yy * sxy) / det;
+  d = (yy * sxx - xy * sxy) / det;
+
+  (*ci)[0] = 65536;
+  (*ci)[1] = Q16(a);
+  (*ci)[2] = Q16(b);
+  (*ci)[3] = Q16(sx / n - a * mx - b * my);
+  (*ci)[4] = Q16(c);
+  (*ci)[5] = Q16(d);
+  (*ci)[6] = Q16(sy / n - c * mx - d * my);
+  if(ci == &cindex)
+    TsMatrixCalc();
 }
 
 //-----------------------------------------------------------------------------
@@ -96,8 +202,8 @@ void BSP_TS_CalibCalc(ts_three_points * tp, ts_three_points * dp, ts_cindex * ci
 void BSP_TS_DisplaycoordCalc(uint16_t tx, uint16_t ty, uint16_t * dx, uint16_t * dy, uint16_t mx, uint16_t my)
 {
   int32_t x, y;
-  x = (cindex[1] * tx + cindex[2] * ty + cindex[3]) / cindex[0];
-  y = (cindex[4] * tx + cindex[5] * ty + cindex[6]) / cindex[0];
+  x = (tsmat[0] * tx + tsmat[1] * ty + tsmat[2]) >> 16;
+  y = (tsmat[3] * tx + tsmat[4] * ty + tsmat[5]) >> 16;
 
   if(x < 0)
     x = 0;
@@ -121,6 +227,7 @@ void BSP_TS_SetCindex(ts_cindex * ci)
 {
   for(uint32_t i = 0; i < 7; i++)
     cindex[i] = (*ci)[i];
+  TsMatrixCalc();
 }
 
 //-----------------------------------------------------------------------------
@@ -133,6 +240,128 @@ void BSP_TS_GetCindex(ts_cindex * ci)
     (*ci)[i] = cindex[i];
 }
 
+#if TS_EVENT_QUEUE > 0
+//-----------------------------------------------------------------------------
+/* Put an event into the queue */
+static void TsEventPut(uint8_t Type, uint32_t Time)
+{
+  TS_EventTypeDef ev;
+  uint32_t h = ts_evhead;
+  uint32_t free = (ts_evtail + TS_EVENT_QUEUE - h - 1) % TS_EVENT_QUEUE;
+  uint32_t need = 1;
+  if(Type != TS_EVENT_RELEASE)
+    need += TS_EVENT_RESERVE;
+  if((Type == TS_EVENT_MOVE) || (Type == TS_EVENT_DRAG))
+    need++;
+  if((tse.flags & TS_EVF_NOPRESS) || (free < need))
+  {
+    if(Type == TS_EVENT_PRESS)
+      tse.flags |= TS_EVF_NOPRESS;      /* the release of this press is also dropped */
+    ts_evlost++;
+    return;
+  }
+  ev.Type = Type;
+  ev.X = tse.x;
+  ev.Y = tse.y;
+  ev.Vx = tse.vx;
+  ev.Vy = tse.vy;
+  ev.Time = Time;
+  ts_events[h] = ev;
+  ts_evhead = (h + 1) % TS_EVENT_QUEUE;
+}
+
+//-----------------------------------------------------------------------------
+/* Periodic touch sampling, it makes the events */
+void BSP_TS_Sample(void)
+{
+  TS_StateTypeDef ts;
+  uint32_t t = TS_EVENT_GETTIME();
+  int32_t  dt;
+
+  BSP_TS_GetState(&ts);
+  dt = t - tse.t;
+  if(dt < 1)
+    dt = 1;
+  tse.t = t;
+
+  if((ts.TouchDetected != 0) != tse.touch)
+  { /* touch state change (after TS_EVENT_DEBOUNCE same samples) */
+    if(++tse.cnt < TS_EVENT_DEBOUNCE)
+      return;
+    tse.cnt = 0;
+    if(!tse.touch)
+    { /* press */
+      tse.touch = 1;
+      tse.flags = 0;
+      tse.x = tse.px = ts.X;
+      tse.y = tse.py = ts.Y;
+      tse.vx = tse.vy = 0;
+      tse.pt = t;
+      TsEventPut(TS_EVENT_PRESS, t);
+    }
+    else
+    { /* release (the last touched position) */
+      tse.touch = 0;
+      if(tse.vx * tse.vx + tse.vy * tse.vy >= TS_EVENT_FLICKSPEED * TS_EVENT_FLICKSPEED)
+        TsEventPut(TS_EVENT_FLICK, t);
+      TsEventPut(TS_EVENT_RELEASE, t);
+    }
+    return;
+  }
+  tse.cnt = 0;
+
+  if(!tse.touch)
+    return;
+
+  if((ts.X != tse.x) || (ts.Y != tse.y))
+  { /* move: the velocity is averaged with the previous value */
+    tse.vx = LIMIT16((tse.vx + ((int32_t)ts.X - tse.x) * TS_EVENT_TIMEFREQ / dt) / 2);
+    tse.vy = LIMIT16((tse.vy + ((int32_t)ts.Y - tse.y) * TS_EVENT_TIMEFREQ / dt) / 2);
+    tse.x = ts.X;
+    tse.y = ts.Y;
+    if(!(tse.flags & TS_EVF_DRAG) &&
+       ((ABS((int32_t)tse.x - tse.px) > TS_EVENT_DRAGDIST) || (ABS((int32_t)tse.y - tse.py) > TS_EVENT_DRAGDIST)))
+    {
+      tse.flags |= TS_EVF_DRAG;
+      TsEventPut(TS_EVENT_DRAG, t);
+    }
+    TsEventPut(TS_EVENT_MOVE, t);
+  }
+  else
+  { /* stopped: the velocity decreases */
+    tse.vx /= 2;
+    tse.vy /= 2;
+  }
+
+  if(!(tse.flags & (TS_EVF_LONGPRESS | TS_EVF_DRAG)) &&
+     (t - tse.pt >= (uint32_t)TS_EVENT_LONGTIME * TS_EVENT_TIMEFREQ / 1000))
+  {
+    tse.flags |= TS_EVF_LONGPRESS;
+    TsEventPut(TS_EVENT_LONGPRESS, t);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/* Get the oldest event
+   return: 1 = Event is valid, 0 = the queue is empty */
+uint8_t BSP_TS_GetEvent(TS_EventTypeDef *Event)
+{
+  uint32_t t = ts_evtail;
+  if(t == ts_evhead)
+    return 0;
+  *Event = ts_events[t];
+  ts_evtail = (t + 1) % TS_EVENT_QUEUE;
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Number of the dropped events */
+uint32_t BSP_TS_GetEventLost(void)
+{
+  return ts_evlost;
+}
+#endif /* #if TS_EVENT_QUEUE > 0 */
+
 //-----------------------------------------------------------------------------
 /**
   * @brief  Initializes and configures the touch screen functionalities and 
@@ -148,6 +377,7 @@ uint8_t BSP_TS_Init(uint16_t XSize, uint16_t YSize)
   /* Initialize x and y positions boundaries */
   TsXBoundary = XSize;
   TsYBoundary = YSize;
+  TsMatrixCalc();
 
   if(ts_drv)
     ret = TS_OK;
@@ -12,6 +12,25 @@
 /* These values can be created using appTouchCalib */
 #define  TS_CINDEX            {-1350650, -134489, 521, 71073115, 348, -104248, 44767250}
 
+/* Touch event queue length (see BSP_TS_Sample, BSP_TS_GetEvent, 0: no event queue) */
+#define  TS_EVENT_QUEUE       0
+
+/* Time source of the event timestamps */
+#define  TS_EVENT_GETTIME()   HAL_GetTick()
+#define  TS_EVENT_TIMEFREQ    1000
+
+/* Debounce: number of the same samples before the press and the release */
+#define  TS_EVENT_DEBOUNCE    2
+
+/* Long press time [ms] (if not dragged) */
+#define  TS_EVENT_LONGTIME    800
+
+/* Drag start distance from the press position [pixel] */
+#define  TS_EVENT_DRAGDIST    10
+
+/* Flick minimum speed at the release [pixel / s] */
+#define  TS_EVENT_FLICKSPEED  500
+
 //=============================================================================
 /* Interface section */
 
@@ -22,6 +41,11 @@ typedef struct
   int32_t x0, y0, x1, y1, x2, y2;
 }ts_three_points;
 
+typedef struct
+{
+  int32_t x, y;
+}ts_point;
+
 typedef struct
 {
   uint16_t TouchDetected;
@@ -30,6 +54,28 @@ typedef struct
   uint16_t Z;
 }TS_StateTypeDef;
 
+/* Touch events */
+enum
+{
+  TS_EVENT_NONE = 0,
+  TS_EVENT_PRESS,                       /* touched (position: X, Y) */
+  TS_EVENT_MOVE,                        /* the touched position is changed (X, Y, velocity: Vx, Vy) */
+  TS_EVENT_RELEASE,                     /* released (X, Y: the last touched position) */
+  TS_EVENT_LONGPRESS,                   /* touched for TS_EVENT_LONGTIME without drag */
+  TS_EVENT_DRAG,                        /* the position moved more than TS_EVENT_DRAGDIST from the press position */
+  TS_EVENT_FLICK                        /* released with TS_EVENT_FLICKSPEED or more speed (Vx, Vy), before the release */
+};
+
+typedef struct
+{
+  uint8_t  Type;                        /* TS_EVENT_... */
+  uint16_t X;                           /* display position */
+  uint16_t Y;
+  int16_t  Vx;                          /* velocity [pixel / s] */
+  int16_t  Vy;
+  uint32_t Time;                        /* timestamp (TS_EVENT_GETTIME) */
+}TS_EventTypeDef;
+
 typedef enum 
 {
   TS_OK       = 0x00,
@@ -48,12 +94,32 @@ void    BSP_TS_GetState(TS_StateTypeDef *TsState);
    return; cindex values */
 void BSP_TS_CalibCalc(ts_three_points * tp, ts_three_points * dp, ts_cindex * ci);
 
-/* Set the current cindex */
+/* Touchscreen calibration from n (>= 3) points with least squares fit (the touch errors are averaged)
+   param:
+   - tp : source pointer to n touchscreen coordinates
+   - dp : source pointer to n display coordinates
+   - n  : number of points
+   - ci : result pointer to cindex array (if NULL -> puts it in the current cindex)
+   return; cindex values in Q16 form (cindex[0] = 65536), it can be used as the three point cindex */
+void BSP_TS_CalibCalcN(ts_point * tp, ts_point * dp, uint32_t n, ts_cindex * ci);
+
+/* Set the current cindex (the display coordinate calculation uses a Q16 matrix calculated from it, so the
+   BSP_TS_GetState does not need division) */
 void BSP_TS_SetCindex(ts_cindex * ci);
 
 /* Get for current cindex */
 void BSP_TS_GetCindex(ts_cindex * ci);
 
+/* Touch event queue (TS_EVENT_QUEUE > 0)
+   - BSP_TS_Sample: periodic sampling (e.g. 10ms timer interrupt), it makes the events from the BSP_TS_GetState
+     note: from interrupt only if the touch driver is not blocking (e.g. XPT2046_BACKGROUND = 1)
+   - BSP_TS_GetEvent: get the oldest event (return: 1 = Event is valid, 0 = the queue is empty)
+     the events are not lost during a long drawing, they can be processed after it
+   - BSP_TS_GetEventLost: number of the dropped events (queue full, the move events are dropped first) */
+void     BSP_TS_Sample(void);
+uint8_t  BSP_TS_GetEvent(TS_EventTypeDef *Event);
+uint32_t BSP_TS_GetEventLost(void);
+
 #ifdef __cplusplus
 }
 #endif
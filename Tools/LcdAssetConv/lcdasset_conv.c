@@ -0,0 +1,254 @@
+/*
+ * Image asset converter (host side tool)
+ * author: Roberto Benjami
+ * v.2026.10
+ *
+ * Converts an image file into a C source file with an uint16_t pixel array in the
+ * LCD_PIXFMT format of the lcd.h, so the image can be drawn with the BSP_LCD_DrawRGB16Image
+ * without conversion (the DMA sends the array directly).
+ *
+ * Build (Linux, Windows mingw):
+ *   gcc -O2 -o lcdasset_conv lcdasset_conv.c
+ *
+ * Use:
+ *   lcdasset_conv [options] image.ppm|image.bmp output.c
+ *   options:
+ *     -f format : rgb565|rgb565be|bgr565|bgr565be|all (default: all)
+ *                 all: every format is in the output file, the LCD_PIXFMT setting selects one of them at compile time
+ *     -n name   : array name (default: from the file name)
+ *   input: binary ppm (P6, maxval 255), uncompressed 24 or 32 bit bmp
+ *
+ * Output (e.g. -n logo):
+ *   const uint16_t logo_width = ..., logo_height = ...;
+ *   const uint16_t logo[] = {...};   (right then down)
+ *   use: extern const uint16_t logo[]; BSP_LCD_DrawRGB16Image(x, y, 64, 32, (uint16_t *)logo);
+ *
+ * Note: the RGB888 colors are truncated to RGB565 (as the LCD_COLOR macro)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/* Pixel formats (as LCD_PIXFMT in the lcd.h) */
+#define  PIXFMT_NUM           4
+#define  PIXFMT_ALL           PIXFMT_NUM
+
+static const char *fmtname[PIXFMT_NUM] = {"rgb565", "rgb565be", "bgr565", "bgr565be"};
+static const char *fmtmacro[PIXFMT_NUM] = {"LCD_PIXFMT_RGB565", "LCD_PIXFMT_RGB565_BE", "LCD_PIXFMT_BGR565", "LCD_PIXFMT_BGR565_BE"};
+
+static uint32_t width, height;
+static uint8_t  *rgb = NULL;          /* RGB888 pixels, right then down */
+
+//-----------------------------------------------------------------------------
+static uint32_t Get16(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static uint32_t Get32(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+//-----------------------------------------------------------------------------
+/* Next number from the ppm header (skip the white spaces and comments) */
+static int PpmNum(FILE *f, uint32_t *n)
+{
+  int c;
+  do
+  {
+    c = fgetc(f);
+    if(c == '#')
+      while(c != '\n' && c != EOF)
+        c = fgetc(f);
+  }while(isspace(c));
+  if(!isdigit(c))
+    return 0;
+  *n = 0;
+  while(isdigit(c))
+  {
+    *n = *n * 10 + c - '0';
+    c = fgetc(f);
+  }
+  return 1;                             /* one white space after the number is consumed */
+}
+
+//-----------------------------------------------------------------------------
+static int LoadPpm(FILE *f)
+{
+  uint32_t maxval;
+  if(fgetc(f) != 'P' || fgetc(f) != '6')
+    return 0;
+  if(!PpmNum(f, &width) || !PpmNum(f, &height) || !PpmNum(f, &maxval) || maxval != 255 || !width || !height)
+    return 0;
+  rgb = malloc(width * height * 3);
+  return rgb && fread(rgb, 3, width * height, f) == width * height;
+}
+
+//-----------------------------------------------------------------------------
+static int LoadBmp(FILE *f)
+{
+  uint8_t  h[54], *line;
+  uint32_t offset, bpp, linesize, y, x, row;
+  int32_t  h32;
+  if(fread(h, 1, 54, f) != 54 || h[0] != 'B' || h[1] != 'M')
+    return 0;
+  offset = Get32(&h[10]);
+  width = Get32(&h[18]);
+  h32 = (int32_t)Get32(&h[22]);
+  bpp = Get16(&h[28]);
+  if((bpp != 24 && bpp != 32) || (Get32(&h[30]) != 0 && Get32(&h[30]) != 3) || !width || !h32)
+    return 0;                           /* only uncompressed (or 32 bit bitfields) 24 and 32 bit bmp */
+  height = h32 < 0 ? -h32 : h32;
+  linesize = (width * (bpp / 8) + 3) & ~3;
+  line = malloc(linesize);
+  rgb = malloc(width * height * 3);
+  if(!line || !rgb || fseek(f, offset, SEEK_SET))
+    return 0;
+  for(y = 0; y < height; y++)
+  {
+    if(fread(line, 1, linesize, f) != linesize)
+      return 0;
+    row = h32 < 0 ? y : height - 1 - y; /* the bmp is stored bottom-up (positive height) */
+    for(x = 0; x < width; x++)
+    { /* BGR(A) -> RGB */
+      rgb[(row * width + x) * 3]     = line[x * (bpp / 8) + 2];
+      rgb[(row * width + x) * 3 + 1] = line[x * (bpp / 8) + 1];
+      rgb[(row * width + x) * 3 + 2] = line[x * (bpp / 8)];
+    }
+  }
+  free(line);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* RGB888 pixel -> pixel format */
+static uint16_t Pixel(uint32_t i, int fmt)
+{
+  uint8_t  r = rgb[i * 3], g = rgb[i * 3 + 1], b = rgb[i * 3 + 2];
+  uint16_t c;
+  if(fmt & 2)
+    c = (b & 0xF8) << 8 | (g & 0xFC) << 3 | (r & 0xF8) >> 3;
+  else
+    c = (r & 0xF8) << 8 | (g & 0xFC) << 3 | (b & 0xF8) >> 3;
+  if(fmt & 1)
+    c = (c << 8) | (c >> 8);
+  return c;
+}
+
+//-----------------------------------------------------------------------------
+static void WriteArray(FILE *f, const char *name, int fmt)
+{
+  uint32_t i, n = width * height;
+  fprintf(f, "const uint16_t %s[%u] =\n{", name, n);
+  for(i = 0; i < n; i++)
+    fprintf(f, "%s0x%04X%s", (i % 16) ? " " : "\n  ", Pixel(i, fmt), (i + 1 < n) ? "," : "");
+  fprintf(f, "\n};\n");
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  const char *in = NULL, *out = NULL, *name = NULL, *p;
+  char     autoname[64];
+  int      fmt = PIXFMT_ALL, i, ok;
+  uint32_t k;
+  FILE     *f;
+
+  for(i = 1; i < argc; i++)
+  {
+    if(!strcmp(argv[i], "-f") && i + 1 < argc)
+    {
+      i++;
+      for(fmt = 0; fmt < PIXFMT_NUM && strcmp(fmtname[fmt], argv[i]); fmt++);
+      if(fmt == PIXFMT_NUM && strcmp(argv[i], "all"))
+      {
+        fprintf(stderr, "unknown format: %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else if(!strcmp(argv[i], "-n") && i + 1 < argc)
+      name = argv[++i];
+    else if(!in)
+      in = argv[i];
+    else
+      out = argv[i];
+  }
+
+  if(!in || !out)
+  {
+    fprintf(stderr, "use: lcdasset_conv [-f rgb565|rgb565be|bgr565|bgr565be|all] [-n name] image.ppm|image.bmp output.c\n");
+    return 1;
+  }
+
+  f = fopen(in, "rb");
+  if(!f)
+  {
+    fprintf(stderr, "%s: can not open\n", in);
+    return 1;
+  }
+  ok = LoadPpm(f);
+  if(!ok)
+  {
+    free(rgb);
+    rgb = NULL;
+    rewind(f);
+    ok = LoadBmp(f);
+  }
+  fclose(f);
+  if(!ok)
+  {
+    fprintf(stderr, "%s: not a P6 ppm or 24/32 bit uncompressed bmp file\n", in);
+    return 1;
+  }
+
+  if(!name)
+  { /* array name from the file name (without path and extension) */
+    p = strrchr(in, '/');
+    if(!p)
+      p = strrchr(in, '\\');
+    p = p ? p + 1 : in;
+    for(k = 0; p[k] && p[k] != '.' && k < sizeof(autoname) - 1; k++)
+      autoname[k] = isalnum((uint8_t)p[k]) ? p[k] : '_';
+    autoname[k] = 0;
+    if(!k || isdigit((uint8_t)autoname[0]))
+    {
+      memmove(&autoname[1], autoname, sizeof(autoname) - 1);
+      autoname[0] = '_';
+      autoname[sizeof(autoname) - 1] = 0;
+    }
+    name = autoname;
+  }
+
+  f = fopen(out, "w");
+  if(!f)
+  {
+    fprintf(stderr, "%s: can not create\n", out);
+    return 1;
+  }
+  fprintf(f, "/* %s: %ux%u pixel image, converted with lcdasset_conv (format: %s) */\n\n",
+          in, width, height, fmt == PIXFMT_ALL ? "all" : fmtname[fmt]);
+  fprintf(f, "#include <stdint.h>\n#include \"lcd.h\"\n\n");
+  fprintf(f, "const uint16_t %s_width = %u, %s_height = %u;\n\n", name, width, name, height);
+  if(fmt == PIXFMT_ALL)
+  { /* all formats, the LCD_PIXFMT selects */
+    for(i = 0; i < PIXFMT_NUM; i++)
+    {
+      fprintf(f, "%s LCD_PIXFMT == %s\n", i ? "#elif" : "#if", fmtmacro[i]);
+      WriteArray(f, name, i);
+    }
+    fprintf(f, "#endif\n");
+  }
+  else
+  {
+    fprintf(f, "#if LCD_PIXFMT != %s\n#error \"%s: the image format is %s, it is not the LCD_PIXFMT format (lcd.h)\"\n#endif\n\n",
+            fmtmacro[fmt], name, fmtmacro[fmt]);
+    WriteArray(f, name, fmt);
+  }
+  fclose(f);
+  free(rgb);
+  return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * LCD_IO trace replayer (host side tool)
+ * author: Roberto Benjami
+ * v.2026.10
+ *
+ * Replays the trace file of the Drivers/lcd_io_trace.c with the display controller
+ * emulator (Drivers/io_host/lcd_io_host.c), reconstructs the display content and
+ * prints the per-command statistics (count, bus bytes, time, bandwidth).
+ *
+ * Build (Linux, Windows mingw):
+ *   gcc -O2 -I../../Drivers -I../../Drivers/io_host -o lcdtrace_replay lcdtrace_replay.c ../../Drivers/io_host/lcd_io_host.c
+ *
+ * Use:
+ *   lcdtrace_replay [options] trace.bin
+ *   options:
+ *     -c ili9341|st7789|st7735|ili9325 : controller model (default: ili9341)
+ *     -w width -h height : GRAM size (default: controller dependent)
+ *     -m mirror          : panel mirror (see LCD_HOST_MIRROR, default: controller dependent)
+ *     -o prefix          : write the reconstructed frame(s) to prefix_nnnn.ppm files
+ *     -f ms              : frame snapshot interval in trace time [ms] (default: 0 = only the last frame)
+ *
+ * Note: the record payload is limited (see LCD_IO_TRACE_PAYLOAD), the pixels of the
+ *       larger bitmaps that are not in the payload are drawn with a color generated from the data hash.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "main.h"
+#include "lcd_io.h"
+#include "lcd_io_host.h"
+
+//-----------------------------------------------------------------------------
+#define  TRACE_HEADSIZE       16
+#define  TRACE_RECSIZE        20
+
+typedef struct
+{
+  uint32_t time;
+  uint32_t size;
+  uint32_t hash;
+  uint16_t cmd;
+  uint16_t mode;
+  uint16_t dummysize;
+  uint16_t paylen;
+  uint8_t  payload[65536];
+}trec_t;
+
+/* Controller models */
+typedef struct
+{
+  const char *name;
+  uint32_t controller;
+  uint16_t width, height;
+  uint32_t id;
+  uint8_t  mirror;
+}ctrl_t;
+
+static const ctrl_t ctrls[] =
+{
+  {"ili9341", 0, 240, 320, 0x9341, 0x40},
+  {"st7789",  0, 240, 320, 0x8552, 0xC0},
+  {"st7735",  0, 128, 160, 0x7C89F0, 0x00},
+  {"ili9325", 1, 240, 320, 0x9325, 0xC0},
+  {NULL}
+};
+
+static uint64_t cmdtime[0x10000];
+static uint8_t  *databuf = NULL;
+static uint32_t databufsize = 0;
+
+//-----------------------------------------------------------------------------
+static const char *CmdName(uint32_t controller, uint16_t cmd)
+{
+  if(controller)
+    return (cmd == 0x22) ? "RW_GRAM" : (cmd == 0x20 || cmd == 0x21) ? "GRAM_AD" : "";
+  switch(cmd)
+  {
+    case 0x01: return "SWRESET";
+    case 0x04: return "RDDID";
+    case 0x11: return "SLPOUT";
+    case 0x28: return "DISPOFF";
+    case 0x29: return "DISPON";
+    case 0x2A: return "CASET";
+    case 0x2B: return "PASET";
+    case 0x2C: return "RAMWR";
+    case 0x2E: return "RAMRD";
+    case 0x33: return "VSCRDEF";
+    case 0x34: return "TEOFF";
+    case 0x35: return "TEON";
+    case 0x36: return "MADCTL";
+    case 0x37: return "VSCRSADD";
+    case 0x3A: return "COLMOD";
+    case 0x3C: return "RAMWRC";
+    case 0x3E: return "RAMRDC";
+    case 0x44: return "STE";
+    case 0xD3: return "RDID4";
+    default:   return "";
+  }
+}
+
+//-----------------------------------------------------------------------------
+static int ReadRec(FILE *f, trec_t *r)
+{
+  uint8_t h[TRACE_RECSIZE];
+  if(fread(h, 1, TRACE_RECSIZE, f) != TRACE_RECSIZE)
+    return 0;
+  r->time      = h[0] | (h[1] << 8) | (h[2] << 16) | ((uint32_t)h[3] << 24);
+  r->size      = h[4] | (h[5] << 8) | (h[6] << 16) | ((uint32_t)h[7] << 24);
+  r->hash      = h[8] | (h[9] << 8) | (h[10] << 16) | ((uint32_t)h[11] << 24);
+  r->cmd       = h[12] | (h[13] << 8);
+  r->mode      = h[14] | (h[15] << 8);
+  r->dummysize = h[16] | (h[17] << 8);
+  r->paylen    = h[18] | (h[19] << 8);
+  if(r->paylen && fread(r->payload, 1, r->paylen, f) != r->paylen)
+    return 0;
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Rebuild the transaction data and execute it on the emulator */
+static void Replay(trec_t *r)
+{
+  uint32_t n, i;
+  uint16_t c;
+
+  if(r->mode & LCD_IO_FILL)
+    n = 4;
+  else
+    n = (r->size + 1) * 3;              /* enough for all data types */
+  if(n > databufsize)
+  {
+    databufsize = n;
+    databuf = realloc(databuf, databufsize);
+  }
+
+  if(r->mode & LCD_IO_WRITE)
+  {
+    memcpy(databuf, r->payload, r->paylen);
+    c = (r->hash ^ (r->hash >> 16)) & 0xFFFF; /* data not in payload */
+    for(i = r->paylen; i < n; i++)
+      databuf[i] = (i & 1) ? c >> 8 : c;
+  }
+  LCD_IO_Transaction(r->cmd, databuf, r->size, r->dummysize, r->mode);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  const char *prefix = NULL, *fn = NULL;
+  const ctrl_t *ctrl = &ctrls[0];
+  int mirror = -1, i, frame = 0;
+  uint32_t width = 0, height = 0, fint = 0, freq, lost, nrec = 0, tprev = 0;
+  uint64_t tlast = 0, tnext = 0, ttotal, b;
+  uint16_t pcmd = 0;
+  uint8_t  head[TRACE_HEADSIZE];
+  char     ppmname[256];
+  static trec_t r;
+  LCD_IO_HostStatTypeDef st;
+  FILE *f;
+
+  for(i = 1; i < argc; i++)
+  {
+    if(!strcmp(argv[i], "-c") && i + 1 < argc)
+    {
+      i++;
+      for(ctrl = &ctrls[0]; ctrl->name && strcmp(ctrl->name, argv[i]); ctrl++);
+      if(!ctrl->name)
+      {
+        fprintf(stderr, "unknown controller: %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else if(!strcmp(argv[i], "-w") && i + 1 < argc)
+      width = strtoul(argv[++i], NULL, 0);
+    else if(!strcmp(argv[i], "-h") && i + 1 < argc)
+      height = strtoul(argv[++i], NULL, 0);
+    else if(!strcmp(argv[i], "-m") && i + 1 < argc)
+      mirror = strtol(argv[++i], NULL, 0);
+    else if(!strcmp(argv[i], "-o") && i + 1 < argc)
+      prefix = argv[++i];
+    else if(!strcmp(argv[i], "-f") && i + 1 < argc)
+      fint = strtoul(argv[++i], NULL, 0);
+    else
+      fn = argv[i];
+  }
+
+  if(!fn)
+  {
+    fprintf(stderr, "use: lcdtrace_replay [-c ili9341|st7789|st7735|ili9325] [-w width] [-h height] [-m mirror] [-o prefix] [-f ms] trace.bin\n");
+    return 1;
+  }
+
+  f = fopen(fn, "rb");
+  if(!f || fread(head, 1, TRACE_HEADSIZE, f) != TRACE_HEADSIZE || memcmp(head, "LCDTRACE", 8))
+  {
+    fprintf(stderr, "%s: not a LCD trace file\n", fn);
+    return 1;
+  }
+  freq = head[8] | (head[9] << 8) | (head[10] << 16) | ((uint32_t)head[11] << 24);
+  lost = head[12] | (head[13] << 8) | (head[14] << 16) | ((uint32_t)head[15] << 24);
+  if(!freq)
+    freq = 1000;
+
+  LCD_IO_HostConfig(ctrl->controller, width ? width : ctrl->width, height ? height : ctrl->height,
+                    ctrl->id, mirror >= 0 ? mirror : ctrl->mirror);
+  LCD_IO_HostStatReset();
+
+  while(ReadRec(f, &r))
+  {
+    /* 64 bit time from the 32 bit wrapping timestamps */
+    if(nrec)
+    {
+      tlast += (uint32_t)(r.time - tprev);
+      cmdtime[pcmd] += (uint32_t)(r.time - tprev); /* the interval belongs to the previous transaction */
+    }
+    tprev = r.time;
+    pcmd = r.cmd;
+    nrec++;
+
+    if(prefix && fint && tlast >= tnext)
+    {
+      if(nrec > 1)
+      {
+        snprintf(ppmname, sizeof(ppmname), "%s_%04d.ppm", prefix, frame++);
+        LCD_IO_HostDumpPpm(ppmname);
+      }
+      tnext = tlast + (uint64_t)fint * freq / 1000;
+    }
+
+    Replay(&r);
+  }
+  fclose(f);
+
+  if(prefix)
+  {
+    snprintf(ppmname, sizeof(ppmname), "%s_%04d.ppm", prefix, frame);
+    LCD_IO_HostDumpPpm(ppmname);
+  }
+
+  LCD_IO_HostStatGet(&st);
+  ttotal = tlast ? tlast : 1;
+  printf("records: %u, lost: %u, trace time: %.3f ms, bus bytes: %llu, average: %.1f kB/s\n",
+         nrec, lost, (double)tlast * 1000 / freq, (unsigned long long)st.bytes, (double)st.bytes * freq / ttotal / 1000);
+  printf("%-6s %-9s %10s %12s %12s %7s %12s\n", "cmd", "name", "count", "bytes", "time[us]", "time%", "kB/s");
+  for(i = 0; i < 0x10000; i++)
+  {
+    if(!LCD_IO_HostCmdCount(i))
+      continue;
+    b = LCD_IO_HostCmdBytes(i);
+    printf("0x%04X %-9s %10u %12llu %12.1f %7.2f %12.1f\n", i, CmdName(ctrl->controller, i), LCD_IO_HostCmdCount(i),
+           (unsigned long long)b, (double)cmdtime[i] * 1000000 / freq, (double)cmdtime[i] * 100 / ttotal,
+           cmdtime[i] ? (double)b * freq / cmdtime[i] / 1000 : 0.0);
+  }
+
+  free(databuf);
+  return 0;
+}